@@ -33,9 +33,29 @@ namespace Methods
 	};
 }
 
-typedef QPair<unsigned int, unsigned int> Coord;
-typedef QList<Coord> PixCoords;
-typedef QMap<unsigned int, PixCoords> LookUpSKO;
+// Way to find Source pixel, most similar to Target pixel
+namespace Matcher
+{
+	enum Type
+	{
+		RANDOM = 0,
+		INDEXED,
+		SORTED_WINDOW,
+		DEFAULT_LAST
+	};
+}
+
+// Way to compare features of pixels in Walsh Simple Entropy method
+namespace EntropyMatching
+{
+	enum Type
+	{
+		SUM = 0,
+		CORRELATION,
+		NEAREST,
+		DEFAULT_LAST
+	};
+}
 
 #define DEFAULT_DIFF 999999.0
 #define DEFAULT_LUM 999999.0
@@ -47,8 +67,24 @@ typedef QMap<unsigned int, PixCoords> LookUpSKO;
 
 #define MIN_SUMM 0.0
 
+// Number of pixels characteristics, used by entropy colorization (lum, SKO, entropy, skewness, kurtosis)
+#define ENTROPY_PARAMS_NUM 5
+// Default weight of each characteristic in distance between pixels (EntropyMatching::NEAREST)
+#define ENTROPY_PARAM_WEIGHT 1.0
+
 #define MAX_COORDS_PER_CELL 25
+// Search in look up table: cells are checked ring by ring around cell of pixel, until this number of candidates
+// found or max radius of ring (in cells) reached
+#define LOOKUP_SEARCH_MIN_CANDIDATES 25
+#define LOOKUP_SEARCH_MAX_RADIUS 10
 
 #define NUM_OF_ATTEMPTS 200
 
+// Search in index of features of Source pixels: number of nearest pixels, from which most similar is chosen
+// (with LUM_TRESHOLD and SKO_TRESHOLD), and default max number of checked pixels (0 - exact search)
+#define INDEX_SIMILAR_NEIGHBORS 8
+#define INDEX_SEARCH_MAX_CHECKS 0
+// Default number of Source pixels (with nearest luminance), checked by Matcher::SORTED_WINDOW
+#define MATCHER_WINDOW_WIDTH 64
+
 #endif // COLORIZATION_H
@@ -24,4 +24,45 @@
 
 #define MAX_PERCENT 100
 
+// Command line option: use fast approximations of math functions (see FastMath)
+#define ARG_FAST_MATH "--fast-math"
+// Command line option: print errors of fast math and of all ways of color conversion, then exit
+#define ARG_TEST_FAST_MATH "--test-fast-math"
+// Command line option: compare features of pixels with reference calculation for each pixel, then exit
+#define ARG_TEST_FEATURES "--test-features"
+// Command line option: compare search in indexes of pixels with linear scan of all pixels, then exit
+#define ARG_TEST_INDEXES "--test-indexes"
+// Command line option: way to transform colors from RGB to LAB ("--color-conversion formula",
+// "--color-conversion table" or "--color-conversion vectorized")
+#define ARG_COLOR_CONVERSION "--color-conversion"
+#define ARG_COLOR_CONVERSION_FORMULA "formula"
+#define ARG_COLOR_CONVERSION_TABLE "table"
+#define ARG_COLOR_CONVERSION_VECTORIZED "vectorized"
+// Command line option: number of threads for calculation of features of pixels ("--threads N")
+#define ARG_THREADS "--threads"
+// Command line options: odd sides of masks of features of pixels ("--sko-mask N")
+#define ARG_SKO_MASK "--sko-mask"
+#define ARG_ENTROPY_MASK "--entropy-mask"
+#define ARG_MOMENTS_MASK "--moments-mask"
+// Command line option: way to find similar Source pixels ("--matcher random", "--matcher indexed" or
+// "--matcher window")
+#define ARG_MATCHER "--matcher"
+#define ARG_MATCHER_RANDOM "random"
+#define ARG_MATCHER_INDEXED "indexed"
+#define ARG_MATCHER_WINDOW "window"
+// Command line option: number of Source pixels checked by "--matcher window" ("--matcher-window N")
+#define ARG_MATCHER_WINDOW_WIDTH "--matcher-window"
+// Command line option: max number of Source pixels checked by "--matcher indexed" ("--matcher-max-checks N", 0 -
+// exact search)
+#define ARG_MATCHER_MAX_CHECKS "--matcher-max-checks"
+// Command line option: way to compare pixels in Walsh Simple Entropy method ("--entropy-matching sum",
+// "--entropy-matching correlation" or "--entropy-matching nearest")
+#define ARG_ENTROPY_MATCHING "--entropy-matching"
+#define ARG_ENTROPY_MATCHING_SUM "sum"
+#define ARG_ENTROPY_MATCHING_CORRELATION "correlation"
+#define ARG_ENTROPY_MATCHING_NEAREST "nearest"
+// Command line option: weights of luminance, SKO, entropy, skewness and kurtosis for "--entropy-matching nearest"
+// ("--entropy-weights 1,1,0.5,0.5,0.5")
+#define ARG_ENTROPY_WEIGHTS "--entropy-weights"
+
 #endif // GLOBAL_H
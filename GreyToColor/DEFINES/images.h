@@ -24,6 +24,17 @@
 #define PASSPORT_LENGTH 256
 #define SAMPLES_ON_FACET 16
 
+// File of Source model (prepared pixels and features of Source image, see SourceModelFile)
+#define SOURCE_MODEL_SUFFIX "g2cm"
+#define SOURCE_MODEL_MAGIC "G2CMODEL"
+#define SOURCE_MODEL_MAGIC_SIZE 8
+#define SOURCE_MODEL_VERSION 2
+// Written as number to check byte order of file
+#define SOURCE_MODEL_BYTE_ORDER 0x01020304
+// Parameters of FNV-1a checksum of sections of file (it's calculated for 64-bit words)
+#define SOURCE_MODEL_CHECKSUM_BASIS Q_UINT64_C(14695981039346656037)
+#define SOURCE_MODEL_CHECKSUM_PRIME Q_UINT64_C(1099511628211)
+
 namespace Passport
 {
 	enum Type
@@ -60,4 +71,31 @@ namespace ColorSpace
 	};
 }
 
+// Kind of data in section of file of Source model
+namespace ModelSection
+{
+	enum Type
+	{
+		PLANE = 0,
+		BYTE_PLANE,
+		// Offsets of cells of look up table of pixels
+		LOOKUP_OFFSETS,
+		// Indexes of pixels of cells of look up table
+		LOOKUP_PIXELS,
+		DEFAULT_LAST
+	};
+}
+
+// Way to transform colors from RGB to LAB
+namespace ColorConversion
+{
+	enum Type
+	{
+		FORMULA = 0,
+		LOOKUP_TABLE,
+		VECTORIZED,
+		DEFAULT_LAST
+	};
+}
+
 #endif // IMAGES_H
@@ -25,6 +25,14 @@
 
 #define NUM_RGB_VALUES 256
 
+// Max size of features of Source images kept in memory by FeaturesCache (in bytes)
+#define FEATURES_CACHE_MAX_BYTES 536870912
+
+// Max number of points in leaf of tree of ImgFeaturesIndex
+#define INDEX_LEAF_SIZE 8
+// Max number of neighbors, which could be found by one search in ImgFeaturesIndex
+#define INDEX_MAX_NEIGHBORS 32
+
 namespace Histogram
 {
 	enum Type
@@ -32,6 +32,10 @@
 #define SKO_MASK_RECT_SIDE 5
 #define ENTROPY_MASK_RECT_SIDE 11
 
+// Range of sides of masks of features, which could be set at runtime (sides are odd)
+#define FEATURE_MASK_MIN_SIDE SMALL_MASK_RECT_SIDE
+#define FEATURE_MASK_MAX_SIDE BIG_MASK_RECT_SIDE
+
 #define LAB_MIN_LUM 0.0
 #define LAB_MAX_LUM 4.2
 #define LAB_LUM_HIST_DIVIDER 0.001
@@ -49,4 +53,81 @@
 #define RELATIVE_MAX 1.0
 #define RELATIVE_DIVIDER 0.001
 
+// Number of values of one RGB channel
+#define RGB_CHANNEL_LEVELS 256
+
+// Number of intervals in lookup table of log10() (for RGB -> LAB transform)
+#define LOG10_TABLE_SIZE 4096
+#define LOG10_OF_TWO 0.30102999566398119521
+
+// Alignment (in bytes) of each plane of pixels
+#define PLANE_ALIGNMENT 64
+
+// 16-bit fixed point values of planes: step is 1/4096 (less than all dividers), range is [-8, 8)
+#define FIXED16_SCALE 4096.0
+#define FIXED16_MIN -32768.0
+#define FIXED16_MAX 32767.0
+
+// Max power of values, which sums in masks could be calculated by ImgMaskSums
+#define MASK_SUMS_MAX_POWER 4
+
+// Max number of pixels in mask, which central moments could be calculated exactly by ImgMaskHistogram.
+// n^4 * M4 must fit into 64 bits. For bins 0..999 M4 is max, when share p of pixels is in bin 0 and other pixels
+// are in bin 999: M4 = 999^4 * p * (1 - p) * (p^3 + (1 - p)^3), which is max (0.0833 * 999^4) for p near 0.21.
+// So n^4 * 0.0833 * 999^4 < 2^64 gives n <= 122.
+#define MASK_MOMENTS_MAX_PIXELS 122
+
+#if FEATURE_MASK_MAX_SIDE * FEATURE_MASK_MAX_SIDE > MASK_MOMENTS_MAX_PIXELS
+#error "Biggest mask of features is too big for exact central moments"
+#endif
+
+// Number of pixels transformed at once through temporary buffers (if planes values are not double)
+#define PLANE_CHUNK_SIZE 512
+
+// Number of rows in band of image, for which features of pixels are calculated at once (with halo rows band
+// data should stay in cache)
+#define FEATURE_BAND_ROWS 32
+
+// Features of pixels, which could be needed by colorization methods
+namespace Feature
+{
+	enum Type
+	{
+		SKO = 0,
+		ENTROPY,
+		SKEW_AND_KURT,
+		DEFAULT_LAST
+	};
+}
+
+// Planes of pixels characteristics (one value of type PlaneValue per pixel)
+namespace Plane
+{
+	enum Type
+	{
+		LUM = 0,
+		CH_A,
+		CH_B,
+		REL_LUM,
+		SKO,
+		ENTROPY,
+		SKEWNESS,
+		KURTOSIS,
+		DEFAULT_LAST
+	};
+}
+
+// Planes of pixels byte values (one value of type unsigned char per pixel)
+namespace BytePlane
+{
+	enum Type
+	{
+		RED = 0,
+		GREEN,
+		BLUE,
+		COLORED,
+		DEFAULT_LAST
+	};
+}
+
 #endif // PIXELS_H
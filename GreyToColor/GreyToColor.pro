@@ -10,6 +10,10 @@ CONFIG += warn_on
 QMAKE_CXXFLAGS_WARN_ON += -Werror -Wformat=2 -Wuninitialized -Winit-self -Wmissing-include-dirs -Wswitch-enum \
 	-Wundef -Wpointer-arith -Wdisabled-optimization -Wcast-align -Wcast-qual
 
+# Precision of values in planes of pixels (double by default). Uncomment one line to save memory
+#DEFINES += PLANE_PRECISION_FLOAT
+#DEFINES += PLANE_PRECISION_FIXED16
+
 TARGET = GreyToColor
 TEMPLATE = app
 
@@ -20,16 +24,21 @@ SOURCES += main.cpp\
 	UI/scalelabel.cpp \
 	imghandler.cpp \
 	IMAGES/SOURCE/PIXELS/sourceimgpixels.cpp \
+	IMAGES/SOURCE/PIXELS/featuresbandtask.cpp \
 	IMAGES/SOURCE/PIXELS/colorpixel.cpp \
 	IMAGES/TARGET/PIXELS/targetpixel.cpp \
 	IMAGES/TARGET/PIXELS/preferedcolor.cpp \
 	IMAGES/COMMON/PIXELS/COLOR_SPACE/rgblab.cpp \
+	IMAGES/COMMON/PIXELS/COLOR_SPACE/rgblabtable.cpp \
+	IMAGES/COMMON/PIXELS/COLOR_SPACE/rgblabsimd.cpp \
 	IMAGES/COMMON/PIXELS/rgb.cpp \
 	IMAGES/COMMON/PIXELS/pixel.cpp \
 	IMAGES/COMMON/PIXELS/lab.cpp \
 	IMAGES/COMMON/PIXELS/imagepixels.cpp \
+	IMAGES/COMMON/PIXELS/pixelplanes.cpp \
 	IMAGES/COMMON/image.cpp \
 	SERVICE/calculatorsko.cpp \
+	SERVICE/fastmath.cpp \
 	IMAGES/TARGET/PIXELS/targetimgpixels.cpp \
 	IMAGES/CANDIDATE/candidateimage.cpp \
 	SERVICE/FILES/filesservice.cpp \
@@ -42,8 +51,16 @@ SOURCES += main.cpp\
 	PARAMS/IMAGES/imgsimilarityarea.cpp \
 	application.cpp \
 	SERVICE/FILES/idbfilesservice.cpp \
+	SERVICE/FILES/sourcemodelfile.cpp \
 	PARAMS/IMAGES/imgpassport.cpp \
 	SERVICE/IMAGES/imghistogram.cpp \
+	SERVICE/IMAGES/imgmasksums.cpp \
+	SERVICE/IMAGES/imgmaskhistogram.cpp \
+	SERVICE/IMAGES/featurescache.cpp \
+	SERVICE/IMAGES/imglookuptable.cpp \
+	SERVICE/IMAGES/imgfeaturesindex.cpp \
+	SERVICE/IMAGES/imglumsortedindex.cpp \
+	SERVICE/IMAGES/imgvptree.cpp \
 	SERVICE/IMAGES/imgpassportcreator.cpp \
 	SERVICE/IMAGES/imgsubsampler.cpp \
 	idbhandler.cpp \
@@ -73,16 +90,22 @@ HEADERS  += \
 	DEFINES/global.h \
 	DEFINES/pixels.h \
 	IMAGES/SOURCE/PIXELS/sourceimgpixels.h \
+	IMAGES/SOURCE/PIXELS/featuresbandtask.h \
 	IMAGES/SOURCE/PIXELS/colorpixel.h \
 	IMAGES/TARGET/PIXELS/targetpixel.h \
 	IMAGES/TARGET/PIXELS/preferedcolor.h \
 	IMAGES/COMMON/PIXELS/COLOR_SPACE/rgblab.h \
+	IMAGES/COMMON/PIXELS/COLOR_SPACE/rgblabtable.h \
+	IMAGES/COMMON/PIXELS/COLOR_SPACE/rgblabsimd.h \
 	IMAGES/COMMON/PIXELS/rgb.h \
 	IMAGES/COMMON/PIXELS/pixel.h \
 	IMAGES/COMMON/PIXELS/lab.h \
 	IMAGES/COMMON/PIXELS/imagepixels.h \
+	IMAGES/COMMON/PIXELS/pixelplanes.h \
+	IMAGES/COMMON/PIXELS/planevalue.h \
 	IMAGES/COMMON/image.h \
 	SERVICE/calculatorsko.h \
+	SERVICE/fastmath.h \
 	IMAGES/TARGET/PIXELS/targetimgpixels.h \
 	IMAGES/CANDIDATE/candidateimage.h \
 	DEFINES/images.h \
@@ -97,9 +120,17 @@ HEADERS  += \
 	PARAMS/IMAGES/imgsimilarityarea.h \
 	application.h \
 	SERVICE/FILES/idbfilesservice.h \
+	SERVICE/FILES/sourcemodelfile.h \
 	PARAMS/IMAGES/imgpassport.h \
 	DEFINES/imgservice.h \
 	SERVICE/IMAGES/imghistogram.h \
+	SERVICE/IMAGES/imgmasksums.h \
+	SERVICE/IMAGES/imgmaskhistogram.h \
+	SERVICE/IMAGES/featurescache.h \
+	SERVICE/IMAGES/imglookuptable.h \
+	SERVICE/IMAGES/imgfeaturesindex.h \
+	SERVICE/IMAGES/imglumsortedindex.h \
+	SERVICE/IMAGES/imgvptree.h \
 	SERVICE/IMAGES/imgpassportcreator.h \
 	SERVICE/IMAGES/imgsubsampler.h \
 	idbhandler.h \
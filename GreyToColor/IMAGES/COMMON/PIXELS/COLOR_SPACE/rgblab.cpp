@@ -18,10 +18,47 @@
 
 #include "rgblab.h"
 
+ColorConversion::Type RGBLAB::s_conversionType = ColorConversion::VECTORIZED;
+
 RGBLAB::RGBLAB()
 {
 }
 
+// Set way to transform colors from RGB to LAB
+// @input:
+// - ColorConversion::Type - exist type of conversion:
+// -- FORMULA - exact formula (use it for reference results)
+// -- LOOKUP_TABLE - precomputed tables (LAB values differ from formula less than 1e-8)
+// -- VECTORIZED - rows of pixels are transformed by SIMD functions (if platform don't support them, formula is used)
+// @output:
+void RGBLAB::SetConversionType(const ColorConversion::Type &t_type)
+{
+	switch(t_type)
+	{
+		case ColorConversion::FORMULA:
+		case ColorConversion::LOOKUP_TABLE:
+		case ColorConversion::VECTORIZED:
+			s_conversionType = t_type;
+			break;
+
+		case ColorConversion::DEFAULT_LAST:
+		default:
+		{
+			qDebug() << "SetConversionType(): Error - invalid arguments";
+			return;
+		}
+	}
+}
+
+// Get way to transform colors from RGB to LAB
+// @input:
+// @output:
+// - ColorConversion::Type - current type of conversion
+ColorConversion::Type RGBLAB::GetConversionType()
+{
+	return s_conversionType;
+}
+
 // Transform color from RGB color space to LAB color space
 // @input:
 // - RGB - RGB color
@@ -29,9 +66,48 @@ RGBLAB::RGBLAB()
 // - LAB - mapped RGB color in LAB color space
 LAB RGBLAB::RGB2LAB(const RGB &t_rgbColor)
 {
-	const int R = t_rgbColor.GetRed();
-	const int G = t_rgbColor.GetGreen();
-	const int B = t_rgbColor.GetBlue();
+	double chL = 0.0;
+	double chA = 0.0;
+	double chB = 0.0;
+	RGB2LAB((unsigned char)t_rgbColor.GetRed(),
+			(unsigned char)t_rgbColor.GetGreen(),
+			(unsigned char)t_rgbColor.GetBlue(),
+			chL,
+			chA,
+			chB);
+
+	LAB labColor(chL,
+				 chA,
+				 chB);
+
+	return labColor;
+}
+
+// Transform color from RGB color space to LAB color space
+// @input:
+// - unsigned char - red channel of color
+// - unsigned char - green channel of color
+// - unsigned char - blue channel of color
+// - double - luminance channel of LAB color (output)
+// - double - channel A of LAB color (output)
+// - double - channel B of LAB color (output)
+// @output:
+void RGBLAB::RGB2LAB(const unsigned char &t_red,
+					 const unsigned char &t_green,
+					 const unsigned char &t_blue,
+					 double &t_chL,
+					 double &t_chA,
+					 double &t_chB)
+{
+	if ( ColorConversion::LOOKUP_TABLE == s_conversionType )
+	{
+		RGBLABTable::Instance().RGB2LAB(t_red, t_green, t_blue, t_chL, t_chA, t_chB);
+		return;
+	}
+
+	const int R = t_red;
+	const int G = t_green;
+	const int B = t_blue;
 
 	double L = 0.3811*R + 0.5783*G + 0.0402*B;
 	double M = 0.1967*R + 0.7244*G + 0.0782*B;
@@ -52,24 +128,57 @@ LAB RGBLAB::RGB2LAB(const RGB &t_rgbColor)
 		S = 0.01;
 	}
 
-	L = log10(L);
-	M = log10(M);
-	S = log10(S);
+	L = FastMath::Log10(L);
+	M = FastMath::Log10(M);
+	S = FastMath::Log10(S);
 
-	double chL = 0.5774*L + 0.5774*M + 0.5774*S;
-	double chA = 0.4082*L + 0.4082*M - 0.8165*S;
-	double chB = 0.7071*L - 0.7071*M;
+	t_chL = 0.5774*L + 0.5774*M + 0.5774*S;
+	t_chA = 0.4082*L + 0.4082*M - 0.8165*S;
+	t_chB = 0.7071*L - 0.7071*M;
 
-	if ( chL < 0.01 )
+	if ( t_chL < 0.01 )
 	{
-		chL = 0;
+		t_chL = 0;
 	}
+}
 
-	LAB labColor(chL,
-				 chA,
-				 chB);
+// Transform row of colors from RGB color space to LAB color space
+// @input:
+// - unsigned char * - red channels of colors
+// - unsigned char * - green channels of colors
+// - unsigned char * - blue channels of colors
+// - double * - luminance channels of LAB colors (output)
+// - double * - channels A of LAB colors (output)
+// - double * - channels B of LAB colors (output)
+// - unsigned int - number of colors in row
+// @output:
+void RGBLAB::RGB2LABRow(const unsigned char *t_red,
+						const unsigned char *t_green,
+						const unsigned char *t_blue,
+						double *t_chL,
+						double *t_chA,
+						double *t_chB,
+						const unsigned int &t_count)
+{
+	if ( (NULL == t_red) || (NULL == t_green) || (NULL == t_blue) ||
+		 (NULL == t_chL) || (NULL == t_chA) || (NULL == t_chB) )
+	{
+		qDebug() << "RGB2LABRow(): Error - invalid arguments";
+		return;
+	}
 
-	return labColor;
+	if ( (ColorConversion::VECTORIZED == s_conversionType) && (true == RGBLABSIMD::IsSupported()) )
+	{
+		RGBLABSIMD simdTransformer;
+		simdTransformer.SetFastMode(FastMath::IsEnabled());
+		simdTransformer.RGB2LAB(t_red, t_green, t_blue, t_chL, t_chA, t_chB, t_count);
+		return;
+	}
+
+	for ( unsigned int pix = 0; pix < t_count; pix++ )
+	{
+		RGB2LAB(t_red[pix], t_green[pix], t_blue[pix], t_chL[pix], t_chA[pix], t_chB[pix]);
+	}
 }
 
 // Transform color from LAB color space to RGB color space
@@ -79,17 +188,44 @@ LAB RGBLAB::RGB2LAB(const RGB &t_rgbColor)
 // - RGB - mapped LAB color in RGB color space
 RGB RGBLAB::LAB2RGB(const LAB &t_labColor)
 {
-	const double chL = t_labColor.GetChL();
-	const double chA = t_labColor.GetChA();
-	const double chB = t_labColor.GetChB();
+	unsigned char red = 0;
+	unsigned char green = 0;
+	unsigned char blue = 0;
+	LAB2RGB(t_labColor.GetChL(),
+			t_labColor.GetChA(),
+			t_labColor.GetChB(),
+			red,
+			green,
+			blue);
+
+	RGB rgbColor(red, green, blue);
 
-	double L = 0.5774*chL + 0.4082*chA + 0.7071*chB;
-	double M = 0.5774*chL + 0.4082*chA - 0.7071*chB;
-	double S = 0.5774*chL - 0.8165*chA;
+	return rgbColor;
+}
+
+// Transform color from LAB color space to RGB color space
+// @input:
+// - double - luminance channel of LAB color
+// - double - channel A of LAB color
+// - double - channel B of LAB color
+// - unsigned char - red channel of color (output)
+// - unsigned char - green channel of color (output)
+// - unsigned char - blue channel of color (output)
+// @output:
+void RGBLAB::LAB2RGB(const double &t_chL,
+					 const double &t_chA,
+					 const double &t_chB,
+					 unsigned char &t_red,
+					 unsigned char &t_green,
+					 unsigned char &t_blue)
+{
+	double L = 0.5774*t_chL + 0.4082*t_chA + 0.7071*t_chB;
+	double M = 0.5774*t_chL + 0.4082*t_chA - 0.7071*t_chB;
+	double S = 0.5774*t_chL - 0.8165*t_chA;
 
-	L = pow(10, L);
-	M = pow(10, M);
-	S = pow(10, S);
+	L = FastMath::Pow10(L);
+	M = FastMath::Pow10(M);
+	S = FastMath::Pow10(S);
 
 	int R = 4.4679*L - 3.5873*M + 0.1193*S;
 	int G = (-1.2186)*L + 2.3809*M - 0.1624*S;
@@ -122,7 +258,46 @@ RGB RGBLAB::LAB2RGB(const LAB &t_labColor)
 		B = 255;
 	}
 
-	RGB rgbColor(R, G, B);
+	t_red = (unsigned char)R;
+	t_green = (unsigned char)G;
+	t_blue = (unsigned char)B;
+}
 
-	return rgbColor;
+// Transform row of colors from LAB color space to RGB color space
+// @input:
+// - double * - luminance channels of LAB colors
+// - double * - channels A of LAB colors
+// - double * - channels B of LAB colors
+// - unsigned char * - red channels of colors (output)
+// - unsigned char * - green channels of colors (output)
+// - unsigned char * - blue channels of colors (output)
+// - unsigned int - number of colors in row
+// @output:
+void RGBLAB::LAB2RGBRow(const double *t_chL,
+						const double *t_chA,
+						const double *t_chB,
+						unsigned char *t_red,
+						unsigned char *t_green,
+						unsigned char *t_blue,
+						const unsigned int &t_count)
+{
+	if ( (NULL == t_chL) || (NULL == t_chA) || (NULL == t_chB) ||
+		 (NULL == t_red) || (NULL == t_green) || (NULL == t_blue) )
+	{
+		qDebug() << "LAB2RGBRow(): Error - invalid arguments";
+		return;
+	}
+
+	if ( (ColorConversion::VECTORIZED == s_conversionType) && (true == RGBLABSIMD::IsSupported()) )
+	{
+		RGBLABSIMD simdTransformer;
+		simdTransformer.SetFastMode(FastMath::IsEnabled());
+		simdTransformer.LAB2RGB(t_chL, t_chA, t_chB, t_red, t_green, t_blue, t_count);
+		return;
+	}
+
+	for ( unsigned int pix = 0; pix < t_count; pix++ )
+	{
+		LAB2RGB(t_chL[pix], t_chA[pix], t_chB[pix], t_red[pix], t_green[pix], t_blue[pix]);
+	}
 }
@@ -23,18 +23,63 @@
 #include <math.h>
 #include "../rgb.h"
 #include "../lab.h"
+#include "rgblabtable.h"
+#include "rgblabsimd.h"
+#include "./SERVICE/fastmath.h"
 #include "./DEFINES/global.h"
+#include "./DEFINES/images.h"
 
 class RGBLAB
 {
+// DATA
+private:
+	// Way to transform colors from RGB to LAB (the same for all objects)
+	static ColorConversion::Type s_conversionType;
+
 // METHODS
 public:
 	explicit RGBLAB();
 
+	// Set way to transform colors from RGB to LAB
+	static void SetConversionType(const ColorConversion::Type &t_type);
+	// Get way to transform colors from RGB to LAB
+	static ColorConversion::Type GetConversionType();
 	// Transform color from RGB color space to LAB color space
 	LAB RGB2LAB(const RGB &t_rgbColor);
+	// Transform color from RGB color space to LAB color space
+	void RGB2LAB(const unsigned char &t_red,
+				 const unsigned char &t_green,
+				 const unsigned char &t_blue,
+				 double &t_chL,
+				 double &t_chA,
+				 double &t_chB);
+	// Transform row of colors from RGB color space to LAB color space
+	void RGB2LABRow(const unsigned char *t_red,
+					const unsigned char *t_green,
+					const unsigned char *t_blue,
+					double *t_chL,
+					double *t_chA,
+					double *t_chB,
+					const unsigned int &t_count);
+
 	// Transform color from LAB color space to RGB color space
 	RGB LAB2RGB(const LAB &t_labColor);
+	// Transform color from LAB color space to RGB color space
+	void LAB2RGB(const double &t_chL,
+				 const double &t_chA,
+				 const double &t_chB,
+				 unsigned char &t_red,
+				 unsigned char &t_green,
+				 unsigned char &t_blue);
+
+	// Transform row of colors from LAB color space to RGB color space
+	void LAB2RGBRow(const double *t_chL,
+					const double *t_chA,
+					const double *t_chB,
+					unsigned char *t_red,
+					unsigned char *t_green,
+					unsigned char *t_blue,
+					const unsigned int &t_count);
 };
 
 #endif // RGBLAB_H
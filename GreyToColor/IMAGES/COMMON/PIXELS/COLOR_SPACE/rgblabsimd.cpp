@@ -0,0 +1,355 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rgblabsimd.h"
+#include <QtGlobal>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define RGBLAB_SSE2
+#endif
+
+#ifdef RGBLAB_SSE2
+
+static const double SQRT_OF_TWO = 1.41421356237309504880;
+static const double LN_OF_TWO = 0.69314718055994530942;
+static const double LOG2_OF_TEN = 3.32192809488736234787;
+static const double LOG10_OF_E = 0.43429448190325182765;
+
+#endif // RGBLAB_SSE2
+
+#ifdef RGBLAB_SSE2
+
+// Calc log10() for two positive values
+// @input:
+// - __m128d - two positive values
+// - bool - true to use short series
+// @output:
+// - __m128d - log10() of values
+static inline __m128d Log10SSE2(const __m128d &t_value, const bool &t_fast)
+{
+	// t_value = mantissa * 2^exponent, mantissa in range [1, 2)
+	const __m128i bits = _mm_castpd_si128(t_value);
+	const __m128i mantissaMask = _mm_set1_epi64x(0x000FFFFFFFFFFFFFLL);
+	const __m128i oneBits = _mm_set1_epi64x(0x3FF0000000000000LL);
+	__m128d mantissa = _mm_castsi128_pd( _mm_or_si128(_mm_and_si128(bits, mantissaMask), oneBits) );
+
+	// Exponents are small positive 64-bit integers: move their low parts to two 32-bit integers
+	__m128i exponentBits = _mm_srli_epi64(bits, 52);
+	exponentBits = _mm_shuffle_epi32(exponentBits, _MM_SHUFFLE(3, 1, 2, 0));
+	__m128d exponent = _mm_sub_pd( _mm_cvtepi32_pd(exponentBits), _mm_set1_pd(1023.0) );
+
+	// Move mantissa to range [sqrt(2)/2, sqrt(2)) to make series converge faster
+	const __m128d bigMantissa = _mm_cmpgt_pd(mantissa, _mm_set1_pd(SQRT_OF_TWO));
+	mantissa = _mm_or_pd( _mm_and_pd(bigMantissa, _mm_mul_pd(mantissa, _mm_set1_pd(0.5))),
+						  _mm_andnot_pd(bigMantissa, mantissa) );
+
+	exponent = _mm_add_pd( exponent, _mm_and_pd(bigMantissa, _mm_set1_pd(1.0)) );
+
+	// ln(m) = 2 * (s + s^3/3 + s^5/5 + ...), s = (m - 1) / (m + 1)
+	const __m128d one = _mm_set1_pd(1.0);
+	const __m128d s = _mm_div_pd( _mm_sub_pd(mantissa, one), _mm_add_pd(mantissa, one) );
+	const __m128d z = _mm_mul_pd(s, s);
+	__m128d series = _mm_set1_pd(1.0 / 9.0);
+	if ( false == t_fast )
+	{
+		series = _mm_set1_pd(1.0 / 21.0);
+		series = _mm_add_pd( _mm_mul_pd(series, z), _mm_set1_pd(1.0 / 19.0) );
+		series = _mm_add_pd( _mm_mul_pd(series, z), _mm_set1_pd(1.0 / 17.0) );
+		series = _mm_add_pd( _mm_mul_pd(series, z), _mm_set1_pd(1.0 / 15.0) );
+		series = _mm_add_pd( _mm_mul_pd(series, z), _mm_set1_pd(1.0 / 13.0) );
+		series = _mm_add_pd( _mm_mul_pd(series, z), _mm_set1_pd(1.0 / 11.0) );
+		series = _mm_add_pd( _mm_mul_pd(series, z), _mm_set1_pd(1.0 / 9.0) );
+	}
+
+	series = _mm_add_pd( _mm_mul_pd(series, z), _mm_set1_pd(1.0 / 7.0) );
+	series = _mm_add_pd( _mm_mul_pd(series, z), _mm_set1_pd(1.0 / 5.0) );
+	series = _mm_add_pd( _mm_mul_pd(series, z), _mm_set1_pd(1.0 / 3.0) );
+	series = _mm_add_pd( _mm_mul_pd(series, z), one );
+	const __m128d lnMantissa = _mm_mul_pd( _mm_mul_pd(_mm_set1_pd(2.0), s), series );
+
+	const __m128d lnValue = _mm_add_pd( _mm_mul_pd(exponent, _mm_set1_pd(LN_OF_TWO)), lnMantissa );
+	return _mm_mul_pd(lnValue, _mm_set1_pd(LOG10_OF_E));
+}
+
+// Calc 10^x for two values
+// @input:
+// - __m128d - two values in range [-300, 300]
+// - bool - true to use short series
+// @output:
+// - __m128d - 10^x
+static inline __m128d Pow10SSE2(const __m128d &t_value, const bool &t_fast)
+{
+	// 10^x = 2^n * e^(f * ln(2)), where n is integer nearest to x * log2(10) and f in range [-0.5, 0.5]
+	__m128d power = _mm_mul_pd( t_value, _mm_set1_pd(LOG2_OF_TEN) );
+	power = _mm_min_pd( _mm_max_pd(power, _mm_set1_pd(-1000.0)), _mm_set1_pd(1000.0) );
+
+	const __m128i intPower = _mm_cvtpd_epi32(power);
+	const __m128d fraction = _mm_sub_pd( power, _mm_cvtepi32_pd(intPower) );
+	const __m128d t = _mm_mul_pd( fraction, _mm_set1_pd(LN_OF_TWO) );
+
+	// e^t by Taylor series (|t| < 0.35)
+	const __m128d one = _mm_set1_pd(1.0);
+	__m128d series = _mm_set1_pd(1.0 / 40320.0);
+	if ( false == t_fast )
+	{
+		series = _mm_set1_pd(1.0 / 6227020800.0);
+		series = _mm_add_pd( _mm_mul_pd(series, t), _mm_set1_pd(1.0 / 479001600.0) );
+		series = _mm_add_pd( _mm_mul_pd(series, t), _mm_set1_pd(1.0 / 39916800.0) );
+		series = _mm_add_pd( _mm_mul_pd(series, t), _mm_set1_pd(1.0 / 3628800.0) );
+		series = _mm_add_pd( _mm_mul_pd(series, t), _mm_set1_pd(1.0 / 362880.0) );
+		series = _mm_add_pd( _mm_mul_pd(series, t), _mm_set1_pd(1.0 / 40320.0) );
+	}
+
+	series = _mm_add_pd( _mm_mul_pd(series, t), _mm_set1_pd(1.0 / 5040.0) );
+	series = _mm_add_pd( _mm_mul_pd(series, t), _mm_set1_pd(1.0 / 720.0) );
+	series = _mm_add_pd( _mm_mul_pd(series, t), _mm_set1_pd(1.0 / 120.0) );
+	series = _mm_add_pd( _mm_mul_pd(series, t), _mm_set1_pd(1.0 / 24.0) );
+	series = _mm_add_pd( _mm_mul_pd(series, t), _mm_set1_pd(1.0 / 6.0) );
+	series = _mm_add_pd( _mm_mul_pd(series, t), _mm_set1_pd(0.5) );
+	series = _mm_add_pd( _mm_mul_pd(series, t), one );
+	series = _mm_add_pd( _mm_mul_pd(series, t), one );
+
+	// 2^n: put (n + 1023) to exponent bits of double. Powers are saturated above, so biased exponent is
+	// always in range [23, 2023]
+	__m128i biased = _mm_add_epi32( intPower, _mm_set1_epi32(1023) );
+	biased = _mm_unpacklo_epi32( biased, _mm_setzero_si128() );
+	const __m128d scale = _mm_castsi128_pd( _mm_slli_epi64(biased, 52) );
+
+	return _mm_mul_pd(series, scale);
+}
+
+// Pack two 32-bit integers to bytes with saturation to range [0, 255] and save them
+// @input:
+// - __m128i - two 32-bit integers in low part of register
+// - unsigned char * - pointer to place for two bytes
+// @output:
+static inline void StoreSaturatedSSE2(const __m128i &t_values, unsigned char *t_dest)
+{
+	const __m128i words = _mm_packs_epi32( t_values, t_values );
+	const __m128i bytes = _mm_packus_epi16( words, words );
+	const int packed = _mm_cvtsi128_si32(bytes);
+	t_dest[0] = (unsigned char)(packed & 0xFF);
+	t_dest[1] = (unsigned char)((packed >> 8) & 0xFF);
+}
+
+#endif // RGBLAB_SSE2
+
+RGBLABSIMD::RGBLABSIMD()
+{
+	m_fastMode = false;
+}
+
+// Switch on or off fast mode (shorter series)
+// @input:
+// - bool - true to use short series
+// @output:
+void RGBLABSIMD::SetFastMode(const bool &t_fastMode)
+{
+	m_fastMode = t_fastMode;
+}
+
+// Check if vectorized transformation is available
+// @input:
+// @output:
+// - true - vectorized functions could be used
+// - false - vectorized functions are not available on this platform
+bool RGBLABSIMD::IsSupported()
+{
+#ifdef RGBLAB_SSE2
+	return true;
+#else
+	return false;
+#endif
+}
+
+// Transform row of colors from RGB color space to LAB color space
+// @input:
+// - unsigned char * - red channels of colors
+// - unsigned char * - green channels of colors
+// - unsigned char * - blue channels of colors
+// - double * - luminance channels of LAB colors (output)
+// - double * - channels A of LAB colors (output)
+// - double * - channels B of LAB colors (output)
+// - unsigned int - number of colors in row
+// @output:
+void RGBLABSIMD::RGB2LAB(const unsigned char *t_red,
+						 const unsigned char *t_green,
+						 const unsigned char *t_blue,
+						 double *t_chL,
+						 double *t_chA,
+						 double *t_chB,
+						 const unsigned int &t_count) const
+{
+#ifdef RGBLAB_SSE2
+	const __m128d minLMS = _mm_set1_pd(0.01);
+	const __m128d minLum = _mm_set1_pd(0.01);
+
+	unsigned int pix = 0;
+	for ( ; pix + 1 < t_count; pix += 2 )
+	{
+		const __m128d R = _mm_setr_pd(t_red[pix], t_red[pix + 1]);
+		const __m128d G = _mm_setr_pd(t_green[pix], t_green[pix + 1]);
+		const __m128d B = _mm_setr_pd(t_blue[pix], t_blue[pix + 1]);
+
+		// The same order of operations as in RGBLAB::RGB2LAB(), so LMS values are exactly the same
+		__m128d L = _mm_add_pd( _mm_add_pd( _mm_mul_pd(_mm_set1_pd(0.3811), R),
+											_mm_mul_pd(_mm_set1_pd(0.5783), G) ),
+								_mm_mul_pd(_mm_set1_pd(0.0402), B) );
+
+		__m128d M = _mm_add_pd( _mm_add_pd( _mm_mul_pd(_mm_set1_pd(0.1967), R),
+											_mm_mul_pd(_mm_set1_pd(0.7244), G) ),
+								_mm_mul_pd(_mm_set1_pd(0.0782), B) );
+
+		__m128d S = _mm_add_pd( _mm_add_pd( _mm_mul_pd(_mm_set1_pd(0.0241), R),
+											_mm_mul_pd(_mm_set1_pd(0.1288), G) ),
+								_mm_mul_pd(_mm_set1_pd(0.8444), B) );
+
+		L = Log10SSE2( _mm_max_pd(L, minLMS), m_fastMode );
+		M = Log10SSE2( _mm_max_pd(M, minLMS), m_fastMode );
+		S = Log10SSE2( _mm_max_pd(S, minLMS), m_fastMode );
+
+		__m128d chL = _mm_add_pd( _mm_add_pd( _mm_mul_pd(_mm_set1_pd(0.5774), L),
+											  _mm_mul_pd(_mm_set1_pd(0.5774), M) ),
+								  _mm_mul_pd(_mm_set1_pd(0.5774), S) );
+
+		const __m128d chA = _mm_sub_pd( _mm_add_pd( _mm_mul_pd(_mm_set1_pd(0.4082), L),
+													_mm_mul_pd(_mm_set1_pd(0.4082), M) ),
+										_mm_mul_pd(_mm_set1_pd(0.8165), S) );
+
+		const __m128d chB = _mm_sub_pd( _mm_mul_pd(_mm_set1_pd(0.7071), L),
+										_mm_mul_pd(_mm_set1_pd(0.7071), M) );
+
+		chL = _mm_andnot_pd( _mm_cmplt_pd(chL, minLum), chL );
+
+		_mm_storeu_pd(t_chL + pix, chL);
+		_mm_storeu_pd(t_chA + pix, chA);
+		_mm_storeu_pd(t_chB + pix, chB);
+	}
+
+	// Last odd pixel
+	if ( pix < t_count )
+	{
+		unsigned char red[2] = { t_red[pix], 0 };
+		unsigned char green[2] = { t_green[pix], 0 };
+		unsigned char blue[2] = { t_blue[pix], 0 };
+		double chL[2];
+		double chA[2];
+		double chB[2];
+		RGB2LAB(red, green, blue, chL, chA, chB, 2);
+
+		t_chL[pix] = chL[0];
+		t_chA[pix] = chA[0];
+		t_chB[pix] = chB[0];
+	}
+#else
+	Q_UNUSED(t_red);
+	Q_UNUSED(t_green);
+	Q_UNUSED(t_blue);
+	Q_UNUSED(t_chL);
+	Q_UNUSED(t_chA);
+	Q_UNUSED(t_chB);
+	Q_UNUSED(t_count);
+#endif
+}
+
+// Transform row of colors from LAB color space to RGB color space
+// @input:
+// - double * - luminance channels of LAB colors
+// - double * - channels A of LAB colors
+// - double * - channels B of LAB colors
+// - unsigned char * - red channels of colors (output)
+// - unsigned char * - green channels of colors (output)
+// - unsigned char * - blue channels of colors (output)
+// - unsigned int - number of colors in row
+// @output:
+void RGBLABSIMD::LAB2RGB(const double *t_chL,
+						 const double *t_chA,
+						 const double *t_chB,
+						 unsigned char *t_red,
+						 unsigned char *t_green,
+						 unsigned char *t_blue,
+						 const unsigned int &t_count) const
+{
+#ifdef RGBLAB_SSE2
+	unsigned int pix = 0;
+	for ( ; pix + 1 < t_count; pix += 2 )
+	{
+		const __m128d chL = _mm_loadu_pd(t_chL + pix);
+		const __m128d chA = _mm_loadu_pd(t_chA + pix);
+		const __m128d chB = _mm_loadu_pd(t_chB + pix);
+
+		// The same order of operations as in RGBLAB::LAB2RGB()
+		__m128d L = _mm_add_pd( _mm_add_pd( _mm_mul_pd(_mm_set1_pd(0.5774), chL),
+											_mm_mul_pd(_mm_set1_pd(0.4082), chA) ),
+								_mm_mul_pd(_mm_set1_pd(0.7071), chB) );
+
+		__m128d M = _mm_sub_pd( _mm_add_pd( _mm_mul_pd(_mm_set1_pd(0.5774), chL),
+											_mm_mul_pd(_mm_set1_pd(0.4082), chA) ),
+								_mm_mul_pd(_mm_set1_pd(0.7071), chB) );
+
+		__m128d S = _mm_sub_pd( _mm_mul_pd(_mm_set1_pd(0.5774), chL),
+								_mm_mul_pd(_mm_set1_pd(0.8165), chA) );
+
+		L = Pow10SSE2(L, m_fastMode);
+		M = Pow10SSE2(M, m_fastMode);
+		S = Pow10SSE2(S, m_fastMode);
+
+		const __m128d R = _mm_add_pd( _mm_sub_pd( _mm_mul_pd(_mm_set1_pd(4.4679), L),
+												  _mm_mul_pd(_mm_set1_pd(3.5873), M) ),
+									  _mm_mul_pd(_mm_set1_pd(0.1193), S) );
+
+		const __m128d G = _mm_sub_pd( _mm_add_pd( _mm_mul_pd(_mm_set1_pd(-1.2186), L),
+												  _mm_mul_pd(_mm_set1_pd(2.3809), M) ),
+									  _mm_mul_pd(_mm_set1_pd(0.1624), S) );
+
+		const __m128d B = _mm_add_pd( _mm_sub_pd( _mm_mul_pd(_mm_set1_pd(0.0497), L),
+												  _mm_mul_pd(_mm_set1_pd(0.2439), M) ),
+									  _mm_mul_pd(_mm_set1_pd(1.2045), S) );
+
+		// Truncate to integers as conversion to int does and clamp to [0, 255]
+		StoreSaturatedSSE2(_mm_cvttpd_epi32(R), t_red + pix);
+		StoreSaturatedSSE2(_mm_cvttpd_epi32(G), t_green + pix);
+		StoreSaturatedSSE2(_mm_cvttpd_epi32(B), t_blue + pix);
+	}
+
+	// Last odd pixel
+	if ( pix < t_count )
+	{
+		double chL[2] = { t_chL[pix], 0.0 };
+		double chA[2] = { t_chA[pix], 0.0 };
+		double chB[2] = { t_chB[pix], 0.0 };
+		unsigned char red[2];
+		unsigned char green[2];
+		unsigned char blue[2];
+		LAB2RGB(chL, chA, chB, red, green, blue, 2);
+
+		t_red[pix] = red[0];
+		t_green[pix] = green[0];
+		t_blue[pix] = blue[0];
+	}
+#else
+	Q_UNUSED(t_chL);
+	Q_UNUSED(t_chA);
+	Q_UNUSED(t_chB);
+	Q_UNUSED(t_red);
+	Q_UNUSED(t_green);
+	Q_UNUSED(t_blue);
+	Q_UNUSED(t_count);
+#endif
+}
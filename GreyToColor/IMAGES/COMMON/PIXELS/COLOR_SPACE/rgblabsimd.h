@@ -0,0 +1,62 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RGBLABSIMD_H
+#define RGBLABSIMD_H
+
+#include <math.h>
+
+// Class RGBLABSIMD
+// Vectorized (SSE2) transformation of rows of pixels between RGB and LAB color spaces. Logarithm and exponent are
+// calculated with series, which give LAB and RGB values equal to RGBLAB formula (difference is less than 1e-13).
+// In fast mode series are shorter (difference from formula is less than 1e-9).
+// If SSE2 is not available, IsSupported() returns false and functions do nothing.
+class RGBLABSIMD
+{
+	// == DATA ==
+private:
+	bool m_fastMode;
+
+	// == METHODS ==
+public:
+	RGBLABSIMD();
+
+	// Switch on or off fast mode (shorter series)
+	void SetFastMode(const bool &t_fastMode);
+	// Check if vectorized transformation is available
+	static bool IsSupported();
+	// Transform row of colors from RGB color space to LAB color space
+	void RGB2LAB(const unsigned char *t_red,
+				 const unsigned char *t_green,
+				 const unsigned char *t_blue,
+				 double *t_chL,
+				 double *t_chA,
+				 double *t_chB,
+				 const unsigned int &t_count) const;
+
+	// Transform row of colors from LAB color space to RGB color space
+	void LAB2RGB(const double *t_chL,
+				 const double *t_chA,
+				 const double *t_chB,
+				 unsigned char *t_red,
+				 unsigned char *t_green,
+				 unsigned char *t_blue,
+				 const unsigned int &t_count) const;
+};
+
+#endif // RGBLABSIMD_H
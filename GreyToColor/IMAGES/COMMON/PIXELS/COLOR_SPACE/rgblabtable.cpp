@@ -0,0 +1,146 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rgblabtable.h"
+
+RGBLABTable::RGBLABTable()
+{
+	// The same coefficients as in RGBLAB::RGB2LAB()
+	const double lmsCoeffs[3][3] = { {0.3811, 0.5783, 0.0402},
+									 {0.1967, 0.7244, 0.0782},
+									 {0.0241, 0.1288, 0.8444} };
+
+	for ( int component = 0; component < 3; component++ )
+	{
+		for ( int channel = 0; channel < 3; channel++ )
+		{
+			for ( int level = 0; level < RGB_CHANNEL_LEVELS; level++ )
+			{
+				m_lmsTable[component][channel][level] = lmsCoeffs[component][channel] * level;
+			}
+		}
+	}
+
+	for ( int step = 0; step <= LOG10_TABLE_SIZE; step++ )
+	{
+		m_log10Table[step] = log10( 0.5 + (double)step / (2 * LOG10_TABLE_SIZE) );
+	}
+}
+
+// Get tables
+// @input:
+// @output:
+// - RGBLABTable - built tables
+const RGBLABTable &RGBLABTable::Instance()
+{
+	static const RGBLABTable tables;
+	return tables;
+}
+
+// Transform color from RGB color space to LAB color space
+// @input:
+// - RGB - RGB color
+// @output:
+// - LAB - mapped RGB color in LAB color space
+LAB RGBLABTable::RGB2LAB(const RGB &t_rgbColor) const
+{
+	double chL = 0.0;
+	double chA = 0.0;
+	double chB = 0.0;
+	RGB2LAB((unsigned char)t_rgbColor.GetRed(),
+			(unsigned char)t_rgbColor.GetGreen(),
+			(unsigned char)t_rgbColor.GetBlue(),
+			chL,
+			chA,
+			chB);
+
+	LAB labColor(chL,
+				 chA,
+				 chB);
+
+	return labColor;
+}
+
+// Transform color from RGB color space to LAB color space
+// @input:
+// - unsigned char - red channel of color
+// - unsigned char - green channel of color
+// - unsigned char - blue channel of color
+// - double - luminance channel of LAB color (output)
+// - double - channel A of LAB color (output)
+// - double - channel B of LAB color (output)
+// @output:
+void RGBLABTable::RGB2LAB(const unsigned char &t_red,
+						  const unsigned char &t_green,
+						  const unsigned char &t_blue,
+						  double &t_chL,
+						  double &t_chA,
+						  double &t_chB) const
+{
+	double L = m_lmsTable[0][0][t_red] + m_lmsTable[0][1][t_green] + m_lmsTable[0][2][t_blue];
+	double M = m_lmsTable[1][0][t_red] + m_lmsTable[1][1][t_green] + m_lmsTable[1][2][t_blue];
+	double S = m_lmsTable[2][0][t_red] + m_lmsTable[2][1][t_green] + m_lmsTable[2][2][t_blue];
+
+	if ( L < 0.01 )
+	{
+		L = 0.01;
+	}
+
+	if ( M < 0.01 )
+	{
+		M = 0.01;
+	}
+
+	if ( S < 0.01 )
+	{
+		S = 0.01;
+	}
+
+	L = Log10(L);
+	M = Log10(M);
+	S = Log10(S);
+
+	t_chL = 0.5774*L + 0.5774*M + 0.5774*S;
+	t_chA = 0.4082*L + 0.4082*M - 0.8165*S;
+	t_chB = 0.7071*L - 0.7071*M;
+
+	if ( t_chL < 0.01 )
+	{
+		t_chL = 0;
+	}
+}
+
+// Get approximate log10() of positive value
+// @input:
+// - double - positive value
+// @output:
+// - double - log10() of value
+double RGBLABTable::Log10(const double &t_value) const
+{
+	// t_value = mantissa * 2^exponent, mantissa in range [0.5, 1)
+	int exponent = 0;
+	const double mantissa = frexp(t_value, &exponent);
+
+	const double position = (mantissa - 0.5) * (2 * LOG10_TABLE_SIZE);
+	const int step = (int)position;
+	const double fraction = position - step;
+
+	return exponent * LOG10_OF_TWO +
+			m_log10Table[step] +
+			fraction * (m_log10Table[step + 1] - m_log10Table[step]);
+}
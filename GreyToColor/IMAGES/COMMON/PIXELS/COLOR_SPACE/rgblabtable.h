@@ -0,0 +1,66 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RGBLABTABLE_H
+#define RGBLABTABLE_H
+
+#include <math.h>
+
+#include "../rgb.h"
+#include "../lab.h"
+#include "./DEFINES/pixels.h"
+
+// Class RGBLABTable
+// Precomputed tables for fast transformation of colors from RGB to LAB. Linear part of transformation (RGB -> LMS)
+// is taken from per-channel tables and gives exactly the same LMS values as formula. Logarithm of LMS values is
+// taken from table with linear interpolation. Max difference with formula for channels L, A and B is less
+// than 1e-8.
+// Tables are built once and shared by all objects. Use RGBLABTable::Instance() to get them.
+// Tables are opt-in: RGBLAB uses them only if conversion type is ColorConversion::LOOKUP_TABLE
+// (command line option "--color-conversion table").
+class RGBLABTable
+{
+	// == DATA ==
+private:
+	// Contribution of each RGB channel level to L, M and S values: [LMS component][RGB channel][level]
+	double m_lmsTable[3][3][RGB_CHANNEL_LEVELS];
+	// log10() of mantissa values in range [0.5, 1]
+	double m_log10Table[LOG10_TABLE_SIZE + 1];
+
+	// == METHODS ==
+public:
+	// Get tables
+	static const RGBLABTable &Instance();
+
+	// Transform color from RGB color space to LAB color space
+	LAB RGB2LAB(const RGB &t_rgbColor) const;
+	// Transform color from RGB color space to LAB color space
+	void RGB2LAB(const unsigned char &t_red,
+				 const unsigned char &t_green,
+				 const unsigned char &t_blue,
+				 double &t_chL,
+				 double &t_chA,
+				 double &t_chB) const;
+
+private:
+	RGBLABTable();
+	// Get approximate log10() of positive value
+	double Log10(const double &t_value) const;
+};
+
+#endif // RGBLABTABLE_H
@@ -36,21 +36,32 @@ void ImagePixels::Clear()
 	m_width = 0;
 	m_height = 0;
 
-	const int width = m_pixels.size();
-	for ( int i = width - 1; i >= 0; --i )
+	m_planes.Clear();
+}
+
+// Allocate planes for pixels of image with certain size
+// @input:
+// - unsigned int - positive width of image
+// - unsigned int - positive height of image
+// @output:
+// - true - pixels allocated
+// - false - failed to allocate pixels
+bool ImagePixels::AllocatePixels(const unsigned int &t_width, const unsigned int &t_height)
+{
+	m_width = 0;
+	m_height = 0;
+
+	bool planesAllocated = m_planes.Allocate(t_width, t_height);
+	if ( false == planesAllocated )
 	{
-		const int height = m_pixels.at(i).size();
-		for ( int j = height - 1; j >= 0; --j )
-		{
-			Pixel *pix = (Pixel *)m_pixels[i][j];
-			if ( NULL != pix )
-			{
-				delete pix;
-			}
-		}
+		qDebug() << "AllocatePixels(): Error - can't allocate pixels";
+		return false;
 	}
 
-	m_pixels.clear();
+	m_width = t_width;
+	m_height = t_height;
+
+	return true;
 }
 
 // Transform all image pixels from RGB color space to LAB
@@ -58,29 +69,46 @@ void ImagePixels::Clear()
 // @output:
 void ImagePixels::TransAllPixRGB2LAB()
 {
-	for ( unsigned int width = 0; width < m_width; width++ )
+	if ( true == m_planes.IsEmpty() )
 	{
-		for ( unsigned int height = 0; height < m_height; height++ )
-		{
-			TransformPixRGB2LAB(width, height);
-		}
+		return;
 	}
+
+	// Planes are continuous, so the whole image is transformed as one row
+	TransformPixelsRGB2LAB(0, m_planes.GetPixelsNum());
 }
 
 // Transform certain pixel from RGB color space to LAB
 // @input:
-// - unsigned int - exist width (x) position of pixel
-// - unsigned int - exist height (y) position of pixel
+// - unsigned int - exist index of pixel
 // @output:
-void ImagePixels::TransformPixRGB2LAB(const unsigned int &t_width, const unsigned int &t_height)
+void ImagePixels::TransformPixRGB2LAB(const unsigned int &t_index)
 {
-	if ( false == IsPixelExist(t_width, t_height) )
+	if ( m_planes.GetPixelsNum() <= t_index )
 	{
 		qDebug() << "TransformPixRGB2LAB(): Error - invalid arguments";
 		return;
 	}
 
-	m_pixels[t_width][t_height]->TransformRGB2LAB();
+	const unsigned char *red = m_planes.GetBytePlane(BytePlane::RED);
+	const unsigned char *green = m_planes.GetBytePlane(BytePlane::GREEN);
+	const unsigned char *blue = m_planes.GetBytePlane(BytePlane::BLUE);
+
+	double chL = 0.0;
+	double chA = 0.0;
+	double chB = 0.0;
+
+	RGBLAB transformer;
+	transformer.RGB2LAB(red[t_index],
+						green[t_index],
+						blue[t_index],
+						chL,
+						chA,
+						chB);
+
+	m_planes.GetPlane(Plane::LUM)[t_index] = chL;
+	m_planes.GetPlane(Plane::CH_A)[t_index] = chA;
+	m_planes.GetPlane(Plane::CH_B)[t_index] = chB;
 }
 
 // Transform all image pixels from LAB color space to RGB
@@ -88,29 +116,156 @@ void ImagePixels::TransformPixRGB2LAB(const unsigned int &t_width, const unsigne
 // @output:
 void ImagePixels::TransAllPixLAB2RGB()
 {
-	for ( unsigned int width = 0; width < m_width; width++ )
+	if ( true == m_planes.IsEmpty() )
 	{
-		for ( unsigned int height = 0; height < m_height; height++ )
-		{
-			TransformPixLAB2RGB(width, height);
-		}
+		return;
 	}
+
+	TransformPixelsLAB2RGB(0, m_planes.GetPixelsNum());
 }
 
 // Transform certain pixel from LAB color space to RGB
 // @input:
-// - unsigned int - exist width (x) position of pixel
-// - unsigned int - exist height (y) position of pixel
+// - unsigned int - exist index of pixel
 // @output:
-void ImagePixels::TransformPixLAB2RGB(const unsigned int &t_width, const unsigned int &t_height)
+void ImagePixels::TransformPixLAB2RGB(const unsigned int &t_index)
 {
-	if ( false == IsPixelExist(t_width, t_height) )
+	if ( m_planes.GetPixelsNum() <= t_index )
 	{
 		qDebug() << "TransformPixLAB2RGB(): Error - invalid arguments";
 		return;
 	}
 
-	m_pixels[t_width][t_height]->TransformLAB2RGB();
+	RGBLAB transformer;
+	transformer.LAB2RGB(m_planes.GetPlane(Plane::LUM)[t_index],
+						m_planes.GetPlane(Plane::CH_A)[t_index],
+						m_planes.GetPlane(Plane::CH_B)[t_index],
+						m_planes.GetBytePlane(BytePlane::RED)[t_index],
+						m_planes.GetBytePlane(BytePlane::GREEN)[t_index],
+						m_planes.GetBytePlane(BytePlane::BLUE)[t_index]);
+}
+
+// Transform sequence of pixels from RGB color space to LAB
+// @input:
+// - unsigned int - exist index of the first pixel
+// - unsigned int - number of pixels (pixels with indexes out of image are not transformed)
+// @output:
+void ImagePixels::TransformPixelsRGB2LAB(const unsigned int &t_firstIndex, const unsigned int &t_count)
+{
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	if ( pixelsNum <= t_firstIndex )
+	{
+		qDebug() << "TransformPixelsRGB2LAB(): Error - invalid arguments";
+		return;
+	}
+
+	unsigned int count = t_count;
+	if ( pixelsNum - t_firstIndex < count )
+	{
+		count = pixelsNum - t_firstIndex;
+	}
+
+	const unsigned char *red = m_planes.GetBytePlane(BytePlane::RED) + t_firstIndex;
+	const unsigned char *green = m_planes.GetBytePlane(BytePlane::GREEN) + t_firstIndex;
+	const unsigned char *blue = m_planes.GetBytePlane(BytePlane::BLUE) + t_firstIndex;
+	PlaneValue *lum = m_planes.GetPlane(Plane::LUM) + t_firstIndex;
+	PlaneValue *chA = m_planes.GetPlane(Plane::CH_A) + t_firstIndex;
+	PlaneValue *chB = m_planes.GetPlane(Plane::CH_B) + t_firstIndex;
+
+	RGBLAB transformer;
+
+#ifdef PLANE_PRECISION_DOUBLE
+	transformer.RGB2LABRow(red, green, blue, lum, chA, chB, count);
+#else
+	// Transform functions work with double values, so pixels are transformed by chunks through buffers
+	double lumBuffer[PLANE_CHUNK_SIZE];
+	double chABuffer[PLANE_CHUNK_SIZE];
+	double chBBuffer[PLANE_CHUNK_SIZE];
+	for ( unsigned int start = 0; start < count; start += PLANE_CHUNK_SIZE )
+	{
+		unsigned int chunkSize = count - start;
+		if ( PLANE_CHUNK_SIZE < chunkSize )
+		{
+			chunkSize = PLANE_CHUNK_SIZE;
+		}
+
+		transformer.RGB2LABRow(red + start,
+							   green + start,
+							   blue + start,
+							   lumBuffer,
+							   chABuffer,
+							   chBBuffer,
+							   chunkSize);
+
+		for ( unsigned int pix = 0; pix < chunkSize; pix++ )
+		{
+			lum[start + pix] = lumBuffer[pix];
+			chA[start + pix] = chABuffer[pix];
+			chB[start + pix] = chBBuffer[pix];
+		}
+	}
+#endif
+}
+
+// Transform sequence of pixels from LAB color space to RGB
+// @input:
+// - unsigned int - exist index of the first pixel
+// - unsigned int - number of pixels (pixels with indexes out of image are not transformed)
+// @output:
+void ImagePixels::TransformPixelsLAB2RGB(const unsigned int &t_firstIndex, const unsigned int &t_count)
+{
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	if ( pixelsNum <= t_firstIndex )
+	{
+		qDebug() << "TransformPixelsLAB2RGB(): Error - invalid arguments";
+		return;
+	}
+
+	unsigned int count = t_count;
+	if ( pixelsNum - t_firstIndex < count )
+	{
+		count = pixelsNum - t_firstIndex;
+	}
+
+	const PlaneValue *lum = m_planes.GetPlane(Plane::LUM) + t_firstIndex;
+	const PlaneValue *chA = m_planes.GetPlane(Plane::CH_A) + t_firstIndex;
+	const PlaneValue *chB = m_planes.GetPlane(Plane::CH_B) + t_firstIndex;
+	unsigned char *red = m_planes.GetBytePlane(BytePlane::RED) + t_firstIndex;
+	unsigned char *green = m_planes.GetBytePlane(BytePlane::GREEN) + t_firstIndex;
+	unsigned char *blue = m_planes.GetBytePlane(BytePlane::BLUE) + t_firstIndex;
+
+	RGBLAB transformer;
+
+#ifdef PLANE_PRECISION_DOUBLE
+	transformer.LAB2RGBRow(lum, chA, chB, red, green, blue, count);
+#else
+	double lumBuffer[PLANE_CHUNK_SIZE];
+	double chABuffer[PLANE_CHUNK_SIZE];
+	double chBBuffer[PLANE_CHUNK_SIZE];
+	for ( unsigned int start = 0; start < count; start += PLANE_CHUNK_SIZE )
+	{
+		unsigned int chunkSize = count - start;
+		if ( PLANE_CHUNK_SIZE < chunkSize )
+		{
+			chunkSize = PLANE_CHUNK_SIZE;
+		}
+
+		for ( unsigned int pix = 0; pix < chunkSize; pix++ )
+		{
+			lumBuffer[pix] = lum[start + pix];
+			chABuffer[pix] = chA[start + pix];
+			chBBuffer[pix] = chB[start + pix];
+		}
+
+		transformer.LAB2RGBRow(lumBuffer,
+							   chABuffer,
+							   chBBuffer,
+							   red + start,
+							   green + start,
+							   blue + start,
+							   chunkSize);
+	}
+#endif
 }
 
 // Check if we have pixel with such coords
@@ -130,6 +285,17 @@ bool ImagePixels::IsPixelExist(const unsigned int &t_width, const unsigned int &
 	return true;
 }
 
+// Get index of pixel with certain coords in planes
+// @input:
+// - unsigned int - exist width (x) position of pixel
+// - unsigned int - exist height (y) position of pixel
+// @output:
+// - unsigned int - index of pixel
+unsigned int ImagePixels::PixIndex(const unsigned int &t_width, const unsigned int &t_height) const
+{
+	return t_height * m_width + t_width;
+}
+
 // Check if we have pixels of image
 // @input:
 // @output:
@@ -139,7 +305,7 @@ bool ImagePixels::HasPixels() const
 {
 	if ( (0 == m_width) ||
 		 (0 == m_height) ||
-		 (true == m_pixels.isEmpty()) )
+		 (true == m_planes.IsEmpty()) )
 	{
 		return false;
 	}
@@ -162,7 +328,7 @@ double ImagePixels::GetPixChLum(const unsigned int &t_width, const unsigned int
 		return NO_INFO;
 	}
 
-	return m_pixels[t_width][t_height]->GetChL();
+	return m_planes.GetPlane(Plane::LUM)[ PixIndex(t_width, t_height) ];
 }
 
 // Get value of channel A of pixel with certain coords
@@ -180,7 +346,7 @@ double ImagePixels::GetPixChA(const unsigned int &t_width, const unsigned int &t
 		return NO_INFO;
 	}
 
-	return m_pixels[t_width][t_height]->GetChA();
+	return m_planes.GetPlane(Plane::CH_A)[ PixIndex(t_width, t_height) ];
 }
 
 // Get value of channel B of pixel with certain coords
@@ -198,7 +364,7 @@ double ImagePixels::GetPixChB(const unsigned int &t_width, const unsigned int &t
 		return NO_INFO;
 	}
 
-	return m_pixels[t_width][t_height]->GetChB();
+	return m_planes.GetPlane(Plane::CH_B)[ PixIndex(t_width, t_height) ];
 }
 
 // Set value for channels A and B of pixel with certain coords
@@ -219,8 +385,9 @@ void ImagePixels::SetPixChannelsAB(const unsigned int &t_width,
 		return;
 	}
 
-	m_pixels[t_width][t_height]->SetChA(t_chA);
-	m_pixels[t_width][t_height]->SetChB(t_chB);
+	const unsigned int index = PixIndex(t_width, t_height);
+	m_planes.GetPlane(Plane::CH_A)[index] = t_chA;
+	m_planes.GetPlane(Plane::CH_B)[index] = t_chB;
 }
 
 // Check if pixel with certain coords is greyscale
@@ -238,5 +405,35 @@ bool ImagePixels::IsPixGrey(const unsigned int &t_width, const unsigned int &t_h
 		return false;
 	}
 
-	return m_pixels[t_width][t_height]->IsGrey();
+	const unsigned int index = PixIndex(t_width, t_height);
+	const unsigned char red = m_planes.GetBytePlane(BytePlane::RED)[index];
+	if ( (red == m_planes.GetBytePlane(BytePlane::GREEN)[index]) &&
+		 (red == m_planes.GetBytePlane(BytePlane::BLUE)[index]) )
+	{
+		return true;
+	}
+
+	return false;
+}
+
+// Get plane of certain pixels characteristic (values of pixels saved row by row)
+// @input:
+// - Plane::Type - exist type of plane
+// @output:
+// - NULL - image has no pixels
+// - const PlaneValue * - pointer to the first value of plane (width * height values)
+const PlaneValue *ImagePixels::GetPlane(const Plane::Type &t_type) const
+{
+	return m_planes.GetPlane(t_type);
+}
+
+// Get plane of certain pixels byte values (values of pixels saved row by row)
+// @input:
+// - BytePlane::Type - exist type of plane
+// @output:
+// - NULL - image has no pixels
+// - const unsigned char * - pointer to the first value of plane (width * height values)
+const unsigned char *ImagePixels::GetBytePlane(const BytePlane::Type &t_type) const
+{
+	return m_planes.GetBytePlane(t_type);
 }
@@ -19,11 +19,11 @@
 #ifndef IMAGEPIXELS_H
 #define IMAGEPIXELS_H
 
-#include <QList>
 #include <QImage>
 #include <QDebug>
 
-#include "pixel.h"
+#include "pixelplanes.h"
+#include "COLOR_SPACE/rgblab.h"
 #include "./DEFINES/pixels.h"
 
 class ImagePixels
@@ -32,7 +32,7 @@ class ImagePixels
 protected:
 	unsigned int m_width;
 	unsigned int m_height;
-	QList< QList<Pixel *> > m_pixels;
+	PixelPlanes m_planes;
 
 	// == METHODS ==
 public:
@@ -56,21 +56,33 @@ public:
 	// Get value of channel B of pixel with certain coords
 	double GetPixChB(const unsigned int &t_width, const unsigned int &t_height) const;
 	// Set value for channels A and B of pixel with certain coords
-	void SetPixChannelsAB(const unsigned int &t_width,
-						  const unsigned int &t_height,
-						  const double &t_chA,
-						  const double &t_chB);
+	virtual void SetPixChannelsAB(const unsigned int &t_width,
+								  const unsigned int &t_height,
+								  const double &t_chA,
+								  const double &t_chB);
 
 	// Check if pixel with certain coords is greyscale
 	bool IsPixGrey(const unsigned int &t_width, const unsigned int &t_height) const;
+	// Get plane of certain pixels characteristic (values of pixels saved row by row)
+	const PlaneValue *GetPlane(const Plane::Type &t_type) const;
+	// Get plane of certain pixels byte values (values of pixels saved row by row)
+	const unsigned char *GetBytePlane(const BytePlane::Type &t_type) const;
 
 protected:
 	// Check if we have pixel with such coords
 	bool IsPixelExist(const unsigned int &t_width, const unsigned int &t_height) const;
+	// Get index of pixel with certain coords in planes
+	unsigned int PixIndex(const unsigned int &t_width, const unsigned int &t_height) const;
+	// Allocate planes for pixels of image with certain size
+	bool AllocatePixels(const unsigned int &t_width, const unsigned int &t_height);
 	// Transform certain pixel from RGB color space to LAB
-	void TransformPixRGB2LAB(const unsigned int &t_width, const unsigned int &t_height);
+	void TransformPixRGB2LAB(const unsigned int &t_index);
 	// Transform certain pixel from LAB color space to RGB
-	void TransformPixLAB2RGB(const unsigned int &t_width, const unsigned int &t_height);
+	void TransformPixLAB2RGB(const unsigned int &t_index);
+	// Transform sequence of pixels from RGB color space to LAB
+	void TransformPixelsRGB2LAB(const unsigned int &t_firstIndex, const unsigned int &t_count);
+	// Transform sequence of pixels from LAB color space to RGB
+	void TransformPixelsLAB2RGB(const unsigned int &t_firstIndex, const unsigned int &t_count);
 };
 
 #endif // IMAGEPIXELS_H
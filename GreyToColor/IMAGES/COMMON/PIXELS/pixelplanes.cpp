@@ -0,0 +1,431 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pixelplanes.h"
+
+PixelPlanes::PixelPlanes()
+{
+	m_width = 0;
+	m_height = 0;
+	m_block = NULL;
+	m_blockSize = 0;
+
+	for ( int plane = 0; plane < Plane::DEFAULT_LAST; plane++ )
+	{
+		m_planes[plane] = NULL;
+		m_planeBlocks[plane] = NULL;
+		m_planeBlockSizes[plane] = 0;
+	}
+
+	for ( int plane = 0; plane < BytePlane::DEFAULT_LAST; plane++ )
+	{
+		m_bytePlanes[plane] = NULL;
+	}
+}
+
+PixelPlanes::~PixelPlanes()
+{
+	Release();
+}
+
+// Allocate planes for image with certain size and set values of pixels to defaults
+// @input:
+// - unsigned int - positive width of image
+// - unsigned int - positive height of image
+// @output:
+// - true - planes allocated
+// - false - failed to allocate planes
+bool PixelPlanes::Allocate(const unsigned int &t_width, const unsigned int &t_height)
+{
+	Clear();
+
+	if ( (0 == t_width) || (0 == t_height) )
+	{
+		qDebug() << "Allocate(): Error - invalid arguments";
+		return false;
+	}
+
+	const size_t pixelsNum = (size_t)t_width * (size_t)t_height;
+	const size_t planeSize = AlignedSize(pixelsNum * sizeof(PlaneValue));
+	const size_t bytePlaneSize = AlignedSize(pixelsNum);
+	int blockPlanesNum = 0;
+	for ( int plane = 0; plane < Plane::DEFAULT_LAST; plane++ )
+	{
+		if ( false == IsOnDemandPlane((Plane::Type)plane) )
+		{
+			++blockPlanesNum;
+		}
+	}
+
+	const size_t requiredSize = planeSize * blockPlanesNum + bytePlaneSize * BytePlane::DEFAULT_LAST;
+
+	// Reuse memory block of previous image if it's big enough
+	if ( m_blockSize < requiredSize )
+	{
+		Release();
+
+		m_block = (unsigned char *)qMallocAligned(requiredSize, PLANE_ALIGNMENT);
+		if ( NULL == m_block )
+		{
+			qDebug() << "Allocate(): Error - not enough memory for image" << t_width << t_height;
+			return false;
+		}
+
+		m_blockSize = requiredSize;
+	}
+
+	unsigned char *planeStart = m_block;
+	for ( int plane = 0; plane < Plane::DEFAULT_LAST; plane++ )
+	{
+		if ( true == IsOnDemandPlane((Plane::Type)plane) )
+		{
+			continue;
+		}
+
+		m_planes[plane] = (PlaneValue *)planeStart;
+		planeStart += planeSize;
+	}
+
+	for ( int plane = 0; plane < BytePlane::DEFAULT_LAST; plane++ )
+	{
+		m_bytePlanes[plane] = planeStart;
+		planeStart += bytePlaneSize;
+	}
+
+	m_width = t_width;
+	m_height = t_height;
+
+	// Default values are the same as default values of ColorPixel
+	for ( int plane = 0; plane < Plane::DEFAULT_LAST; plane++ )
+	{
+		FillPlane((Plane::Type)plane, RELATIVE_MIN);
+	}
+
+	FillPlane(Plane::REL_LUM, ERROR);
+
+	for ( int plane = 0; plane < BytePlane::DEFAULT_LAST; plane++ )
+	{
+		FillBytePlane((BytePlane::Type)plane, 0);
+	}
+
+	return true;
+}
+
+// Forget about all planes (memory block is kept for next image)
+// @input:
+// @output:
+void PixelPlanes::Clear()
+{
+	for ( int plane = 0; plane < Plane::DEFAULT_LAST; plane++ )
+	{
+		m_planes[plane] = NULL;
+	}
+
+	for ( int plane = 0; plane < BytePlane::DEFAULT_LAST; plane++ )
+	{
+		m_bytePlanes[plane] = NULL;
+	}
+
+	m_width = 0;
+	m_height = 0;
+}
+
+// Free memory of all planes
+// @input:
+// @output:
+void PixelPlanes::Release()
+{
+	Clear();
+
+	if ( NULL != m_block )
+	{
+		qFreeAligned(m_block);
+		m_block = NULL;
+	}
+
+	m_blockSize = 0;
+
+	for ( int plane = 0; plane < Plane::DEFAULT_LAST; plane++ )
+	{
+		if ( NULL != m_planeBlocks[plane] )
+		{
+			qFreeAligned(m_planeBlocks[plane]);
+			m_planeBlocks[plane] = NULL;
+		}
+
+		m_planeBlockSizes[plane] = 0;
+	}
+}
+
+// Allocate plane, which is allocated on demand, and set its values to default
+// @input:
+// - Plane::Type - exist type of plane
+// @output:
+// - true - plane allocated (or it was already allocated)
+// - false - planes of image are not allocated or not enough memory
+bool PixelPlanes::AllocatePlane(const Plane::Type &t_type)
+{
+	if ( (t_type < Plane::LUM) || (Plane::DEFAULT_LAST <= t_type) || (true == IsEmpty()) )
+	{
+		qDebug() << "AllocatePlane(): Error - invalid arguments";
+		return false;
+	}
+
+	if ( NULL != m_planes[t_type] )
+	{
+		return true;
+	}
+
+	const size_t requiredSize = AlignedSize((size_t)GetPixelsNum() * sizeof(PlaneValue));
+	if ( m_planeBlockSizes[t_type] < requiredSize )
+	{
+		if ( NULL != m_planeBlocks[t_type] )
+		{
+			qFreeAligned(m_planeBlocks[t_type]);
+			m_planeBlocks[t_type] = NULL;
+			m_planeBlockSizes[t_type] = 0;
+		}
+
+		m_planeBlocks[t_type] = (unsigned char *)qMallocAligned(requiredSize, PLANE_ALIGNMENT);
+		if ( NULL == m_planeBlocks[t_type] )
+		{
+			qDebug() << "AllocatePlane(): Error - not enough memory for plane" << t_type;
+			return false;
+		}
+
+		m_planeBlockSizes[t_type] = requiredSize;
+	}
+
+	m_planes[t_type] = (PlaneValue *)m_planeBlocks[t_type];
+
+	// Default value is the same as in Allocate()
+	FillPlane(t_type, RELATIVE_MIN);
+
+	return true;
+}
+
+// Check if plane is allocated
+// @input:
+// - Plane::Type - exist type of plane
+// @output:
+// - true - plane could be used
+// - false - plane is not allocated
+bool PixelPlanes::HasPlane(const Plane::Type &t_type) const
+{
+	if ( (t_type < Plane::LUM) || (Plane::DEFAULT_LAST <= t_type) )
+	{
+		qDebug() << "HasPlane(): Error - invalid arguments";
+		return false;
+	}
+
+	if ( NULL == m_planes[t_type] )
+	{
+		return false;
+	}
+
+	return true;
+}
+
+// Check if plane is allocated on demand (not in common memory block)
+// @input:
+// - Plane::Type - exist type of plane
+// @output:
+// - true - plane is allocated by AllocatePlane()
+// - false - plane is allocated with all planes by Allocate()
+bool PixelPlanes::IsOnDemandPlane(const Plane::Type &t_type) const
+{
+	switch(t_type)
+	{
+		case Plane::LUM:
+		case Plane::CH_A:
+		case Plane::CH_B:
+		case Plane::REL_LUM:
+			return false;
+
+		case Plane::SKO:
+		case Plane::ENTROPY:
+		case Plane::SKEWNESS:
+		case Plane::KURTOSIS:
+			return true;
+
+		case Plane::DEFAULT_LAST:
+		default:
+		{
+			qDebug() << "IsOnDemandPlane(): Error - invalid plane type";
+			return false;
+		}
+	}
+
+	return false;
+}
+
+// Get size of memory for plane with certain size in bytes (planes start at aligned addresses)
+// @input:
+// - size_t - size of plane in bytes
+// @output:
+// - size_t - size of plane rounded up to PLANE_ALIGNMENT
+size_t PixelPlanes::AlignedSize(const size_t &t_bytes) const
+{
+	return ( (t_bytes + PLANE_ALIGNMENT - 1) / PLANE_ALIGNMENT ) * PLANE_ALIGNMENT;
+}
+
+// Check if planes are allocated
+// @input:
+// @output:
+// - true - planes are not allocated
+// - false - planes allocated
+bool PixelPlanes::IsEmpty() const
+{
+	if ( (0 == m_width) || (0 == m_height) )
+	{
+		return true;
+	}
+
+	return false;
+}
+
+// Get width of planes
+// @input:
+// @output:
+// - unsigned int - width of planes (zero if planes are not allocated)
+unsigned int PixelPlanes::GetWidth() const
+{
+	return m_width;
+}
+
+// Get height of planes
+// @input:
+// @output:
+// - unsigned int - height of planes (zero if planes are not allocated)
+unsigned int PixelPlanes::GetHeight() const
+{
+	return m_height;
+}
+
+// Get number of pixels in each plane
+// @input:
+// @output:
+// - unsigned int - number of pixels
+unsigned int PixelPlanes::GetPixelsNum() const
+{
+	return m_width * m_height;
+}
+
+// Get plane of certain pixels characteristic
+// @input:
+// - Plane::Type - exist type of plane
+// @output:
+// - NULL - planes are not allocated
+// - PlaneValue * - pointer to the first value of the plane
+PlaneValue *PixelPlanes::GetPlane(const Plane::Type &t_type)
+{
+	if ( (t_type < Plane::LUM) || (Plane::DEFAULT_LAST <= t_type) )
+	{
+		qDebug() << "GetPlane(): Error - invalid arguments";
+		return NULL;
+	}
+
+	return m_planes[t_type];
+}
+
+// Get plane of certain pixels characteristic
+// @input:
+// - Plane::Type - exist type of plane
+// @output:
+// - NULL - planes are not allocated
+// - const PlaneValue * - pointer to the first value of the plane
+const PlaneValue *PixelPlanes::GetPlane(const Plane::Type &t_type) const
+{
+	if ( (t_type < Plane::LUM) || (Plane::DEFAULT_LAST <= t_type) )
+	{
+		qDebug() << "GetPlane(): Error - invalid arguments";
+		return NULL;
+	}
+
+	return m_planes[t_type];
+}
+
+// Get plane of certain pixels byte values
+// @input:
+// - BytePlane::Type - exist type of plane
+// @output:
+// - NULL - planes are not allocated
+// - unsigned char * - pointer to the first value of the plane
+unsigned char *PixelPlanes::GetBytePlane(const BytePlane::Type &t_type)
+{
+	if ( (t_type < BytePlane::RED) || (BytePlane::DEFAULT_LAST <= t_type) )
+	{
+		qDebug() << "GetBytePlane(): Error - invalid arguments";
+		return NULL;
+	}
+
+	return m_bytePlanes[t_type];
+}
+
+// Get plane of certain pixels byte values
+// @input:
+// - BytePlane::Type - exist type of plane
+// @output:
+// - NULL - planes are not allocated
+// - const unsigned char * - pointer to the first value of the plane
+const unsigned char *PixelPlanes::GetBytePlane(const BytePlane::Type &t_type) const
+{
+	if ( (t_type < BytePlane::RED) || (BytePlane::DEFAULT_LAST <= t_type) )
+	{
+		qDebug() << "GetBytePlane(): Error - invalid arguments";
+		return NULL;
+	}
+
+	return m_bytePlanes[t_type];
+}
+
+// Set all values of plane to certain value
+// @input:
+// - Plane::Type - exist type of plane
+// - double - new value for all pixels
+// @output:
+void PixelPlanes::FillPlane(const Plane::Type &t_type, const double &t_value)
+{
+	PlaneValue *plane = GetPlane(t_type);
+	if ( NULL == plane )
+	{
+		return;
+	}
+
+	const unsigned int pixelsNum = GetPixelsNum();
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
+	{
+		plane[pix] = t_value;
+	}
+}
+
+// Set all values of byte plane to certain value
+// @input:
+// - BytePlane::Type - exist type of plane
+// - unsigned char - new value for all pixels
+// @output:
+void PixelPlanes::FillBytePlane(const BytePlane::Type &t_type, const unsigned char &t_value)
+{
+	unsigned char *plane = GetBytePlane(t_type);
+	if ( NULL == plane )
+	{
+		return;
+	}
+
+	memset(plane, t_value, GetPixelsNum());
+}
@@ -0,0 +1,96 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELPLANES_H
+#define PIXELPLANES_H
+
+#include <string.h>
+#include <QtGlobal>
+#include <QDebug>
+
+#include "./DEFINES/global.h"
+#include "./DEFINES/pixels.h"
+#include "planevalue.h"
+
+// Storage of pixels of image. Each channel (characteristic) of pixels saved in it's own contiguous aligned plane.
+// Pixels in plane are saved row by row (as in QImage), so pixel (x, y) has index y * width + x.
+// All planes are placed in one memory block. Block is not freed on Clear(), so it could be reused for next image
+// of the same (or smaller) size without new allocation.
+// Planes of features (SKO, entropy, ...) are needed only by some colorization methods, so they are not in the
+// block: each of them is allocated by AllocatePlane() when it's needed for the first time (and also kept for
+// next images).
+class PixelPlanes
+{
+	// == DATA ==
+private:
+	unsigned int m_width;
+	unsigned int m_height;
+	unsigned char *m_block;
+	size_t m_blockSize;
+	PlaneValue *m_planes[Plane::DEFAULT_LAST];
+	// Memory of planes allocated on demand
+	unsigned char *m_planeBlocks[Plane::DEFAULT_LAST];
+	size_t m_planeBlockSizes[Plane::DEFAULT_LAST];
+	unsigned char *m_bytePlanes[BytePlane::DEFAULT_LAST];
+
+	// == METHODS ==
+public:
+	PixelPlanes();
+	~PixelPlanes();
+
+	// Allocate planes for image with certain size and set values of pixels to defaults
+	bool Allocate(const unsigned int &t_width, const unsigned int &t_height);
+	// Forget about all planes (memory block is kept for next image)
+	void Clear();
+	// Free memory of all planes
+	void Release();
+	// Check if planes are allocated
+	bool IsEmpty() const;
+	// Get width of planes
+	unsigned int GetWidth() const;
+	// Get height of planes
+	unsigned int GetHeight() const;
+	// Get number of pixels in each plane
+	unsigned int GetPixelsNum() const;
+	// Allocate plane, which is allocated on demand, and set its values to default
+	bool AllocatePlane(const Plane::Type &t_type);
+	// Check if plane is allocated
+	bool HasPlane(const Plane::Type &t_type) const;
+	// Get plane of certain pixels characteristic
+	PlaneValue *GetPlane(const Plane::Type &t_type);
+	const PlaneValue *GetPlane(const Plane::Type &t_type) const;
+	// Get plane of certain pixels byte values
+	unsigned char *GetBytePlane(const BytePlane::Type &t_type);
+	const unsigned char *GetBytePlane(const BytePlane::Type &t_type) const;
+	// Set all values of plane to certain value
+	void FillPlane(const Plane::Type &t_type, const double &t_value);
+	// Set all values of byte plane to certain value
+	void FillBytePlane(const BytePlane::Type &t_type, const unsigned char &t_value);
+
+private:
+	// Check if plane is allocated on demand (not in common memory block)
+	bool IsOnDemandPlane(const Plane::Type &t_type) const;
+	// Get size of memory for plane with certain size in bytes (planes start at aligned addresses)
+	size_t AlignedSize(const size_t &t_bytes) const;
+
+	// Planes should not be copied
+	PixelPlanes(const PixelPlanes &t_other);
+	PixelPlanes &operator=(const PixelPlanes &t_other);
+};
+
+#endif // PIXELPLANES_H
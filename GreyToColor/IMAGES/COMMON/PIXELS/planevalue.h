@@ -0,0 +1,84 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PLANEVALUE_H
+#define PLANEVALUE_H
+
+#include "./DEFINES/pixels.h"
+
+// Precision of values in planes of pixels is chosen at compile time (see GreyToColor.pro):
+// - by default values are saved as double;
+// - PLANE_PRECISION_FLOAT - values are saved as float (half of memory);
+// - PLANE_PRECISION_FIXED16 - values are saved as 16-bit fixed point numbers (quarter of memory).
+// Code that reads and writes planes should use type PlaneValue.
+
+// Class Fixed16
+// 16-bit signed fixed point number with FIXED16_SCALE steps for 1.0. It could be used as double: it's
+// constructed from double (with rounding and saturation) and converted to double implicitly.
+// Functions are defined here, because they are called for each pixel in all search loops.
+class Fixed16
+{
+	// == DATA ==
+private:
+	short m_value;
+
+	// == METHODS ==
+public:
+	Fixed16()
+	{
+		m_value = 0;
+	}
+
+	Fixed16(const double &t_value)
+	{
+		double scaled = t_value * FIXED16_SCALE;
+		if ( scaled < FIXED16_MIN )
+		{
+			scaled = FIXED16_MIN;
+		}
+		else if ( FIXED16_MAX < scaled )
+		{
+			scaled = FIXED16_MAX;
+		}
+
+		if ( scaled < 0 )
+		{
+			m_value = (short)(scaled - 0.5);
+		}
+		else
+		{
+			m_value = (short)(scaled + 0.5);
+		}
+	}
+
+	operator double() const
+	{
+		return (double)m_value / FIXED16_SCALE;
+	}
+};
+
+#if defined(PLANE_PRECISION_FLOAT)
+typedef float PlaneValue;
+#elif defined(PLANE_PRECISION_FIXED16)
+typedef Fixed16 PlaneValue;
+#else
+#define PLANE_PRECISION_DOUBLE
+typedef double PlaneValue;
+#endif
+
+#endif // PLANEVALUE_H
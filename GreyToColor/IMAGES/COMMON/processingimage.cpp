@@ -234,6 +234,28 @@ bool ProcessingImage::IsPixelGrey(const unsigned int &t_width, const unsigned in
 	return m_imgPixels->IsPixGrey(t_width, t_height);
 }
 
+// Get plane of certain pixels characteristic (value of pixel (x, y) has index y * width + x)
+// @input:
+// - Plane::Type - exist type of plane
+// @output:
+// - NULL - image has no pixels
+// - const PlaneValue * - pointer to plane with width * height values
+const PlaneValue *ProcessingImage::GetPixelsPlane(const Plane::Type &t_type) const
+{
+	return m_imgPixels->GetPlane(t_type);
+}
+
+// Get plane of certain pixels byte values (value of pixel (x, y) has index y * width + x)
+// @input:
+// - BytePlane::Type - exist type of plane
+// @output:
+// - NULL - image has no pixels
+// - const unsigned char * - pointer to plane with width * height values
+const unsigned char *ProcessingImage::GetPixelsBytePlane(const BytePlane::Type &t_type) const
+{
+	return m_imgPixels->GetBytePlane(t_type);
+}
+
 // Add image similiarity area
 // @input:
 // - ImgSimilarityArea - valid image similarity area
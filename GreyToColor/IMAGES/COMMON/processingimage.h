@@ -77,6 +77,10 @@ public:
 
 	// Check if pixel with certain coords is greyscale
 	bool IsPixelGrey(const unsigned int &t_width, const unsigned int &t_height) const;
+	// Get plane of certain pixels characteristic (value of pixel (x, y) has index y * width + x)
+	const PlaneValue *GetPixelsPlane(const Plane::Type &t_type) const;
+	// Get plane of certain pixels byte values (value of pixel (x, y) has index y * width + x)
+	const unsigned char *GetPixelsBytePlane(const BytePlane::Type &t_type) const;
 	// Add image similiarity area
 	bool AddSimilarityArea(const ImgSimilarityArea &t_area);
 	// Find image similarity area by ID
@@ -49,7 +49,7 @@ void ColorPixel::CalcRelativeLum()
 {
 	m_relativeLum = GetChL() / LAB_MAX_LUM;
 
-	if ( (NAN == m_relativeLum) || (m_relativeLum < RELATIVE_MIN) )
+	if ( (true == qIsNaN(m_relativeLum)) || (m_relativeLum < RELATIVE_MIN) )
 	{
 		m_relativeLum = RELATIVE_MIN;
 	}
@@ -75,7 +75,7 @@ bool ColorPixel::SetRelativeLum(const double &t_lum)
 {
 	if ( (t_lum < RELATIVE_MIN) ||
 		 (RELATIVE_MAX < t_lum) ||
-		 (NAN == t_lum) )
+		 (true == qIsNaN(t_lum)) )
 	{
 		qDebug() << "SetRelativeLum(): Error - invalid arguments, t_lum =" << t_lum;
 		qDebug() << "Realtive lumiance not accepted";
@@ -20,6 +20,7 @@
 #define COLORPIXEL_H
 
 #include <QDebug>
+#include <qnumeric.h>
 
 #include "../../COMMON/PIXELS/pixel.h"
 #include "./DEFINES/pixels.h"
@@ -0,0 +1,63 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "featuresbandtask.h"
+#include "sourceimgpixels.h"
+
+FeaturesBandTask::FeaturesBandTask(SourceImgPixels *t_pixels,
+								   const unsigned int &t_firstRow,
+								   const unsigned int &t_lastRow,
+								   const bool &t_sko,
+								   const bool &t_entropy,
+								   const bool &t_skewAndKurt)
+{
+	m_pixels = t_pixels;
+	m_firstRow = t_firstRow;
+	m_lastRow = t_lastRow;
+	m_sko = t_sko;
+	m_entropy = t_entropy;
+	m_skewAndKurt = t_skewAndKurt;
+	m_done = false;
+
+	// Results of task are checked after thread pool finished all tasks
+	setAutoDelete(false);
+}
+
+// Calc features of band
+// @input:
+// @output:
+void FeaturesBandTask::run()
+{
+	if ( NULL == m_pixels )
+	{
+		qDebug() << "run(): Error - invalid arguments";
+		return;
+	}
+
+	m_done = m_pixels->CalcBandFeatures(m_firstRow, m_lastRow, m_sko, m_entropy, m_skewAndKurt);
+}
+
+// Check if features of band were calculated
+// @input:
+// @output:
+// - true - features of band calculated
+// - false - task was not run or failed
+bool FeaturesBandTask::IsDone() const
+{
+	return m_done;
+}
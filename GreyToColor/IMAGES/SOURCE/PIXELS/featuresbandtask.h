@@ -0,0 +1,57 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FEATURESBANDTASK_H
+#define FEATURESBANDTASK_H
+
+#include <QRunnable>
+#include <QDebug>
+
+class SourceImgPixels;
+
+// Class FeaturesBandTask
+// Task for thread pool: calc features of pixels of one band of rows of image (see
+// SourceImgPixels::CalcPixelsFeatures()). Bands don't overlap, so tasks could run at the same time.
+class FeaturesBandTask : public QRunnable
+{
+	// == DATA ==
+private:
+	SourceImgPixels *m_pixels;
+	unsigned int m_firstRow;
+	unsigned int m_lastRow;
+	bool m_sko;
+	bool m_entropy;
+	bool m_skewAndKurt;
+	bool m_done;
+
+	// == METHODS ==
+public:
+	FeaturesBandTask(SourceImgPixels *t_pixels,
+					 const unsigned int &t_firstRow,
+					 const unsigned int &t_lastRow,
+					 const bool &t_sko,
+					 const bool &t_entropy,
+					 const bool &t_skewAndKurt);
+
+	// Calc features of band
+	virtual void run();
+	// Check if features of band were calculated
+	bool IsDone() const;
+};
+
+#endif // FEATURESBANDTASK_H
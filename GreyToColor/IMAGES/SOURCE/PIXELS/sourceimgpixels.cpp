@@ -19,9 +19,15 @@
 #include "sourceimgpixels.h"
 #include "./SERVICE/IMAGES/imghistogram.h"
 
+int SourceImgPixels::s_threadsNum = 0;
+
 SourceImgPixels::SourceImgPixels()
 {
+	m_featureMaskSides[Feature::SKO] = SKO_MASK_RECT_SIDE;
+	m_featureMaskSides[Feature::ENTROPY] = ENTROPY_MASK_RECT_SIDE;
+	m_featureMaskSides[Feature::SKEW_AND_KURT] = ENTROPY_MASK_RECT_SIDE;
 
+	ResetFeatures();
 }
 
 SourceImgPixels::~SourceImgPixels()
@@ -34,115 +40,945 @@ SourceImgPixels::~SourceImgPixels()
 // @output:
 void SourceImgPixels::Clear()
 {
-	const int pixWidth = m_pixels.size();
-	for ( int width = pixWidth - 1; width >= 0; --width )
+	ImagePixels::Clear();
+	ResetFeatures();
+}
+
+// Save all pixels from input QImage as custom pixels
+// @input:
+// - QImage - unnull image
+// @output:
+bool SourceImgPixels::FormImgPixels(const QImage &t_img)
+{
+	if ( true == t_img.isNull() )
+	{
+		qDebug() << "FormImgPixels(): Error - invalid arguments";
+		return false;
+	}
+
+	// Each row of image in 32-bit format is a row of QRgb values, so we could read pixels directly from
+	// image memory. Images in other formats are converted once.
+	QImage rgbImg = t_img;
+	if ( (QImage::Format_RGB32 != t_img.format()) &&
+		 (QImage::Format_ARGB32 != t_img.format()) &&
+		 (QImage::Format_ARGB32_Premultiplied != t_img.format()) )
+	{
+		rgbImg = t_img.convertToFormat(QImage::Format_RGB32);
+	}
+
+	bool pixelsAllocated = AllocatePixels(rgbImg.width(), rgbImg.height());
+	if ( false == pixelsAllocated )
+	{
+		qDebug() << "FormImgPixels(): Error - can't allocate pixels";
+		return false;
+	}
+
+	unsigned char *red = m_planes.GetBytePlane(BytePlane::RED);
+	unsigned char *green = m_planes.GetBytePlane(BytePlane::GREEN);
+	unsigned char *blue = m_planes.GetBytePlane(BytePlane::BLUE);
+	for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
+	{
+		const QRgb *imgLine = (const QRgb *)rgbImg.constScanLine(hgt);
+		const unsigned int rowStart = PixIndex(0, hgt);
+		unsigned char *rowRed = red + rowStart;
+		unsigned char *rowGreen = green + rowStart;
+		unsigned char *rowBlue = blue + rowStart;
+		for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
+		{
+			const QRgb pixel = imgLine[wdt];
+			rowRed[wdt] = (unsigned char)qRed(pixel);
+			rowGreen[wdt] = (unsigned char)qGreen(pixel);
+			rowBlue[wdt] = (unsigned char)qBlue(pixel);
+		}
+	}
+
+	return true;
+}
+
+// Transform all image pixels from RGB color space to LAB
+// @input:
+// @output:
+void SourceImgPixels::TransAllPixRGB2LAB()
+{
+	ImagePixels::TransAllPixRGB2LAB();
+
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
+	{
+		CalcPixRelativeLum(pix);
+	}
+}
+
+// Calc relative LAB luminance
+// @input:
+// - unsigned int - exist index of pixel
+// @output:
+void SourceImgPixels::CalcPixRelativeLum(const unsigned int &t_index)
+{
+	if ( m_planes.GetPixelsNum() <= t_index )
+	{
+		qDebug() << "CalcPixRelativeLum(): Error - invalid arguments";
+		return;
+	}
+
+	double relativeLum = m_planes.GetPlane(Plane::LUM)[t_index] / LAB_MAX_LUM;
+	if ( (true == qIsNaN(relativeLum)) || (relativeLum < RELATIVE_MIN) )
+	{
+		relativeLum = RELATIVE_MIN;
+	}
+
+	m_planes.GetPlane(Plane::REL_LUM)[t_index] = relativeLum;
+}
+
+// Set relative LAB luminance of pixel
+// @input:
+// - unsigned int - exist index of pixel
+// - double - value of relative LAB luminace in range [0, 1]
+// @output:
+// - true - luminance accepted
+// - false - luminance is out of range
+bool SourceImgPixels::SetPixRelativeLum(const unsigned int &t_index, const double &t_lum)
+{
+	if ( (m_planes.GetPixelsNum() <= t_index) ||
+		 (t_lum < RELATIVE_MIN) ||
+		 (RELATIVE_MAX < t_lum) ||
+		 (true == qIsNaN(t_lum)) )
+	{
+		qDebug() << "SetPixRelativeLum(): Error - invalid arguments, t_lum =" << t_lum;
+		qDebug() << "Realtive lumiance not accepted";
+		return false;
+	}
+
+	m_planes.GetPlane(Plane::REL_LUM)[t_index] = t_lum;
+	return true;
+}
+
+// Get affine transform of relative luminance of pixels
+// Relative luminance of Source image is always calculated from LAB luminance.
+// @input:
+// - double - scale of relative luminance
+// - double - shift of relative luminance
+// @output:
+// - true - relative luminance = luminance from LAB * scale + shift
+// - false - relative luminance was transformed not linearly
+bool SourceImgPixels::GetRelLumTransform(double &t_scale, double &t_shift) const
+{
+	t_scale = 1.0;
+	t_shift = 0.0;
+
+	return true;
+}
+
+// Get pixel relative luminance
+// @input:
+// - unsigned int - exist width (x) position of pixel
+// - unsigned int - exist height (y) position of pixel
+// @output:
+// - double in range [0, 1] - pixels relative luminance
+// - double < 0 - can't find such pixel
+double SourceImgPixels::GetPixelsRelativeLum(const unsigned int &t_width, const unsigned int &t_height) const
+{
+	if ( false == IsPixelExist(t_width, t_height) )
+	{
+		qDebug() << "GetPixelsRelativeLum(): Error - invalid arguments";
+		return ERROR;
+	}
+
+	return m_planes.GetPlane(Plane::REL_LUM)[ PixIndex(t_width, t_height) ];
+}
+
+// Set number of threads for calculation of features
+// @input:
+// - int - positive number of threads or 0 (use number of processor cores)
+// @output:
+void SourceImgPixels::SetThreadsNum(const int &t_threadsNum)
+{
+	if ( t_threadsNum < 0 )
+	{
+		qDebug() << "SetThreadsNum(): Error - invalid arguments";
+		return;
+	}
+
+	s_threadsNum = t_threadsNum;
+}
+
+// Get number of threads for calculation of features
+// @input:
+// @output:
+// - int - positive number of threads
+int SourceImgPixels::GetThreadsNum()
+{
+	if ( 0 < s_threadsNum )
+	{
+		return s_threadsNum;
+	}
+
+	return qMax(1, QThread::idealThreadCount());
+}
+
+// Calc features of pixels, which are not actual for current luminance
+// Features depend only on relative luminance of pixels, so they are calculated again only if luminance was
+// changed (for example, by scaling of Target image luminance) since their calculation.
+// @input:
+// - QList<Feature::Type> - features, which are needed
+// @output:
+// - true - all needed features are actual
+// - false - failed to calc features
+bool SourceImgPixels::UpdatePixelsFeatures(const QList<Feature::Type> &t_features)
+{
+	if ( true == m_planes.IsEmpty() )
+	{
+		qDebug() << "UpdatePixelsFeatures(): Error - no pixels";
+		return false;
+	}
+
+	bool needFeature[Feature::DEFAULT_LAST];
+	for ( int feature = 0; feature < Feature::DEFAULT_LAST; feature++ )
+	{
+		needFeature[feature] = false;
+	}
+
+	bool lumActual = IsFeaturesLumActual();
+	if ( false == lumActual )
+	{
+		lumActual = RescaleFeatures();
+	}
+
+	bool needCalc = false;
+	for ( int feature = 0; feature < t_features.size(); feature++ )
+	{
+		const Feature::Type type = t_features.at(feature);
+		if ( (type < Feature::SKO) || (Feature::DEFAULT_LAST <= type) )
+		{
+			qDebug() << "UpdatePixelsFeatures(): Error - invalid feature" << type;
+			return false;
+		}
+
+		if ( (false == lumActual) || (false == IsFeatureActual(type)) )
+		{
+			needFeature[type] = true;
+			needCalc = true;
+		}
+	}
+
+	if ( false == needCalc )
+	{
+		return true;
+	}
+
+	CalcPixelsFeatures(needFeature[Feature::SKO],
+					   needFeature[Feature::ENTROPY],
+					   needFeature[Feature::SKEW_AND_KURT]);
+
+	for ( int feature = 0; feature < t_features.size(); feature++ )
+	{
+		if ( false == IsFeatureActual(t_features.at(feature)) )
+		{
+			qDebug() << "UpdatePixelsFeatures(): Error - can't calc feature" << t_features.at(feature);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Set side of mask, with which feature of pixels is calculated. If side is changed, values of feature become
+// not actual.
+// @input:
+// - Feature::Type - exist feature
+// - unsigned int - odd side of mask in range [FEATURE_MASK_MIN_SIDE, FEATURE_MASK_MAX_SIDE]
+// @output:
+// - true - side of mask is set
+// - false - invalid arguments
+bool SourceImgPixels::SetFeatureMaskSide(const Feature::Type &t_feature, const unsigned int &t_maskRectSide)
+{
+	if ( (t_feature < Feature::SKO) ||
+		 (Feature::DEFAULT_LAST <= t_feature) ||
+		 (0 == t_maskRectSide % 2) ||
+		 (t_maskRectSide < FEATURE_MASK_MIN_SIDE) ||
+		 (FEATURE_MASK_MAX_SIDE < t_maskRectSide) )
+	{
+		qDebug() << "SetFeatureMaskSide(): Error - invalid arguments";
+		return false;
+	}
+
+	if ( m_featureMaskSides[t_feature] != t_maskRectSide )
+	{
+		m_featureMaskSides[t_feature] = t_maskRectSide;
+		m_featuresActual[t_feature] = false;
+	}
+
+	return true;
+}
+
+// Get side of mask, with which feature of pixels is calculated
+// @input:
+// - Feature::Type - exist feature
+// @output:
+// - unsigned int - side of mask (0 for invalid feature)
+unsigned int SourceImgPixels::GetFeatureMaskSide(const Feature::Type &t_feature) const
+{
+	if ( (t_feature < Feature::SKO) || (Feature::DEFAULT_LAST <= t_feature) )
+	{
+		qDebug() << "GetFeatureMaskSide(): Error - invalid arguments";
+		return 0;
+	}
+
+	return m_featureMaskSides[t_feature];
+}
+
+// Check if feature of pixels is actual for current luminance
+// @input:
+// - Feature::Type - exist feature
+// @output:
+// - true - feature is actual
+// - false - feature should be calculated
+bool SourceImgPixels::HasActualFeature(const Feature::Type &t_feature) const
+{
+	return ( (true == IsFeatureActual(t_feature)) && (true == IsFeaturesLumActual()) );
+}
+
+// Get values of feature of all pixels
+// @input:
+// - Feature::Type - exist feature, which is actual for current luminance
+// - QVector<PlaneValue> - values of feature (planes of feature one after another)
+// @output:
+// - true - values of feature saved to t_values
+// - false - feature is not actual
+bool SourceImgPixels::ExportFeature(const Feature::Type &t_feature, QVector<PlaneValue> &t_values) const
+{
+	if ( false == HasActualFeature(t_feature) )
+	{
+		qDebug() << "ExportFeature(): Error - feature is not actual";
+		return false;
+	}
+
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	const QList<Plane::Type> planes = GetFeaturePlanes(t_feature);
+	t_values.resize( (int)pixelsNum * planes.size() );
+	for ( int plane = 0; plane < planes.size(); plane++ )
+	{
+		memcpy(t_values.data() + plane * pixelsNum,
+			   m_planes.GetPlane(planes.at(plane)),
+			   pixelsNum * sizeof(PlaneValue));
+	}
+
+	return true;
+}
+
+// Set values of feature of all pixels (calculated earlier for the same luminance)
+// @input:
+// - Feature::Type - exist feature
+// - QVector<PlaneValue> - values of feature, got by ExportFeature() for the same relative luminance
+// @output:
+// - true - feature set and is actual now
+// - false - invalid arguments
+bool SourceImgPixels::ImportFeature(const Feature::Type &t_feature, const QVector<PlaneValue> &t_values)
+{
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	const QList<Plane::Type> planes = GetFeaturePlanes(t_feature);
+	if ( (0 == pixelsNum) ||
+		 (true == planes.isEmpty()) ||
+		 (t_values.size() != (int)pixelsNum * planes.size()) )
+	{
+		qDebug() << "ImportFeature(): Error - invalid arguments";
+		return false;
+	}
+
+	if ( false == IsFeaturesLumActual() )
+	{
+		ResetFeatures();
+		SaveFeaturesLum();
+	}
+
+	for ( int plane = 0; plane < planes.size(); plane++ )
+	{
+		if ( false == m_planes.AllocatePlane(planes.at(plane)) )
+		{
+			qDebug() << "ImportFeature(): Error - can't allocate plane for feature" << t_feature;
+			return false;
+		}
+
+		memcpy(m_planes.GetPlane(planes.at(plane)),
+			   t_values.constData() + plane * pixelsNum,
+			   pixelsNum * sizeof(PlaneValue));
+	}
+
+	m_featuresActual[t_feature] = true;
+
+	return true;
+}
+
+// Get hash of relative luminance of pixels
+// Features of pixels depend only on relative luminance (and size of image), so hash identifies them.
+// @input:
+// @output:
+// - QByteArray - hash of relative luminance and size of image
+// - empty QByteArray - there are no pixels
+QByteArray SourceImgPixels::GetRelLumHash() const
+{
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	if ( 0 == pixelsNum )
 	{
-		int pixHeight = m_pixels.at(width).size();
-		for ( int height = pixHeight - 1; height >= 0; --height )
+		return QByteArray();
+	}
+
+	QCryptographicHash hash(QCryptographicHash::Md5);
+	hash.addData((const char *)&m_width, sizeof(m_width));
+	hash.addData((const char *)&m_height, sizeof(m_height));
+	hash.addData((const char *)m_planes.GetPlane(Plane::REL_LUM), (int)(pixelsNum * sizeof(PlaneValue)));
+
+	return hash.result();
+}
+
+// Set pixels and features from opened file of Source model. Values of planes are copied from mapped file,
+// features of model become actual (with sides of masks of model).
+// @input:
+// - SourceModelFile - opened file of model
+// @output:
+// - true - pixels restored
+// - false - invalid model
+bool SourceImgPixels::RestorePixels(const SourceModelFile &t_model)
+{
+	if ( false == t_model.IsOpened() )
+	{
+		qDebug() << "RestorePixels(): Error - invalid arguments";
+		return false;
+	}
+
+	bool pixelsAllocated = AllocatePixels(t_model.GetWidth(), t_model.GetHeight());
+	if ( false == pixelsAllocated )
+	{
+		qDebug() << "RestorePixels(): Error - can't allocate pixels";
+		return false;
+	}
+
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	const Plane::Type mainPlanes[] = { Plane::LUM, Plane::CH_A, Plane::CH_B, Plane::REL_LUM };
+	const int mainPlanesNum = sizeof(mainPlanes) / sizeof(mainPlanes[0]);
+	for ( int plane = 0; plane < mainPlanesNum; plane++ )
+	{
+		const PlaneValue *values = t_model.GetPlane(mainPlanes[plane]);
+		if ( NULL == values )
 		{
-			ColorPixel *pix = (ColorPixel *)m_pixels[width][height];
-			if ( NULL != pix )
+			qDebug() << "RestorePixels(): Error - model has no plane" << mainPlanes[plane];
+			Clear();
+			return false;
+		}
+
+		memcpy(m_planes.GetPlane(mainPlanes[plane]), values, pixelsNum * sizeof(PlaneValue));
+	}
+
+	for ( int plane = 0; plane < BytePlane::DEFAULT_LAST; plane++ )
+	{
+		const BytePlane::Type type = (BytePlane::Type)plane;
+		const unsigned char *values = t_model.GetBytePlane(type);
+		if ( NULL != values )
+		{
+			memcpy(m_planes.GetBytePlane(type), values, pixelsNum);
+		}
+	}
+
+	ResetFeatures();
+	SaveFeaturesLum();
+
+	for ( int feature = 0; feature < Feature::DEFAULT_LAST; feature++ )
+	{
+		const Feature::Type type = (Feature::Type)feature;
+		const unsigned int maskSide = t_model.GetFeatureMaskSide(type);
+		if ( (0 == maskSide) || (false == SetFeatureMaskSide(type, maskSide)) )
+		{
+			continue;
+		}
+
+		const QList<Plane::Type> planes = GetFeaturePlanes(type);
+		bool featureRestored = true;
+		for ( int plane = 0; (true == featureRestored) && (plane < planes.size()); plane++ )
+		{
+			const PlaneValue *values = t_model.GetPlane(planes.at(plane));
+			featureRestored = (NULL != values) && (true == m_planes.AllocatePlane(planes.at(plane)));
+			if ( true == featureRestored )
 			{
-				delete pix;
+				memcpy(m_planes.GetPlane(planes.at(plane)), values, pixelsNum * sizeof(PlaneValue));
 			}
 		}
 
-		m_pixels[width].clear();
+		m_featuresActual[type] = featureRestored;
 	}
 
-	m_pixels.clear();
+	return true;
 }
 
-// Save all pixels from input QImage as custom pixels
+// Get planes of feature
 // @input:
-// - QImage - unnull image
+// - Feature::Type - exist feature
 // @output:
-bool SourceImgPixels::FormImgPixels(const QImage &t_img)
+// - QList<Plane::Type> - planes, where values of feature are saved
+QList<Plane::Type> SourceImgPixels::GetFeaturePlanes(const Feature::Type &t_feature) const
 {
-	if ( true == t_img.isNull() )
+	QList<Plane::Type> planes;
+	switch(t_feature)
+	{
+		case Feature::SKO:
+			planes.append(Plane::SKO);
+			break;
+
+		case Feature::ENTROPY:
+			planes.append(Plane::ENTROPY);
+			break;
+
+		case Feature::SKEW_AND_KURT:
+			planes.append(Plane::SKEWNESS);
+			planes.append(Plane::KURTOSIS);
+			break;
+
+		case Feature::DEFAULT_LAST:
+		default:
+		{
+			qDebug() << "GetFeaturePlanes(): Error - invalid feature";
+		}
+	}
+
+	return planes;
+}
+
+// Check if feature was calculated for current luminance of pixels
+// @input:
+// - Feature::Type - exist feature
+// @output:
+// - true - values of feature are actual
+// - false - feature should be calculated
+bool SourceImgPixels::IsFeatureActual(const Feature::Type &t_feature) const
+{
+	if ( (t_feature < Feature::SKO) || (Feature::DEFAULT_LAST <= t_feature) )
+	{
+		qDebug() << "IsFeatureActual(): Error - invalid arguments";
+		return false;
+	}
+
+	if ( false == m_featuresActual[t_feature] )
+	{
+		return false;
+	}
+
+	const QList<Plane::Type> planes = GetFeaturePlanes(t_feature);
+	for ( int plane = 0; plane < planes.size(); plane++ )
+	{
+		if ( false == m_planes.HasPlane(planes.at(plane)) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Check if current luminance of pixels is the same as luminance, for which features were calculated
+// @input:
+// @output:
+// - true - luminance wasn't changed
+// - false - luminance was changed (or features were not calculated)
+bool SourceImgPixels::IsFeaturesLumActual() const
+{
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	if ( (0 == pixelsNum) || ((int)pixelsNum != m_featuresRelLum.size()) )
+	{
+		return false;
+	}
+
+	const int cmpResult = memcmp(m_featuresRelLum.constData(),
+								 m_planes.GetPlane(Plane::REL_LUM),
+								 pixelsNum * sizeof(PlaneValue));
+
+	return ( 0 == cmpResult );
+}
+
+// Forget about calculated features
+// @input:
+// @output:
+void SourceImgPixels::ResetFeatures()
+{
+	m_featuresRelLum.clear();
+	for ( int feature = 0; feature < Feature::DEFAULT_LAST; feature++ )
+	{
+		m_featuresActual[feature] = false;
+	}
+
+	m_featuresLumScale = 1.0;
+	m_featuresLumShift = 0.0;
+	m_featuresLumAffine = false;
+}
+
+// Save current relative luminance as luminance of features
+// @input:
+// @output:
+void SourceImgPixels::SaveFeaturesLum()
+{
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	const PlaneValue *relLum = m_planes.GetPlane(Plane::REL_LUM);
+	m_featuresRelLum.resize((int)pixelsNum);
+	memcpy(m_featuresRelLum.data(), relLum, pixelsNum * sizeof(PlaneValue));
+
+	m_featuresLumAffine = GetRelLumTransform(m_featuresLumScale, m_featuresLumShift);
+}
+
+// Transform features for current luminance, if it's affine transform of luminance of features
+// If lum = a * featuresLum + b (a > 0), SKO of pixels is multiplied by a (BEST_SKO is zero). Entropy, skewness
+// and kurtosis are calculated for quantised luminance (bins of histogram), so they are not transformed and
+// will be calculated again.
+// @input:
+// @output:
+// - true - features are transformed (some of them could become not actual)
+// - false - luminance is not affine transform of luminance of features
+bool SourceImgPixels::RescaleFeatures()
+{
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	if ( (0 == pixelsNum) ||
+		 ((int)pixelsNum != m_featuresRelLum.size()) ||
+		 (false == m_featuresLumAffine) ||
+		 (m_featuresLumScale <= 0.0) )
 	{
-		qDebug() << "FormImgPixels(): Error - invalid arguments";
 		return false;
 	}
 
-	m_width = t_img.width();
-	m_height = t_img.height();
+	double lumScale = 0.0;
+	double lumShift = 0.0;
+	bool lumAffine = GetRelLumTransform(lumScale, lumShift);
+	if ( (false == lumAffine) || (lumScale <= 0.0) )
+	{
+		return false;
+	}
+
+	const double skoFactor = lumScale / m_featuresLumScale;
+	if ( true == IsFeatureActual(Feature::SKO) )
+	{
+		PlaneValue *sko = m_planes.GetPlane(Plane::SKO);
+		for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
+		{
+			double pixelSKO = sko[pix] * skoFactor;
+			if ( RELATIVE_MAX < pixelSKO )
+			{
+				pixelSKO = RELATIVE_MAX;
+			}
+
+			sko[pix] = pixelSKO;
+		}
+	}
+
+	m_featuresActual[Feature::ENTROPY] = false;
+	m_featuresActual[Feature::SKEW_AND_KURT] = false;
+
+	SaveFeaturesLum();
+
+	return true;
+}
+
+// Calc for each pixel in image requested features in one pass
+// Image is processed by bands of FEATURE_BAND_ROWS rows. Each band is handled as separate image with halo
+// rows above and below it (they are needed for masks of border rows of band), so data of band stays in cache
+// while all features are calculated for it. SKO is got from sums of masks, entropy and skewness/kurtosis - from
+// one sliding mask histogram.
+// Bands are calculated in GetThreadsNum() threads. Bounds of bands don't depend on number of threads, and each
+// pixel is calculated only in its band, so result is the same for any number of threads.
+// @input:
+// - bool - calc SKO of pixels
+// - bool - calc entropy of pixels
+// - bool - calc skewness and kurtosis of pixels
+// @output:
+void SourceImgPixels::CalcPixelsFeatures(const bool &t_sko, const bool &t_entropy, const bool &t_skewAndKurt)
+{
+	if ( (false == t_sko) && (false == t_entropy) && (false == t_skewAndKurt) )
+	{
+		qDebug() << "CalcPixelsFeatures(): Error - no features requested";
+		return;
+	}
+
+	// The same restrictions as in GetPixNeighborsRelLum()
+	const unsigned int skoSide = m_featureMaskSides[Feature::SKO];
+	if ( (true == t_sko) && ((m_width <= skoSide) || (m_height <= skoSide)) )
+	{
+		qDebug() << "CalcPixelsFeatures(): Error - image is too small for SKO";
+		return;
+	}
+
+	const unsigned int entropySide = m_featureMaskSides[Feature::ENTROPY];
+	if ( (true == t_entropy) && ((m_width <= entropySide) || (m_height <= entropySide)) )
+	{
+		qDebug() << "CalcPixelsFeatures(): Error - image is too small for entropy";
+		return;
+	}
+
+	const unsigned int momentsSide = m_featureMaskSides[Feature::SKEW_AND_KURT];
+	if ( (true == t_skewAndKurt) && ((m_width <= momentsSide) || (m_height <= momentsSide)) )
+	{
+		qDebug() << "CalcPixelsFeatures(): Error - image is too small for skewness and kurtosis";
+		return;
+	}
+
+	if ( false == IsFeaturesLumActual() )
+	{
+		// Luminance was changed, so all features calculated before are not actual
+		ResetFeatures();
+		SaveFeaturesLum();
+	}
+
+	const bool requested[Feature::DEFAULT_LAST] = { t_sko, t_entropy, t_skewAndKurt };
+	for ( int feature = 0; feature < Feature::DEFAULT_LAST; feature++ )
+	{
+		if ( false == requested[feature] )
+		{
+			continue;
+		}
+
+		const QList<Plane::Type> planes = GetFeaturePlanes((Feature::Type)feature);
+		for ( int plane = 0; plane < planes.size(); plane++ )
+		{
+			if ( false == m_planes.AllocatePlane(planes.at(plane)) )
+			{
+				qDebug() << "CalcPixelsFeatures(): Error - can't allocate plane for feature" << feature;
+				return;
+			}
+		}
+	}
+
+	QList<FeaturesBandTask *> tasks;
+	for ( unsigned int firstRow = 0; firstRow < m_height; firstRow += FEATURE_BAND_ROWS )
+	{
+		const unsigned int lastRow = qMin(m_height, firstRow + FEATURE_BAND_ROWS);
+		tasks.append( new FeaturesBandTask(this, firstRow, lastRow, t_sko, t_entropy, t_skewAndKurt) );
+	}
+
+	const int threadsNum = qMin(GetThreadsNum(), tasks.size());
+	if ( threadsNum <= 1 )
+	{
+		for ( int task = 0; task < tasks.size(); task++ )
+		{
+			tasks[task]->run();
+		}
+	}
+	else
+	{
+		QThreadPool threadPool;
+		threadPool.setMaxThreadCount(threadsNum);
+		for ( int task = 0; task < tasks.size(); task++ )
+		{
+			threadPool.start(tasks[task]);
+		}
+
+		threadPool.waitForDone();
+	}
+
+	bool allDone = true;
+	for ( int task = 0; task < tasks.size(); task++ )
+	{
+		if ( false == tasks[task]->IsDone() )
+		{
+			qDebug() << "CalcPixelsFeatures(): Error - can't calc features of band" << task;
+			allDone = false;
+		}
+
+		delete tasks[task];
+	}
+
+	if ( true == allDone )
+	{
+		for ( int feature = 0; feature < Feature::DEFAULT_LAST; feature++ )
+		{
+			if ( true == requested[feature] )
+			{
+				m_featuresActual[feature] = true;
+			}
+		}
+	}
+}
+
+// Calc requested features for pixels of band of rows
+// @input:
+// - unsigned int - exist first row of band
+// - unsigned int - row after last row of band (not bigger than image height)
+// - bool - calc SKO of pixels
+// - bool - calc entropy of pixels
+// - bool - calc skewness and kurtosis of pixels
+// @output:
+// - true - features of band calculated
+// - false - invalid arguments
+bool SourceImgPixels::CalcBandFeatures(const unsigned int &t_firstRow,
+									   const unsigned int &t_lastRow,
+									   const bool &t_sko,
+									   const bool &t_entropy,
+									   const bool &t_skewAndKurt)
+{
+	if ( (m_height < t_lastRow) || (t_lastRow <= t_firstRow) )
+	{
+		qDebug() << "CalcBandFeatures(): Error - invalid arguments";
+		return false;
+	}
+
+	const PlaneValue *relLum = m_planes.GetPlane(Plane::REL_LUM);
+	PlaneValue *sko = m_planes.GetPlane(Plane::SKO);
+	PlaneValue *entropy = m_planes.GetPlane(Plane::ENTROPY);
+
+	// SKO of pixel with luminance c and N neighbors x:
+	// SKO^2 = sum( (c - x)^2 ) / N = ( N * c^2 - 2 * c * sum(x) + sum(x^2) ) / N
+	// Sums of neighbors are sums of mask without central pixel.
+	const unsigned int skoSide = m_featureMaskSides[Feature::SKO];
+	const unsigned int skoOffset = skoSide / 2;
+	const unsigned int skoFirstRow = (skoOffset < t_firstRow) ? (t_firstRow - skoOffset) : 0;
+	const unsigned int skoLastRow = qMin(m_height, t_lastRow + skoOffset);
+	ImgMaskSums maskSums;
+	if ( true == t_sko )
+	{
+		bool sumsReady = maskSums.Init(relLum + PixIndex(0, skoFirstRow),
+									   m_width,
+									   skoLastRow - skoFirstRow,
+									   skoSide,
+									   2);
+		if ( false == sumsReady )
+		{
+			qDebug() << "CalcBandFeatures(): Error - can't calc sums of masks";
+			return false;
+		}
+	}
+
+	// Masks of entropy and of skewness/kurtosis include central pixel as in CalcPixsEntropy(). If sides of their
+	// masks are the same, one histogram is used for both features.
+	const bool sameHistSides = (m_featureMaskSides[Feature::ENTROPY] == m_featureMaskSides[Feature::SKEW_AND_KURT]);
+	ImgMaskHistogram entropyHist;
+	unsigned int entropyFirstRow = 0;
+	if ( (true == t_entropy) || ((true == t_skewAndKurt) && (true == sameHistSides)) )
+	{
+		bool histReady = InitBandHistogram(entropyHist,
+										   m_featureMaskSides[Feature::ENTROPY],
+										   t_firstRow,
+										   t_lastRow,
+										   entropyFirstRow);
+		if ( false == histReady )
+		{
+			qDebug() << "CalcBandFeatures(): Error - can't create histogram of masks";
+			return false;
+		}
+	}
+
+	ImgMaskHistogram separateMomentsHist;
+	ImgMaskHistogram *momentsHist = &entropyHist;
+	unsigned int momentsFirstRow = entropyFirstRow;
+	if ( (true == t_skewAndKurt) && (false == sameHistSides) )
+	{
+		momentsHist = &separateMomentsHist;
+		bool histReady = InitBandHistogram(separateMomentsHist,
+										   m_featureMaskSides[Feature::SKEW_AND_KURT],
+										   t_firstRow,
+										   t_lastRow,
+										   momentsFirstRow);
+		if ( false == histReady )
+		{
+			qDebug() << "CalcBandFeatures(): Error - can't create histogram of masks";
+			return false;
+		}
+	}
 
-	for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
+	for ( unsigned int hgt = t_firstRow; hgt < t_lastRow; hgt++ )
 	{
-		QList<Pixel *> columnOfPixels;
+		if ( true == t_sko )
+		{
+			maskSums.CalcRowSums(hgt - skoFirstRow);
+		}
 
-		for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
+		const unsigned int rowStart = PixIndex(0, hgt);
+		for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
 		{
-			QRgb pixel = t_img.pixel(wdt, hgt);
+			const unsigned int index = rowStart + wdt;
+			if ( true == t_sko )
+			{
+				const double pixelLum = relLum[index];
+				const double neighborsNum = maskSums.GetMaskPixelsNum(wdt) - 1;
+				const double lumSum = maskSums.GetMaskSum(wdt, 1) - pixelLum;
+				const double squareLumSum = maskSums.GetMaskSum(wdt, 2) - pixelLum * pixelLum;
+
+				double squareSKO = BEST_SKO + neighborsNum * pixelLum * pixelLum - 2 * pixelLum * lumSum + squareLumSum;
+				squareSKO /= neighborsNum;
+
+				// Rounding errors could make zero SKO a bit negative
+				if ( squareSKO < 0 )
+				{
+					squareSKO = 0;
+				}
+
+				const double pixelSKO = FastMath::SquareRoot(squareSKO);
+				if ( RELATIVE_MAX < pixelSKO )
+				{
+					qDebug() << "CalcBandFeatures(): Error - invalid SKO =" << pixelSKO;
+					qDebug() << "Realtive SKO not accepted";
+				}
+				else
+				{
+					sko[index] = pixelSKO;
+				}
+			}
 
-			RGB rgbPixel;
-			bool colorOK = rgbPixel.SetColor(qRed(pixel), qGreen(pixel), qBlue(pixel));
-			if ( false == colorOK )
+			if ( true == t_entropy )
 			{
-				qDebug() << "FormImgPixels(): pixel with coords (" << wdt << "," << hgt <<
-							") has problems with RGB channels: invalid value";
+				entropyHist.MoveToPixel(wdt, hgt - entropyFirstRow);
+
+				double pixelEntropy = entropyHist.GetEntropy();
+				if ( pixelEntropy < RELATIVE_MIN )
+				{
+					qDebug() << "CalcBandFeatures(): negative entropy =" << pixelEntropy;
+					pixelEntropy = RELATIVE_MIN;
+				}
+
+				pixelEntropy /= entropyHist.GetFilledBinsNum();
+
+				if ( RELATIVE_MAX < pixelEntropy )
+				{
+					qDebug() << "CalcBandFeatures(): Error - invalid entropy =" << pixelEntropy;
+				}
+				else
+				{
+					entropy[index] = pixelEntropy;
+				}
 			}
 
-			ColorPixel *colorPix = new ColorPixel;
-			colorPix->SetRGB(rgbPixel);
+			if ( true == t_skewAndKurt )
+			{
+				double skewness = 0.0;
+				double kurtosis = 0.0;
+				momentsHist->MoveToPixel(wdt, hgt - momentsFirstRow);
+				momentsHist->GetSkewAndKurt(skewness, kurtosis);
 
-			columnOfPixels.append(colorPix);
+				SetPixSkewAndKurt(index, skewness, kurtosis);
+			}
 		}
-
-		m_pixels.append(columnOfPixels);
 	}
 
 	return true;
 }
 
-// Transform all image pixels from RGB color space to LAB
-// @input:
-// @output:
-void SourceImgPixels::TransAllPixRGB2LAB()
-{
-	for ( unsigned int width = 0; width < m_width; width++ )
-	{
-		for ( unsigned int height = 0; height < m_height; height++ )
-		{
-			TransformPixRGB2LAB(width, height);
-			CalcPixRelativeLum(width, height);
-		}
-	}
-}
-
-// Calc relative LAB luminance
-// @input:
-// @output:
-void SourceImgPixels::CalcPixRelativeLum(const unsigned int &t_width, const unsigned int &t_height)
-{
-	if ( false == IsPixelExist(t_width, t_height) )
-	{
-		qDebug() << "CalcPixRelativeLum(): Error - invalid arguments";
-		return;
-	}
-
-	ColorPixel *pixel = (ColorPixel *)m_pixels[t_width][t_height];
-	pixel->CalcRelativeLum();
-}
-
-// Get pixel relative luminance
+// Create histogram of masks of relative luminance for band of rows. Histogram is built for sub-plane with halo
+// rows, which are needed for masks of border rows of band.
 // @input:
-// - unsigned int - exist width (x) position of pixel
-// - unsigned int - exist height (y) position of pixel
+// - ImgMaskHistogram - histogram to initialise
+// - unsigned int - odd side of mask
+// - unsigned int - exist first row of band
+// - unsigned int - row after last row of band (not bigger than image height)
+// - unsigned int - first row of image in sub-plane of histogram (result)
 // @output:
-// - double in range [0, 1] - pixels relative luminance
-// - double < 0 - can't find such pixel
-double SourceImgPixels::GetPixelsRelativeLum(const unsigned int &t_width, const unsigned int &t_height) const
+// - true - histogram is ready
+// - false - invalid arguments
+bool SourceImgPixels::InitBandHistogram(ImgMaskHistogram &t_hist,
+										const unsigned int &t_maskRectSide,
+										const unsigned int &t_firstRow,
+										const unsigned int &t_lastRow,
+										unsigned int &t_histFirstRow) const
 {
-	if ( false == IsPixelExist(t_width, t_height) )
-	{
-		qDebug() << "GetPixelsRelativeLum(): Error - invalid arguments";
-		return ERROR;
-	}
-
-	const ColorPixel *pixel = (ColorPixel *)m_pixels[t_width][t_height];
-	return pixel->GetRelativeLum();
+	const unsigned int histOffset = t_maskRectSide / 2;
+	t_histFirstRow = (histOffset < t_firstRow) ? (t_firstRow - histOffset) : 0;
+	const unsigned int histLastRow = qMin(m_height, t_lastRow + histOffset);
+
+	return t_hist.Init(m_planes.GetPlane(Plane::REL_LUM) + PixIndex(0, t_histFirstRow),
+					   m_width,
+					   histLastRow - t_histFirstRow,
+					   t_maskRectSide);
 }
 
 // Calc for each pixel in image it's SKO
@@ -150,16 +986,10 @@ double SourceImgPixels::GetPixelsRelativeLum(const unsigned int &t_width, const
 // @output:
 void SourceImgPixels::CalcPixelsSKO()
 {
-	for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
-	{
-		for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
-		{
-			CalcPixSKO(wdt, hgt);
-		}
-	}
+	CalcPixelsFeatures(true, false, false);
 }
 
-// Calc for certain pixel in image it's SKO
+// Calc for certain pixel in image it's SKO. It's slow, so it's used only as reference for TestCalcPixelsSKO()
 // @input:
 // - unsigned int - exist width (x) position of pixel
 // - unsigned int - exist height (y) position of pixel
@@ -174,15 +1004,15 @@ void SourceImgPixels::CalcPixSKO(const unsigned int &t_width, const unsigned int
 
 	QList<double> lumInMask = GetPixNeighborsRelLum(t_width,
 													t_height,
-													SKO_MASK_RECT_SIDE);
+													m_featureMaskSides[Feature::SKO]);
 	if ( true == lumInMask.isEmpty() )
 	{
 		qDebug() << "CalcPixSKO(): Error - no pixels in mask";
 		return;
 	}
 
-	ColorPixel *pixel = (ColorPixel *)m_pixels[t_width][t_height];
-	double pixelLum = pixel->GetRelativeLum();
+	const unsigned int index = PixIndex(t_width, t_height);
+	double pixelLum = m_planes.GetPlane(Plane::REL_LUM)[index];
 
 	CalculatorSKO calc;
 	double pixelSKO = calc.PixelMaskSKO(pixelLum, lumInMask);
@@ -192,7 +1022,20 @@ void SourceImgPixels::CalcPixSKO(const unsigned int &t_width, const unsigned int
 		return;
 	}
 
-	pixel->SetSKO(pixelSKO);
+	if ( RELATIVE_MAX < pixelSKO )
+	{
+		qDebug() << "CalcPixSKO(): Error - invalid SKO =" << pixelSKO;
+		qDebug() << "Realtive SKO not accepted";
+		return;
+	}
+
+	if ( false == m_planes.AllocatePlane(Plane::SKO) )
+	{
+		qDebug() << "CalcPixSKO(): Error - can't allocate plane";
+		return;
+	}
+
+	m_planes.GetPlane(Plane::SKO)[index] = pixelSKO;
 }
 
 // Get SKO of pixel with certain coords
@@ -210,8 +1053,13 @@ double SourceImgPixels::GetPixelsSKO(const unsigned int &t_width, const unsigned
 		return ERROR;
 	}
 
-	const ColorPixel *pixel = (ColorPixel *)m_pixels[t_width][t_height];
-	return pixel->GetSKO();
+	// Feature was not calculated yet
+	if ( false == m_planes.HasPlane(Plane::SKO) )
+	{
+		return RELATIVE_MIN;
+	}
+
+	return m_planes.GetPlane(Plane::SKO)[ PixIndex(t_width, t_height) ];
 }
 
 // Calc for each pixel in image it's Entropy
@@ -219,16 +1067,11 @@ double SourceImgPixels::GetPixelsSKO(const unsigned int &t_width, const unsigned
 // @output:
 void SourceImgPixels::CalcPixelsEntropy()
 {
-	for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
-	{
-		for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
-		{
-			CalcPixsEntropy(wdt, hgt);
-		}
-	}
+	CalcPixelsFeatures(false, true, false);
 }
 
-// Calc for certain pixel in image it's entropy
+// Calc for certain pixel in image it's entropy. It's slow, so it's used only as reference for
+// TestCalcPixelsEntropy()
 // @input:
 // - unsigned int - exist width (x) position of pixel
 // - unsigned int - exist height (y) position of pixel
@@ -243,15 +1086,15 @@ void SourceImgPixels::CalcPixsEntropy(const unsigned int &t_width, const unsigne
 
 	QList<double> lumInMask = GetPixNeighborsRelLum(t_width,
 													t_height,
-													ENTROPY_MASK_RECT_SIDE);
+													m_featureMaskSides[Feature::ENTROPY]);
 	if ( true == lumInMask.isEmpty() )
 	{
 		qDebug() << "CalcPixsEntropy(): Error - no neighbor pixels";
 		return;
 	}
 
-	ColorPixel *pixel = (ColorPixel *)m_pixels[t_width][t_height];
-	double pixelLum = pixel->GetRelativeLum();
+	const unsigned int index = PixIndex(t_width, t_height);
+	double pixelLum = m_planes.GetPlane(Plane::REL_LUM)[index];
 	lumInMask.append(pixelLum);
 
 	ImgHistogram histogramer;
@@ -282,8 +1125,19 @@ void SourceImgPixels::CalcPixsEntropy(const unsigned int &t_width, const unsigne
 
 	pixelEntropy /= existLumNum;
 
-	ColorPixel *centralPixel = (ColorPixel *)m_pixels[t_width][t_height];
-	centralPixel->SetEntropy(pixelEntropy);
+	if ( RELATIVE_MAX < pixelEntropy )
+	{
+		qDebug() << "CalcPixsEntropy(): Error - invalid entropy =" << pixelEntropy;
+		return;
+	}
+
+	if ( false == m_planes.AllocatePlane(Plane::ENTROPY) )
+	{
+		qDebug() << "CalcPixsEntropy(): Error - can't allocate plane";
+		return;
+	}
+
+	m_planes.GetPlane(Plane::ENTROPY)[index] = pixelEntropy;
 }
 
 // Get Entropy of pixel with certain coords
@@ -300,8 +1154,13 @@ double SourceImgPixels::GetPixelsEntropy(const unsigned int &t_width, const unsi
 		return RELATIVE_MIN;
 	}
 
-	const ColorPixel *pixel = (ColorPixel *)m_pixels[t_width][t_height];
-	return pixel->GetEntropy();
+	// Feature was not calculated yet
+	if ( false == m_planes.HasPlane(Plane::ENTROPY) )
+	{
+		return RELATIVE_MIN;
+	}
+
+	return m_planes.GetPlane(Plane::ENTROPY)[ PixIndex(t_width, t_height) ];
 }
 
 // Calc for each pixel in image it's Skewness and Kurtosis
@@ -309,71 +1168,26 @@ double SourceImgPixels::GetPixelsEntropy(const unsigned int &t_width, const unsi
 // @output:
 void SourceImgPixels::CalcPixelsSkewAndKurt()
 {
-	for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
-	{
-		for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
-		{
-			CalcPixsSkewAndKurt(wdt, hgt);
-		}
-	}
+	CalcPixelsFeatures(false, false, true);
 }
 
-// Calc for certain pixel in image it's Skewness and Kurtosis
+// Normalise Skewness and Kurtosis of pixel and save them
 // @input:
-// - unsigned int - exist width (x) position of pixel
-// - unsigned int - exist height (y) position of pixel
+// - unsigned int - exist index of pixel
+// - double - skewness of pixel mask (NAN or INF if mask has no variance)
+// - double - kurtosis of pixel mask (NAN or INF if mask has no variance)
 // @output:
-void SourceImgPixels::CalcPixsSkewAndKurt(const unsigned int &t_width, const unsigned int &t_height)
+void SourceImgPixels::SetPixSkewAndKurt(const unsigned int &t_index, const double &t_skewness, const double &t_kurtosis)
 {
-	if ( false == IsPixelExist(t_width, t_height) )
-	{
-		qDebug() << "CalcPixsSkewAndKurt(): Error - invalid arguments";
-		return;
-	}
-
-	QList<double> lumInMask = GetPixNeighborsRelLum(t_width,
-													t_height,
-													ENTROPY_MASK_RECT_SIDE);
-	if ( true == lumInMask.isEmpty() )
+	if ( m_planes.GetPixelsNum() <= t_index )
 	{
-		qDebug() << "CalcPixsSkewAndKurt(): Error - no neighbor pixels";
+		qDebug() << "SetPixSkewAndKurt(): Error - invalid arguments";
 		return;
 	}
 
-	ColorPixel *pixel = (ColorPixel *)m_pixels[t_width][t_height];
-	double pixelLum = pixel->GetRelativeLum();
-	lumInMask.append(pixelLum);
-
-	ImgHistogram histogramer;
-	QList<double> maskHist = histogramer.MaskRelLumHistogram(lumInMask);
-
-	const int maskSize = lumInMask.size();
-	QList<double> relMaskHist = CalcRelativeMaskHist(maskHist, maskSize);
-
-	double mean = CalcMaskHistMean(relMaskHist);
-	double variance = CalcMaskHistVariance(relMaskHist, mean);
-
-	double skewness = 0.0;
-	double kurtosis = 0.0;
-	const int relMaskHistSize = relMaskHist.size();
-	for ( int val = 0; val < relMaskHistSize; ++val )
-	{
-		if ( relMaskHist.at(val) <= 0.0 )
-		{
-			continue;
-		}
-
-		double lumDiff = val * RELATIVE_DIVIDER - mean;
-
-		skewness += pow(lumDiff, 3.0) * relMaskHist.at(val);
-		kurtosis += pow(lumDiff, 4.0) * relMaskHist.at(val);
-	}
-
-	skewness = pow(variance, -3.0) * skewness;
-	kurtosis = pow(variance, -4.0) * kurtosis;
-
 	// If you change mask rectangular size you will shoud change SKEW_OFFSET and KURT_OFFSET!
-	if ( NAN == skewness )
+	double skewness = t_skewness;
+	if ( false == qIsFinite(skewness) )
 	{
 		skewness = 0.5;
 	}
@@ -392,7 +1206,8 @@ void SourceImgPixels::CalcPixsSkewAndKurt(const unsigned int &t_width, const uns
 		}
 	}
 
-	if ( NAN == kurtosis )
+	double kurtosis = t_kurtosis;
+	if ( false == qIsFinite(kurtosis) )
 	{
 		kurtosis = 0.0;
 	}
@@ -411,35 +1226,15 @@ void SourceImgPixels::CalcPixsSkewAndKurt(const unsigned int &t_width, const uns
 		}
 	}
 
-	pixel->SetSkewness(skewness);
-	pixel->SetKurtosis(kurtosis);
-}
-
-// Calc relative mask histogram
-// @input:
-// - QList<double> - unempty mask histogram
-// - int - positive mask size
-// @output:
-// - QList<double> - mask histogram with relative values
-// - empty QList<double> - failed to calc relative values
-QList<double> SourceImgPixels::CalcRelativeMaskHist(const QList<double> &t_hist, const int &t_maskSize)
-{
-	if ( (true == t_hist.isEmpty()) || (t_maskSize <= 0) )
-	{
-		qDebug() << "CalcRelativeMaskHist(): Error - invalid arguments";
-		QList<double> empty;
-		return empty;
-	}
-
-	QList<double> relHist;
-	const int histSize = t_hist.size();
-	for ( int val = 0; val < histSize; ++val )
+	if ( (false == m_planes.AllocatePlane(Plane::SKEWNESS)) ||
+		 (false == m_planes.AllocatePlane(Plane::KURTOSIS)) )
 	{
-		double relValue = t_hist.at(val) / t_maskSize;
-		relHist.append(relValue);
+		qDebug() << "SetPixSkewAndKurt(): Error - can't allocate planes";
+		return;
 	}
 
-	return relHist;
+	m_planes.GetPlane(Plane::SKEWNESS)[t_index] = skewness;
+	m_planes.GetPlane(Plane::KURTOSIS)[t_index] = kurtosis;
 }
 
 // Calc relative mask histogram mean value
@@ -486,10 +1281,10 @@ double SourceImgPixels::CalcMaskHistVariance(const QList<double> &t_hist, const
 	for( int val = 0; val < histSize; ++val )
 	{
 		double relLum = val * RELATIVE_DIVIDER;
-		squareVariance += t_hist.at(val) * pow( relLum - t_histMean, 2 );
+		squareVariance += t_hist.at(val) * FastMath::Power( relLum - t_histMean, 2 );
 	}
 
-	double variance = pow(squareVariance, 0.5);
+	double variance = FastMath::SquareRoot(squareVariance);
 
 	return variance;
 }
@@ -508,8 +1303,13 @@ double SourceImgPixels::GetPixelsSkewness(const unsigned int &t_width, const uns
 		return RELATIVE_MIN;
 	}
 
-	const ColorPixel *pixel = (ColorPixel *)m_pixels[t_width][t_height];
-	return pixel->GetSkewness();
+	// Feature was not calculated yet
+	if ( false == m_planes.HasPlane(Plane::SKEWNESS) )
+	{
+		return RELATIVE_MIN;
+	}
+
+	return m_planes.GetPlane(Plane::SKEWNESS)[ PixIndex(t_width, t_height) ];
 }
 
 // Get Kurtosis of pixel with certain coords
@@ -526,8 +1326,13 @@ double SourceImgPixels::GetPixelsKurtosis(const unsigned int &t_width, const uns
 		return RELATIVE_MIN;
 	}
 
-	const ColorPixel *pixel = (ColorPixel *)m_pixels[t_width][t_height];
-	return pixel->GetKurtosis();
+	// Feature was not calculated yet
+	if ( false == m_planes.HasPlane(Plane::KURTOSIS) )
+	{
+		return RELATIVE_MIN;
+	}
+
+	return m_planes.GetPlane(Plane::KURTOSIS)[ PixIndex(t_width, t_height) ];
 }
 
 // Find among all pixels in image value of max relative luminance
@@ -544,16 +1349,13 @@ double SourceImgPixels::FindMaxRelLum() const
 	}
 
 	double maxLum = RELATIVE_MIN;
-	for ( unsigned int width = 0; width < m_width; width++ )
+	const PlaneValue *relLum = m_planes.GetPlane(Plane::REL_LUM);
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
 	{
-		for ( unsigned int height = 0; height < m_height; height++ )
+		if ( maxLum < relLum[pix] )
 		{
-			ColorPixel *pixel = (ColorPixel *)m_pixels[width][height];
-			double pixelLum = pixel->GetRelativeLum();
-			if ( maxLum < pixelLum )
-			{
-				maxLum = pixelLum;
-			}
+			maxLum = relLum[pix];
 		}
 	}
 
@@ -574,16 +1376,13 @@ double SourceImgPixels::FindMinRelLum() const
 	}
 
 	double minLum = RELATIVE_MAX;
-	for ( unsigned int width = 0; width < m_width; width++ )
+	const PlaneValue *relLum = m_planes.GetPlane(Plane::REL_LUM);
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
 	{
-		for ( unsigned int height = 0; height < m_height; height++ )
+		if ( relLum[pix] < minLum )
 		{
-			ColorPixel *pixel = (ColorPixel *)m_pixels[width][height];
-			double pixelLum = pixel->GetRelativeLum();
-			if ( pixelLum < minLum )
-			{
-				minLum = pixelLum;
-			}
+			minLum = relLum[pix];
 		}
 	}
 
@@ -604,13 +1403,11 @@ double SourceImgPixels::FindAverageRelLum() const
 	}
 
 	double averageLum = 0.0;
-	for ( unsigned int width = 0; width < m_width; width++ )
+	const PlaneValue *relLum = m_planes.GetPlane(Plane::REL_LUM);
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
 	{
-		for ( unsigned int height = 0; height < m_height; height++ )
-		{
-			ColorPixel *pixel = (ColorPixel *)m_pixels[width][height];
-			averageLum += pixel->GetRelativeLum();
-		}
+		averageLum += relLum[pix];
 	}
 
 	averageLum /= m_width * m_height;
@@ -640,17 +1437,14 @@ double SourceImgPixels::FindMostCommonRelLum() const
 	}
 
 	// Form statistic
-	for ( unsigned int width = 0; width < m_width; width++ )
+	const PlaneValue *relLum = m_planes.GetPlane(Plane::REL_LUM);
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
 	{
-		for ( unsigned int height = 0; height < m_height; height++ )
-		{
-			ColorPixel *pixel = (ColorPixel *)m_pixels[width][height];
-			double pixLum = pixel->GetRelativeLum();
-			double lumLvl = pixLum / RELATIVE_DIVIDER;
-			int lvlNum = (int)floor(lumLvl);
+		double lumLvl = relLum[pix] / RELATIVE_DIVIDER;
+		int lvlNum = (int)floor(lumLvl);
 
-			++lumStatistic[lvlNum];
-		}
+		++lumStatistic[lvlNum];
 	}
 
 	// Find number of most popular luminance level
@@ -706,10 +1500,12 @@ QList<double> SourceImgPixels::GetPixNeighborsRelLum(const unsigned int &t_width
 	unsigned int widthEnd = qMin( m_width, t_width + (unsigned int)offset + 1 );
 	unsigned int heightStart = (unsigned int)qMax( 0, minHeightCoord );
 	unsigned int heightEnd = qMin( m_height, t_height + (unsigned int)offset + 1 );
+	const PlaneValue *relLum = m_planes.GetPlane(Plane::REL_LUM);
 	QList<double> luminances;
-	for ( unsigned int width = widthStart; width < widthEnd; width++ )
+	for ( unsigned int height = heightStart; height < heightEnd; height++ )
 	{
-		for ( unsigned int height = heightStart; height < heightEnd; height++ )
+		const PlaneValue *rowLum = relLum + PixIndex(0, height);
+		for ( unsigned int width = widthStart; width < widthEnd; width++ )
 		{
 			if ( (width == t_width) && (height == t_height) )
 			{
@@ -718,9 +1514,7 @@ QList<double> SourceImgPixels::GetPixNeighborsRelLum(const unsigned int &t_width
 				continue;
 			}
 
-			ColorPixel *pixel = (ColorPixel *)m_pixels[width][height];
-			double pixelLum = pixel->GetRelativeLum();
-			luminances.append(pixelLum);
+			luminances.append(rowLum[width]);
 		}
 	}
 
@@ -867,3 +1661,185 @@ void SourceImgPixels::TestStatistic(const QList<int> t_stat) const
 
 	histFile.close();
 }
+
+// Compare SKO of pixels calculated by CalcPixelsSKO() with SKO calculated by CalcPixSKO() for each pixel
+// separately (pixels on borders of image are included)
+void SourceImgPixels::TestCalcPixelsSKO()
+{
+	bool pixelsFormed = FormTestPixels();
+	if ( false == pixelsFormed )
+	{
+		qDebug() << "Fail: Can't form image";
+		return;
+	}
+
+	CalcPixelsSKO();
+
+	QVector<PlaneValue> skoValues;
+	bool skoExported = ExportFeature(Feature::SKO, skoValues);
+	if ( false == skoExported )
+	{
+		qDebug() << "Fail: Can't calc SKO of pixels";
+		return;
+	}
+
+	double maxDiff = 0.0;
+	for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
+	{
+		for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
+		{
+			CalcPixSKO(wdt, hgt);
+
+			const double diff = fabs(GetPixelsSKO(wdt, hgt) - skoValues[PixIndex(wdt, hgt)]);
+			maxDiff = qMax(maxDiff, diff);
+		}
+	}
+
+	qDebug() << "TestCalcPixelsSKO(): max difference of SKO =" << maxDiff;
+}
+
+// Compare entropy of pixels calculated by CalcPixelsEntropy() (histograms of masks of ImgMaskHistogram) with
+// entropy calculated by CalcPixsEntropy() for each pixel separately (pixels on borders of image are included)
+void SourceImgPixels::TestCalcPixelsEntropy()
+{
+	bool pixelsFormed = FormTestPixels();
+	if ( false == pixelsFormed )
+	{
+		qDebug() << "Fail: Can't form image";
+		return;
+	}
+
+	CalcPixelsEntropy();
+
+	QVector<PlaneValue> entropyValues;
+	bool entropyExported = ExportFeature(Feature::ENTROPY, entropyValues);
+	if ( false == entropyExported )
+	{
+		qDebug() << "Fail: Can't calc entropy of pixels";
+		return;
+	}
+
+	double maxDiff = 0.0;
+	for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
+	{
+		for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
+		{
+			CalcPixsEntropy(wdt, hgt);
+
+			const double diff = fabs(GetPixelsEntropy(wdt, hgt) - entropyValues[PixIndex(wdt, hgt)]);
+			maxDiff = qMax(maxDiff, diff);
+		}
+	}
+
+	qDebug() << "TestCalcPixelsEntropy(): max difference of entropy =" << maxDiff;
+}
+
+// Compare skewness and kurtosis of pixels calculated by CalcPixelsSkewAndKurt() (integer power sums of
+// ImgMaskHistogram) with moments calculated from relative histogram of mask of each pixel separately (pixels on
+// borders of image are included)
+void SourceImgPixels::TestCalcPixelsSkewAndKurt()
+{
+	bool pixelsFormed = FormTestPixels();
+	if ( false == pixelsFormed )
+	{
+		qDebug() << "Fail: Can't form image";
+		return;
+	}
+
+	CalcPixelsSkewAndKurt();
+
+	QVector<PlaneValue> skewValues;
+	QVector<PlaneValue> kurtValues;
+	skewValues.resize(m_planes.GetPixelsNum());
+	kurtValues.resize(m_planes.GetPixelsNum());
+	for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
+	{
+		for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
+		{
+			skewValues[PixIndex(wdt, hgt)] = GetPixelsSkewness(wdt, hgt);
+			kurtValues[PixIndex(wdt, hgt)] = GetPixelsKurtosis(wdt, hgt);
+		}
+	}
+
+	const PlaneValue *relLum = m_planes.GetPlane(Plane::REL_LUM);
+	ImgHistogram histogramer;
+	double maxSkewDiff = 0.0;
+	double maxKurtDiff = 0.0;
+	for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
+	{
+		for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
+		{
+			const unsigned int index = PixIndex(wdt, hgt);
+			QList<double> lumInMask = GetPixNeighborsRelLum(wdt, hgt, m_featureMaskSides[Feature::SKEW_AND_KURT]);
+			lumInMask.append(relLum[index]);
+
+			QList<double> relMaskHist = histogramer.MaskRelLumHistogram(lumInMask);
+			const int relMaskHistSize = relMaskHist.size();
+			for ( int val = 0; val < relMaskHistSize; ++val )
+			{
+				relMaskHist[val] /= lumInMask.size();
+			}
+
+			double mean = CalcMaskHistMean(relMaskHist);
+			double variance = CalcMaskHistVariance(relMaskHist, mean);
+
+			double skewness = 0.0;
+			double kurtosis = 0.0;
+			for ( int val = 0; val < relMaskHistSize; ++val )
+			{
+				double lumDiff = val * RELATIVE_DIVIDER - mean;
+				skewness += pow(lumDiff, 3.0) * relMaskHist.at(val);
+				kurtosis += pow(lumDiff, 4.0) * relMaskHist.at(val);
+			}
+
+			skewness = pow(variance, -3.0) * skewness;
+			kurtosis = pow(variance, -4.0) * kurtosis;
+
+			SetPixSkewAndKurt(index, skewness, kurtosis);
+
+			maxSkewDiff = qMax(maxSkewDiff, fabs(GetPixelsSkewness(wdt, hgt) - skewValues[index]));
+			maxKurtDiff = qMax(maxKurtDiff, fabs(GetPixelsKurtosis(wdt, hgt) - kurtValues[index]));
+		}
+	}
+
+	qDebug() << "TestCalcPixelsSkewAndKurt(): max difference of skewness =" << maxSkewDiff;
+	qDebug() << "TestCalcPixelsSkewAndKurt(): max difference of kurtosis =" << maxKurtDiff;
+}
+
+// Form random pixels for tests. Half of rows have random colors, other rows have few levels of grey, so masks
+// have pixels with the same luminance and masks without variance.
+// @input:
+// @output:
+// - true - pixels formed and their relative luminance calculated
+// - false - failed to form pixels
+bool SourceImgPixels::FormTestPixels()
+{
+	const int width = 67;
+	const int height = 45;
+	QImage image(width, height, QImage::Format_RGB32);
+	for ( int hgt = 0; hgt < height; hgt++ )
+	{
+		for ( int wdt = 0; wdt < width; wdt++ )
+		{
+			if ( hgt < height / 2 )
+			{
+				image.setPixel(wdt, hgt, qRgb(rand() % 256, rand() % 256, rand() % 256));
+			}
+			else
+			{
+				const int grey = 64 * (rand() % 4) * (wdt / 16 % 2);
+				image.setPixel(wdt, hgt, qRgb(grey, grey, grey));
+			}
+		}
+	}
+
+	bool imgFormed = FormImgPixels(image);
+	if ( false == imgFormed )
+	{
+		return false;
+	}
+
+	TransAllPixRGB2LAB();
+
+	return true;
+}
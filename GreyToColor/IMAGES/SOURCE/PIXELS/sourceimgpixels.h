@@ -23,28 +23,83 @@
 #include <QTextStream>
 #include <QImage>
 #include <QDebug>
+#include <QVector>
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QThread>
+#include <QThreadPool>
+#include <qnumeric.h>
 
-#include "colorpixel.h"
 #include "../../COMMON/PIXELS/imagepixels.h"
+#include "./DEFINES/global.h"
+#include "./DEFINES/pixels.h"
 #include "./SERVICE/calculatorsko.h"
+#include "./SERVICE/IMAGES/imgmasksums.h"
+#include "./SERVICE/IMAGES/imgmaskhistogram.h"
+#include "./SERVICE/FILES/sourcemodelfile.h"
+#include "featuresbandtask.h"
 
 class SourceImgPixels : public ImagePixels
 {
 	// == DATA ==
+private:
+	// Number of threads for calculation of features (0 - number of processor cores)
+	static int s_threadsNum;
+	// Relative luminance of pixels, for which features were calculated
+	QVector<PlaneValue> m_featuresRelLum;
+	// Flags that features were calculated for relative luminance m_featuresRelLum
+	bool m_featuresActual[Feature::DEFAULT_LAST];
+	// Sides of masks, with which features are calculated
+	unsigned int m_featureMaskSides[Feature::DEFAULT_LAST];
+	// Affine transform of luminance from LAB, which gave m_featuresRelLum (see GetRelLumTransform())
+	double m_featuresLumScale;
+	double m_featuresLumShift;
+	bool m_featuresLumAffine;
 
 	// == METHODS ==
 public:
 	SourceImgPixels();
 	virtual ~SourceImgPixels();
 
+	// Set number of threads for calculation of features
+	static void SetThreadsNum(const int &t_threadsNum);
+	// Get number of threads for calculation of features
+	static int GetThreadsNum();
+
 	// Clear info about pixels (call this function before deleting object SourceImgPixels!)
 	virtual void Clear();
 	// Save all pixels from input QImage as custom pixels
 	virtual bool FormImgPixels(const QImage &t_img);
 	// Transform all image pixels from RGB color space to LAB
 	virtual void TransAllPixRGB2LAB();
+	// Get affine transform of relative luminance of pixels
+	virtual bool GetRelLumTransform(double &t_scale, double &t_shift) const;
 	// Get pixel relative luminance
 	double GetPixelsRelativeLum(const unsigned int &t_width, const unsigned int &t_height) const;
+	// Set side of mask, with which feature of pixels is calculated
+	bool SetFeatureMaskSide(const Feature::Type &t_feature, const unsigned int &t_maskRectSide);
+	// Get side of mask, with which feature of pixels is calculated
+	unsigned int GetFeatureMaskSide(const Feature::Type &t_feature) const;
+	// Calc features of pixels, which are not actual for current luminance
+	bool UpdatePixelsFeatures(const QList<Feature::Type> &t_features);
+	// Check if feature of pixels is actual for current luminance
+	bool HasActualFeature(const Feature::Type &t_feature) const;
+	// Get values of feature of all pixels
+	bool ExportFeature(const Feature::Type &t_feature, QVector<PlaneValue> &t_values) const;
+	// Set values of feature of all pixels (calculated earlier for the same luminance)
+	bool ImportFeature(const Feature::Type &t_feature, const QVector<PlaneValue> &t_values);
+	// Get hash of relative luminance of pixels
+	QByteArray GetRelLumHash() const;
+	// Set pixels and features from opened file of Source model
+	bool RestorePixels(const SourceModelFile &t_model);
+	// Calc for each pixel in image requested features in one pass
+	void CalcPixelsFeatures(const bool &t_sko, const bool &t_entropy, const bool &t_skewAndKurt);
+	// Calc requested features for pixels of band of rows
+	bool CalcBandFeatures(const unsigned int &t_firstRow,
+						  const unsigned int &t_lastRow,
+						  const bool &t_sko,
+						  const bool &t_entropy,
+						  const bool &t_skewAndKurt);
 	// Calc for each pixel in image it's SKO
 	void CalcPixelsSKO();
 	// Get SKO of pixel with certain coords
@@ -73,6 +128,12 @@ public:
 	// Find out what min and max values for skewness
 	void TestFindMaxSkewness();
 	void TestStatistic(const QList<int> t_stat) const;
+	// Compare SKO of pixels with SKO calculated for each pixel separately
+	void TestCalcPixelsSKO();
+	// Compare entropy of pixels with entropy calculated for each pixel separately
+	void TestCalcPixelsEntropy();
+	// Compare skewness and kurtosis of pixels with moments calculated for each pixel separately
+	void TestCalcPixelsSkewAndKurt();
 
 protected:
 	// Get list of relative luminances of neighbor pixels (to calc SKO, for example)
@@ -80,17 +141,38 @@ protected:
 										const unsigned int &t_height,
 										const unsigned int &t_maskRectSide) const;
 
-private:
 	// Calc relative LAB luminance
-	void CalcPixRelativeLum(const unsigned int &t_width, const unsigned int &t_height);
-	// Calc for certain pixel in image it's SKO
+	void CalcPixRelativeLum(const unsigned int &t_index);
+	// Set relative LAB luminance of pixel
+	bool SetPixRelativeLum(const unsigned int &t_index, const double &t_lum);
+
+private:
+	// Get planes of feature
+	QList<Plane::Type> GetFeaturePlanes(const Feature::Type &t_feature) const;
+	// Check if feature was calculated for current luminance of pixels
+	bool IsFeatureActual(const Feature::Type &t_feature) const;
+	// Check if current luminance of pixels is the same as luminance, for which features were calculated
+	bool IsFeaturesLumActual() const;
+	// Forget about calculated features
+	void ResetFeatures();
+	// Save current relative luminance as luminance of features
+	void SaveFeaturesLum();
+	// Transform features for current luminance, if it's affine transform of luminance of features
+	bool RescaleFeatures();
+	// Create histogram of masks of relative luminance for band of rows
+	bool InitBandHistogram(ImgMaskHistogram &t_hist,
+						   const unsigned int &t_maskRectSide,
+						   const unsigned int &t_firstRow,
+						   const unsigned int &t_lastRow,
+						   unsigned int &t_histFirstRow) const;
+	// Form random pixels for tests
+	bool FormTestPixels();
+	// Calc for certain pixel in image it's SKO (reference for TestCalcPixelsSKO())
 	void CalcPixSKO(const unsigned int &t_width, const unsigned int &t_height);
-	// Calc for certain pixel in image it's entropy
+	// Calc for certain pixel in image it's entropy (reference for TestCalcPixelsEntropy())
 	void CalcPixsEntropy(const unsigned int &t_width, const unsigned int &t_height);
-	// Calc for certain pixel in image it's Skewness and Kurtosis
-	void CalcPixsSkewAndKurt(const unsigned int &t_width, const unsigned int &t_height);
-	// Calc relative mask histogram
-	QList<double> CalcRelativeMaskHist(const QList<double> &t_hist, const int &t_maskSize);
+	// Normalise Skewness and Kurtosis of pixel and save them
+	void SetPixSkewAndKurt(const unsigned int &t_index, const double &t_skewness, const double &t_kurtosis);
 	// Calc relative mask histogram mean value
 	double CalcMaskHistMean(const QList<double> &t_hist);
 	// Calc relative mask histogram variance value
@@ -48,6 +48,7 @@ void SourceImage::Clear()
 {
 	m_img.Clear();
 	m_similarAreas.clear();
+	m_lookUpTable.Clear();
 
 	SourceImgPixels *pixels = (SourceImgPixels *)m_imgPixels;
 	if ( NULL != pixels )
@@ -101,6 +102,152 @@ double SourceImage::GetPixelsRelLum(const unsigned int &t_width, const unsigned
 	return pixels->GetPixelsRelativeLum(t_width, t_height);
 }
 
+// Set side of mask, with which feature of pixels is calculated
+// @input:
+// - Feature::Type - exist feature
+// - unsigned int - odd side of mask in range [FEATURE_MASK_MIN_SIDE, FEATURE_MASK_MAX_SIDE]
+// @output:
+// - true - side of mask is set
+// - false - invalid arguments
+bool SourceImage::SetFeatureMaskSide(const Feature::Type &t_feature, const unsigned int &t_maskRectSide)
+{
+	SourceImgPixels *pixels = (SourceImgPixels *)m_imgPixels;
+	return pixels->SetFeatureMaskSide(t_feature, t_maskRectSide);
+}
+
+// Get side of mask, with which feature of pixels is calculated
+// @input:
+// - Feature::Type - exist feature
+// @output:
+// - unsigned int - side of mask
+unsigned int SourceImage::GetFeatureMaskSide(const Feature::Type &t_feature) const
+{
+	const SourceImgPixels *pixels = (SourceImgPixels *)m_imgPixels;
+	return pixels->GetFeatureMaskSide(t_feature);
+}
+
+// Calc features of pixels, which are not actual for current luminance
+// @input:
+// - QList<Feature::Type> - features, which are needed
+// @output:
+// - true - all needed features are actual
+// - false - failed to calc features
+bool SourceImage::UpdatePixelsFeatures(const QList<Feature::Type> &t_features)
+{
+	SourceImgPixels *pixels = (SourceImgPixels *)m_imgPixels;
+	return pixels->UpdatePixelsFeatures(t_features);
+}
+
+// Check if feature of pixels is actual for current luminance
+// @input:
+// - Feature::Type - exist feature
+// @output:
+// - true - feature is actual
+// - false - feature should be calculated
+bool SourceImage::HasActualFeature(const Feature::Type &t_feature) const
+{
+	const SourceImgPixels *pixels = (SourceImgPixels *)m_imgPixels;
+	return pixels->HasActualFeature(t_feature);
+}
+
+// Get values of feature of all pixels
+// @input:
+// - Feature::Type - exist feature, which is actual for current luminance
+// - QVector<PlaneValue> - values of feature
+// @output:
+// - true - values of feature saved to t_values
+// - false - feature is not actual
+bool SourceImage::ExportFeature(const Feature::Type &t_feature, QVector<PlaneValue> &t_values) const
+{
+	const SourceImgPixels *pixels = (SourceImgPixels *)m_imgPixels;
+	return pixels->ExportFeature(t_feature, t_values);
+}
+
+// Set values of feature of all pixels (calculated earlier for the same luminance)
+// @input:
+// - Feature::Type - exist feature
+// - QVector<PlaneValue> - values of feature, got by ExportFeature() for the same relative luminance
+// @output:
+// - true - feature set
+// - false - invalid arguments
+bool SourceImage::ImportFeature(const Feature::Type &t_feature, const QVector<PlaneValue> &t_values)
+{
+	SourceImgPixels *pixels = (SourceImgPixels *)m_imgPixels;
+	return pixels->ImportFeature(t_feature, t_values);
+}
+
+// Get hash of relative luminance of pixels
+// @input:
+// @output:
+// - QByteArray - hash of relative luminance and size of image
+QByteArray SourceImage::GetRelLumHash() const
+{
+	const SourceImgPixels *pixels = (SourceImgPixels *)m_imgPixels;
+	return pixels->GetRelLumHash();
+}
+
+// Get look up table of pixels by relative luminance and SKO. Table is formed, if it was not formed (or restored
+// from Source model) for current luminance and SKO of pixels.
+// @input:
+// @output:
+// - const ImgLookUpTable * - look up table
+// - NULL - SKO of pixels is not actual or can't form table
+const ImgLookUpTable *SourceImage::GetLookUpTable()
+{
+	if ( (false == HasImage()) || (false == HasActualFeature(Feature::SKO)) )
+	{
+		qDebug() << "GetLookUpTable(): Error - Source image has no actual SKO";
+		return NULL;
+	}
+
+	const QByteArray tableKey = GetLookUpTableKey();
+	if ( true == m_lookUpTable.IsFormedFor(LAB_LUM_HIST_DIVIDER, SKO_DIVIDER, MAX_COORDS_PER_CELL, tableKey) )
+	{
+		return &m_lookUpTable;
+	}
+
+	bool tableFormed = m_lookUpTable.Form(GetPixelsPlane(Plane::REL_LUM),
+										  GetPixelsPlane(Plane::SKO),
+										  GetImageWidth(),
+										  GetImageHeight(),
+										  LAB_LUM_HIST_DIVIDER,
+										  SKO_DIVIDER,
+										  MAX_COORDS_PER_CELL,
+										  tableKey);
+
+	if ( false == tableFormed )
+	{
+		qDebug() << "GetLookUpTable(): Error - can't form look up table";
+		return NULL;
+	}
+
+	return &m_lookUpTable;
+}
+
+// Get key of data, for which look up table is formed
+// @input:
+// @output:
+// - QByteArray - key of relative luminance and mask of SKO of pixels
+QByteArray SourceImage::GetLookUpTableKey() const
+{
+	QByteArray tableKey = GetRelLumHash();
+	tableKey.append(QByteArray::number(GetFeatureMaskSide(Feature::SKO)));
+
+	return tableKey;
+}
+
+// Calc for each pixel in image requested features in one pass
+// @input:
+// - bool - calc SKO of pixels
+// - bool - calc entropy of pixels
+// - bool - calc skewness and kurtosis of pixels
+// @output:
+void SourceImage::CalcPixelsFeatures(const bool &t_sko, const bool &t_entropy, const bool &t_skewAndKurt)
+{
+	SourceImgPixels *pixels = (SourceImgPixels *)m_imgPixels;
+	pixels->CalcPixelsFeatures(t_sko, t_entropy, t_skewAndKurt);
+}
+
 // Calc for each pixel in image it's SKO
 // @input:
 // @output:
@@ -237,3 +384,101 @@ void SourceImage::TestFindCentral()
 	double commonLum = GetMostCommonRelLum();
 	qDebug() << "commonLum = " << commonLum;
 }
+
+// Load Source image from file of Source model. Image, pixels and look up table are restored from model without
+// decoding of image and calculation of features.
+// @input:
+// - QString - unempty path to file of model
+// @output:
+// - true - Source image loaded
+// - false - can't load model
+bool SourceImage::LoadModel(const QString &t_modelPath)
+{
+	SourceModelFile model;
+	if ( false == model.Open(t_modelPath) )
+	{
+		qDebug() << "LoadModel(): Error - can't open model" << t_modelPath;
+		return false;
+	}
+
+	const unsigned char *red = model.GetBytePlane(BytePlane::RED);
+	const unsigned char *green = model.GetBytePlane(BytePlane::GREEN);
+	const unsigned char *blue = model.GetBytePlane(BytePlane::BLUE);
+	if ( (NULL == red) || (NULL == green) || (NULL == blue) )
+	{
+		qDebug() << "LoadModel(): Error - model has no colors of image";
+		return false;
+	}
+
+	const unsigned int width = model.GetWidth();
+	const unsigned int height = model.GetHeight();
+	QImage image(width, height, QImage::Format_RGB32);
+	for ( unsigned int hgt = 0; hgt < height; hgt++ )
+	{
+		QRgb *imgLine = (QRgb *)image.scanLine(hgt);
+		const unsigned int rowStart = hgt * width;
+		for ( unsigned int wdt = 0; wdt < width; wdt++ )
+		{
+			const unsigned int index = rowStart + wdt;
+			imgLine[wdt] = qRgb(red[index], green[index], blue[index]);
+		}
+	}
+
+	Clear();
+
+	SourceImgPixels *pixels = (SourceImgPixels *)m_imgPixels;
+	if ( (false == pixels->RestorePixels(model)) || (false == m_img.SetImage(image)) )
+	{
+		qDebug() << "LoadModel(): Error - can't restore Source image";
+		Clear();
+		return false;
+	}
+
+	if ( (0 != model.GetLookUpMaskSide()) &&
+		 (false == model.RestoreLookUpTable(m_lookUpTable, GetLookUpTableKey())) )
+	{
+		qDebug() << "LoadModel(): Error - can't restore look up table";
+		Clear();
+		return false;
+	}
+
+	return true;
+}
+
+// Save Source image with all features and look up table to file of Source model. Features and table, which are
+// not actual, are calculated.
+// @input:
+// - QString - unempty path to file of model
+// @output:
+// - true - model saved
+// - false - can't save model
+bool SourceImage::SaveModel(const QString &t_modelPath)
+{
+	if ( (true == t_modelPath.isEmpty()) || (false == HasImage()) )
+	{
+		qDebug() << "SaveModel(): Error - invalid arguments";
+		return false;
+	}
+
+	QList<Feature::Type> features;
+	for ( int feature = 0; feature < Feature::DEFAULT_LAST; feature++ )
+	{
+		features.append( (Feature::Type)feature );
+	}
+
+	if ( false == UpdatePixelsFeatures(features) )
+	{
+		qDebug() << "SaveModel(): Error - can't calc features of image";
+		return false;
+	}
+
+	const ImgLookUpTable *lookUpTable = GetLookUpTable();
+	if ( NULL == lookUpTable )
+	{
+		qDebug() << "SaveModel(): Error - can't form look up table of image";
+		return false;
+	}
+
+	SourceModelFile model;
+	return model.Save(t_modelPath, this, lookUpTable);
+}
@@ -24,6 +24,9 @@
 #include "../COMMON/processingimage.h"
 #include "../SOURCE/PIXELS/sourceimgpixels.h"
 #include "./DEFINES/images.h"
+#include "./DEFINES/pixels.h"
+#include "./DEFINES/colorization.h"
+#include "./SERVICE/IMAGES/imglookuptable.h"
 
 // Class SourceImage
 // This class represents an image, that in colorization process provides color information.
@@ -32,6 +35,9 @@
 class SourceImage : public ProcessingImage
 {
 	// == DATA ==
+private:
+	// Pixels by relative luminance and SKO (formed on demand or restored from Source model)
+	ImgLookUpTable m_lookUpTable;
 
 	// == METHODS ==
 public:
@@ -44,6 +50,28 @@ public:
 	virtual void TransformImgRGB2LAB();
 	// Get relative luminance of pixel with certain coords
 	double GetPixelsRelLum(const unsigned int &t_width, const unsigned int &t_height) const;
+	// Set side of mask, with which feature of pixels is calculated
+	bool SetFeatureMaskSide(const Feature::Type &t_feature, const unsigned int &t_maskRectSide);
+	// Get side of mask, with which feature of pixels is calculated
+	unsigned int GetFeatureMaskSide(const Feature::Type &t_feature) const;
+	// Calc features of pixels, which are not actual for current luminance
+	bool UpdatePixelsFeatures(const QList<Feature::Type> &t_features);
+	// Check if feature of pixels is actual for current luminance
+	bool HasActualFeature(const Feature::Type &t_feature) const;
+	// Get values of feature of all pixels
+	bool ExportFeature(const Feature::Type &t_feature, QVector<PlaneValue> &t_values) const;
+	// Set values of feature of all pixels (calculated earlier for the same luminance)
+	bool ImportFeature(const Feature::Type &t_feature, const QVector<PlaneValue> &t_values);
+	// Get hash of relative luminance of pixels
+	QByteArray GetRelLumHash() const;
+	// Get look up table of pixels by relative luminance and SKO
+	const ImgLookUpTable *GetLookUpTable();
+	// Load Source image from file of Source model
+	bool LoadModel(const QString &t_modelPath);
+	// Save Source image with all features to file of Source model
+	bool SaveModel(const QString &t_modelPath);
+	// Calc for each pixel in image requested features in one pass
+	void CalcPixelsFeatures(const bool &t_sko, const bool &t_entropy, const bool &t_skewAndKurt);
 	// Calc for each pixel in image it's SKO
 	void CalcPixelsSKO();
 	// Get SKO of pixel with certain coords
@@ -75,6 +103,8 @@ public:
 private:
 	// Construct custom pixels of loaded image
 	virtual void ConstructImgPixels();
+	// Get key of data, for which look up table is formed
+	QByteArray GetLookUpTableKey() const;
 };
 
 #endif // SOURCEIMAGE_H
@@ -34,66 +34,184 @@ TargetImgPixels::~TargetImgPixels()
 // @output:
 void TargetImgPixels::Clear()
 {
-	const int pixWidth = m_pixels.size();
-	for ( int width = pixWidth - 1; width >= 0; --width )
+	SourceImgPixels::Clear();
+	m_prefColors.clear();
+	m_resultImg = QImage();
+	m_dirtyRows.clear();
+	ResetRelLumTransform();
+}
+
+// Save all pixels from input QImage as custom grey pixels
+// @input:
+// - QImage - unnull image
+// @output:
+bool TargetImgPixels::FormImgPixels(const QImage &t_img)
+{
+	m_prefColors.clear();
+
+	bool pixelsFormed = SourceImgPixels::FormImgPixels(t_img);
+	if ( false == pixelsFormed )
+	{
+		qDebug() << "FormImgPixels(): Error - can't form pixels of image";
+		return false;
+	}
+
+	TransAllPixToGrey();
+	SetAllRowsDirty();
+
+	return true;
+}
+
+// Transform colors of all pixels to grey
+// @input:
+// @output:
+void TargetImgPixels::TransAllPixToGrey()
+{
+	unsigned char *red = m_planes.GetBytePlane(BytePlane::RED);
+	unsigned char *green = m_planes.GetBytePlane(BytePlane::GREEN);
+	unsigned char *blue = m_planes.GetBytePlane(BytePlane::BLUE);
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
 	{
-		int pixHeight = m_pixels.at(width).size();
-		for ( int height = pixHeight - 1; height >= 0; --height )
+		if ( (red[pix] == green[pix]) && (red[pix] == blue[pix]) )
 		{
-			TargetPixel *pix = (TargetPixel *)m_pixels[width][height];
-			if ( NULL != pix )
-			{
-				delete pix;
-			}
+			continue;
 		}
 
-		m_pixels[width].clear();
-	}
+		// The same as RGB::ToGrey()
+		double greyLum = 0.0;
+		greyLum += 0.2126 * red[pix];
+		greyLum += 0.7152 * green[pix];
+		greyLum += 0.0722 * blue[pix];
+		const unsigned char grey = (unsigned char)floor(greyLum + 0.5);
 
-	m_pixels.clear();
+		red[pix] = grey;
+		green[pix] = grey;
+		blue[pix] = grey;
+	}
 }
 
-// Save all pixels from input QImage as custom grey pixels
+// Transform all image pixels from RGB color space to LAB
 // @input:
-// - QImage - unnull image
 // @output:
-bool TargetImgPixels::FormImgPixels(const QImage &t_img)
+void TargetImgPixels::TransAllPixRGB2LAB()
 {
-	if ( true == t_img.isNull() )
+	if ( true == m_planes.IsEmpty() )
 	{
-		qDebug() << "FormImgPixels(): Error - invalid arguments";
-		return false;
+		return;
+	}
+
+	// Target pixels are grey, so their LAB values depend only on grey level. Calc them once for each level
+	// and then just copy to pixels.
+	unsigned char levels[RGB_CHANNEL_LEVELS];
+	for ( int lvl = 0; lvl < RGB_CHANNEL_LEVELS; lvl++ )
+	{
+		levels[lvl] = (unsigned char)lvl;
 	}
 
-	m_width = t_img.width();
-	m_height = t_img.height();
+	double levelLum[RGB_CHANNEL_LEVELS];
+	double levelChA[RGB_CHANNEL_LEVELS];
+	double levelChB[RGB_CHANNEL_LEVELS];
+	double levelRelLum[RGB_CHANNEL_LEVELS];
 
-	for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
+	RGBLAB transformer;
+	transformer.RGB2LABRow(levels, levels, levels, levelLum, levelChA, levelChB, RGB_CHANNEL_LEVELS);
+
+	for ( int lvl = 0; lvl < RGB_CHANNEL_LEVELS; lvl++ )
 	{
-		QList<Pixel *> columnOfPixels;
+		// The same as CalcPixRelativeLum()
+		levelRelLum[lvl] = levelLum[lvl] / LAB_MAX_LUM;
+		if ( levelRelLum[lvl] < RELATIVE_MIN )
+		{
+			levelRelLum[lvl] = RELATIVE_MIN;
+		}
+	}
 
-		for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
+	const unsigned char *red = m_planes.GetBytePlane(BytePlane::RED);
+	const unsigned char *green = m_planes.GetBytePlane(BytePlane::GREEN);
+	const unsigned char *blue = m_planes.GetBytePlane(BytePlane::BLUE);
+	PlaneValue *lum = m_planes.GetPlane(Plane::LUM);
+	PlaneValue *chA = m_planes.GetPlane(Plane::CH_A);
+	PlaneValue *chB = m_planes.GetPlane(Plane::CH_B);
+	PlaneValue *relLum = m_planes.GetPlane(Plane::REL_LUM);
+
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
+	{
+		const unsigned char grey = red[pix];
+		if ( (grey != green[pix]) || (grey != blue[pix]) )
 		{
-			QRgb pixel = t_img.pixel(wdt, hgt);
+			// Pixel was coloured after forming: transform it in usual way
+			TransformPixRGB2LAB(pix);
+			CalcPixRelativeLum(pix);
+			continue;
+		}
 
-			RGB rgbPixel;
-			bool colorOK = rgbPixel.SetColor(qRed(pixel), qGreen(pixel), qBlue(pixel));
-			if ( false == colorOK )
-			{
-				qDebug() << "FormImgPixels(): pixel with coords (" << wdt << "," << hgt <<
-							") has problems with RGB channels: invalid value";
-			}
+		lum[pix] = levelLum[grey];
+		chA[pix] = levelChA[grey];
+		chB[pix] = levelChB[grey];
+		relLum[pix] = levelRelLum[grey];
+	}
 
-			TargetPixel *targetPix = new TargetPixel;
-			targetPix->SetAsGrey(rgbPixel);
+	SetAllRowsDirty();
+	ResetRelLumTransform();
+}
 
-			columnOfPixels.append(targetPix);
-		}
+// Set value for channels A and B of pixel with certain coords
+// @input:
+// - unsigned int - exist width (x) position of pixel
+// - unsigned int - exist height (y) position of pixel
+// - double - value for pixels channel A
+// - double - value for pixels channel B
+// @output:
+void TargetImgPixels::SetPixChannelsAB(const unsigned int &t_width,
+									   const unsigned int &t_height,
+									   const double &t_chA,
+									   const double &t_chB)
+{
+	SourceImgPixels::SetPixChannelsAB(t_width, t_height, t_chA, t_chB);
 
-		m_pixels.append(columnOfPixels);
+	if ( t_height < (unsigned int)m_dirtyRows.size() )
+	{
+		m_dirtyRows[t_height] = true;
 	}
+}
 
-	return true;
+// Set flags that LAB values of all rows were changed
+// @input:
+// @output:
+void TargetImgPixels::SetAllRowsDirty()
+{
+	m_dirtyRows.clear();
+	for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
+	{
+		m_dirtyRows.append(true);
+	}
+}
+
+// Set that relative luminance of pixels is the same as luminance from LAB
+// @input:
+// @output:
+void TargetImgPixels::ResetRelLumTransform()
+{
+	m_relLumScale = 1.0;
+	m_relLumShift = 0.0;
+	m_relLumAffine = true;
+}
+
+// Get affine transform of relative luminance of pixels
+// @input:
+// - double - scale of relative luminance
+// - double - shift of relative luminance
+// @output:
+// - true - relative luminance = luminance from LAB * scale + shift
+// - false - relative luminance was transformed not linearly (or it was clipped)
+bool TargetImgPixels::GetRelLumTransform(double &t_scale, double &t_shift) const
+{
+	t_scale = m_relLumScale;
+	t_shift = m_relLumShift;
+
+	return m_relLumAffine;
 }
 
 // Scale relative luminance of all pixels in image with certain scale factor
@@ -104,22 +222,45 @@ bool TargetImgPixels::FormImgPixels(const QImage &t_img)
 // - false - can't scale relative luminance
 bool TargetImgPixels::ScaleRelLum(const double &t_scaleFactor)
 {
-	for ( unsigned int width = 0; width < m_width; width++ )
+	if ( t_scaleFactor <= 0 )
 	{
-		for ( unsigned int height = 0; height < m_height; height++ )
+		qDebug() << "ScaleRelLum(): Error - invalid scale factor" << t_scaleFactor;
+		qDebug() << "Luminance restored!";
+		RestoreRelLum();
+		return false;
+	}
+
+	bool lumClipped = false;
+	const PlaneValue *relLum = m_planes.GetPlane(Plane::REL_LUM);
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
+	{
+		// We don't want to scale luminance of pixel twice
+		CalcPixRelativeLum(pix);
+
+		double scaledLum = relLum[pix] * t_scaleFactor;
+		if ( RELATIVE_MAX < scaledLum )
+		{
+			scaledLum = RELATIVE_MAX;
+			lumClipped = true;
+		}
+
+		bool pixelScaled = SetPixRelativeLum(pix, scaledLum);
+		if ( false == pixelScaled )
 		{
-			TargetPixel *pixel = (TargetPixel *)m_pixels[width][height];
-			bool pixelScaled = pixel->ScaleRelLum(t_scaleFactor);
-			if ( false == pixelScaled )
-			{
-				qDebug() << "ScaleRelLum(): Error - can't scale relative luminance for pixel" << width << height;
-				qDebug() << "Luminance restored!";
-				RestoreRelLum();
-				return false;
-			}
+			qDebug() << "ScaleRelLum(): Error - can't scale relative luminance for pixel" <<
+						pix % m_width << pix / m_width;
+
+			qDebug() << "Luminance restored!";
+			RestoreRelLum();
+			return false;
 		}
 	}
 
+	m_relLumScale = t_scaleFactor;
+	m_relLumShift = 0.0;
+	m_relLumAffine = ( false == lumClipped );
+
 	return true;
 }
 
@@ -128,14 +269,13 @@ bool TargetImgPixels::ScaleRelLum(const double &t_scaleFactor)
 // @output:
 void TargetImgPixels::RestoreRelLum()
 {
-	for ( unsigned int width = 0; width < m_width; width++ )
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
 	{
-		for ( unsigned int height = 0; height < m_height; height++ )
-		{
-			TargetPixel *pixel = (TargetPixel *)m_pixels[width][height];
-			pixel->RestoreRelLum();
-		}
+		CalcPixRelativeLum(pix);
 	}
+
+	ResetRelLumTransform();
 }
 
 // Normalise pixels relative luminances by min/max borders
@@ -173,28 +313,28 @@ bool TargetImgPixels::NormaliseRelLumByBorders(const double &t_newMinRelLum, con
 		scaleFactor = 1.0;
 	}
 
-	for ( unsigned int width = 0; width < m_width; width++ )
+	const PlaneValue *relLumPlane = m_planes.GetPlane(Plane::REL_LUM);
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
 	{
-		for ( unsigned int height = 0; height < m_height; height++ )
-		{
-			TargetPixel *pixel = (TargetPixel *)m_pixels[width][height];
-			double relLum = pixel->GetRelativeLum();
+		double relLum = (relLumPlane[pix] - currMinLum) * scaleFactor + t_newMinRelLum;
 
-			relLum = (relLum - currMinLum) * scaleFactor + t_newMinRelLum;
-
-			bool pixNormalised = pixel->SetNormalizedRelLum(relLum);
-			if ( false == pixNormalised )
-			{
-				qDebug() << "NormaliseRelLumByBorders(): Error - can't normalize relative luminance for pixel" <<
-							width << height;
+		bool pixNormalised = SetPixRelativeLum(pix, relLum);
+		if ( false == pixNormalised )
+		{
+			qDebug() << "NormaliseRelLumByBorders(): Error - can't normalize relative luminance for pixel" <<
+						pix % m_width << pix / m_width;
 
-				qDebug() << "Luminance restored!";
-				RestoreRelLum();
-				return false;
-			}
+			qDebug() << "Luminance restored!";
+			RestoreRelLum();
+			return false;
 		}
 	}
 
+	// New luminance is affine transform of current luminance
+	m_relLumShift = (m_relLumShift - currMinLum) * scaleFactor + t_newMinRelLum;
+	m_relLumScale *= scaleFactor;
+
 	return true;
 }
 
@@ -249,35 +389,35 @@ bool TargetImgPixels::NormaliseRelLumByCenter(const double &t_newMinRelLum,
 		return false;
 	}
 
-	for ( unsigned int width = 0; width < m_width; width++ )
+	const PlaneValue *relLumPlane = m_planes.GetPlane(Plane::REL_LUM);
+	const unsigned int pixelsNum = m_planes.GetPixelsNum();
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
 	{
-		for ( unsigned int height = 0; height < m_height; height++ )
+		double relLum = relLumPlane[pix];
+		if ( relLum <= currCommonLum )
+		{
+			relLum = (relLum - currMinLum) * scaleFactorLA + t_newMinRelLum;
+		}
+		else
+		{
+			relLum = (relLum - currCommonLum) * scaleFactorUA + t_newCenterRelLum;
+		}
+
+		bool pixNormalised = SetPixRelativeLum(pix, relLum);
+		if ( false == pixNormalised )
 		{
-			TargetPixel *pixel = (TargetPixel *)m_pixels[width][height];
-			double relLum = pixel->GetRelativeLum();
-
-			if ( relLum <= currCommonLum )
-			{
-				relLum = (relLum - currMinLum) * scaleFactorLA + t_newMinRelLum;
-			}
-			else
-			{
-				relLum = (relLum - currCommonLum) * scaleFactorUA + t_newCenterRelLum;
-			}
-
-			bool pixNormalised = pixel->SetNormalizedRelLum(relLum);
-			if ( false == pixNormalised )
-			{
-				qDebug() << "NormaliseRelLumByCenter(): Error - can't normalize luminance for pixel" <<
-							width << height;
-
-				qDebug() << "Luminance restored!";
-				RestoreRelLum();
-				return false;
-			}
+			qDebug() << "NormaliseRelLumByCenter(): Error - can't normalize luminance for pixel" <<
+						pix % m_width << pix / m_width;
+
+			qDebug() << "Luminance restored!";
+			RestoreRelLum();
+			return false;
 		}
 	}
 
+	// Lower and upper areas are scaled with different factors
+	m_relLumAffine = false;
+
 	return true;
 }
 
@@ -297,8 +437,42 @@ void TargetImgPixels::SetPixPreferedColor(const unsigned int &t_width,
 		return;
 	}
 
-	TargetPixel *pixel = (TargetPixel *)m_pixels[t_width][t_height];
-	pixel->SetPreferedColor(t_prefColor);
+	m_prefColors.insert(PixIndex(t_width, t_height), t_prefColor);
+}
+
+// Check if pixel has prefered color
+// @input:
+// - unsigned int - exist width (x) position of pixel
+// - unsigned int - exist height (y) position of pixel
+// @output:
+// - true - pixel has prefered color
+// - false - pixel doesn't have prefered color
+bool TargetImgPixels::HasPixPreferedColor(const unsigned int &t_width, const unsigned int &t_height) const
+{
+	if ( false == IsPixelExist(t_width, t_height) )
+	{
+		qDebug() << "HasPixPreferedColor(): Error - invalid arguments";
+		return false;
+	}
+
+	return m_prefColors.contains( PixIndex(t_width, t_height) );
+}
+
+// Get prefered color of pixel
+// @input:
+// - unsigned int - exist width (x) position of pixel
+// - unsigned int - exist height (y) position of pixel
+// @output:
+// - RGB - prefered color of pixel (black if pixel doesn't have prefered color)
+RGB TargetImgPixels::GetPixPreferedColor(const unsigned int &t_width, const unsigned int &t_height) const
+{
+	if ( false == IsPixelExist(t_width, t_height) )
+	{
+		qDebug() << "GetPixPreferedColor(): Error - invalid arguments";
+		return RGB();
+	}
+
+	return m_prefColors.value( PixIndex(t_width, t_height) );
 }
 
 // Set flag that pixel coloured
@@ -308,8 +482,7 @@ void TargetImgPixels::SetPixPreferedColor(const unsigned int &t_width,
 // @output:
 void TargetImgPixels::SetPixColoured(const unsigned int &t_width, const unsigned int &t_height)
 {
-	TargetPixel *pixel = (TargetPixel *)m_pixels[t_width][t_height];
-	pixel->SetColored();
+	m_planes.GetBytePlane(BytePlane::COLORED)[ PixIndex(t_width, t_height) ] = 1;
 }
 
 // Set flag that pixel uncoloured
@@ -317,14 +490,7 @@ void TargetImgPixels::SetPixColoured(const unsigned int &t_width, const unsigned
 // @output:
 void TargetImgPixels::SetPixelsUncoloured()
 {
-	for ( unsigned int width = 0; width < m_width; width++ )
-	{
-		for ( unsigned int height = 0; height < m_height; height++ )
-		{
-			TargetPixel *pixel = (TargetPixel *)m_pixels[width][height];
-			pixel->SetUncolored();
-		}
-	}
+	m_planes.FillBytePlane(BytePlane::COLORED, 0);
 }
 
 // Check if pixel is coloured
@@ -334,8 +500,12 @@ void TargetImgPixels::SetPixelsUncoloured()
 // @output:
 bool TargetImgPixels::IsPixColoured(const unsigned int &t_width, const unsigned int &t_height) const
 {
-	TargetPixel *pixel = (TargetPixel *)m_pixels[t_width][t_height];
-	return pixel->IsColored();
+	if ( 0 == m_planes.GetBytePlane(BytePlane::COLORED)[ PixIndex(t_width, t_height) ] )
+	{
+		return false;
+	}
+
+	return true;
 }
 
 // Form from current pixels values entire QImage
@@ -352,22 +522,40 @@ QImage TargetImgPixels::FormImage()
 		return empty;
 	}
 
-	QImage outputImg(m_width, m_height, QImage::Format_RGB32);
-	RGB pixelRGB;
-	for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
+	if ( (true == m_resultImg.isNull()) ||
+		 ((int)m_width != m_resultImg.width()) ||
+		 ((int)m_height != m_resultImg.height()) )
 	{
-		for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
+		m_resultImg = QImage(m_width, m_height, QImage::Format_RGB32);
+		SetAllRowsDirty();
+	}
+
+	const unsigned char *red = m_planes.GetBytePlane(BytePlane::RED);
+	const unsigned char *green = m_planes.GetBytePlane(BytePlane::GREEN);
+	const unsigned char *blue = m_planes.GetBytePlane(BytePlane::BLUE);
+
+	// Only rows with changed LAB values are transformed to RGB and written to image
+	for ( unsigned int hgt = 0; hgt < m_height; hgt++ )
+	{
+		if ( false == m_dirtyRows.at(hgt) )
 		{
-			pixelRGB = m_pixels[wdt][hgt]->GetRGB();
-			QRgb pixel = qRgb(pixelRGB.GetRed(),
-							  pixelRGB.GetGreen(),
-							  pixelRGB.GetBlue());
+			continue;
+		}
+
+		const unsigned int rowStart = PixIndex(0, hgt);
+		TransformPixelsLAB2RGB(rowStart, m_width);
 
-			outputImg.setPixel(wdt, hgt, pixel);
+		QRgb *line = (QRgb *)m_resultImg.scanLine(hgt);
+		for ( unsigned int wdt = 0; wdt < m_width; wdt++ )
+		{
+			const unsigned int index = rowStart + wdt;
+			line[wdt] = qRgb(red[index], green[index], blue[index]);
 		}
+
+		m_dirtyRows[hgt] = false;
 	}
 
-	return outputImg;
+	return m_resultImg;
 }
 
 // Test functions
@@ -394,15 +582,14 @@ void TargetImgPixels::TestFunctionality()
 
 	TransAllPixRGB2LAB();
 
-	TargetPixel *pixel = (TargetPixel *)m_pixels[0][0];
-	qDebug() << "Before scaling:" << pixel->GetChL();
+	qDebug() << "Before scaling:" << GetPixChLum(0, 0);
 
 	double scaleFactor = 1.5;
 	ScaleRelLum(scaleFactor);
-	qDebug() << "After scaling:" << pixel->GetChL();
+	qDebug() << "After scaling:" << GetPixChLum(0, 0);
 
 	RestoreRelLum();
-	qDebug() << "After unscaling:" << pixel->GetChL();
+	qDebug() << "After unscaling:" << GetPixChLum(0, 0);
 }
 
 // Test Calc SKO
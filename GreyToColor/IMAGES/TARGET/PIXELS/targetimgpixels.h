@@ -21,13 +21,25 @@
 
 #include <QFileDialog>
 #include <QElapsedTimer>
+#include <QHash>
 
 #include "../../SOURCE/PIXELS/sourceimgpixels.h"
-#include "targetpixel.h"
 
 class TargetImgPixels : public SourceImgPixels
 {
 	// == DATA ==
+private:
+	// Prefered colors of pixels. Key - index of pixel. Only few pixels have prefered color, so we save only them
+	QHash<unsigned int, RGB> m_prefColors;
+	// Image formed from pixels at last call of FormImage()
+	QImage m_resultImg;
+	// Flags of rows, which LAB values were changed after last call of FormImage()
+	QList<bool> m_dirtyRows;
+	// Relative luminance of pixels is affine transform of luminance from LAB:
+	// rel lum = LAB rel lum * m_relLumScale + m_relLumShift (if m_relLumAffine is true)
+	double m_relLumScale;
+	double m_relLumShift;
+	bool m_relLumAffine;
 
 	// == METHODS ==
 public:
@@ -38,6 +50,16 @@ public:
 	virtual void Clear();
 	// Save all pixels from input QImage as custom pixels
 	virtual bool FormImgPixels(const QImage &t_img);
+	// Transform all image pixels from RGB color space to LAB
+	virtual void TransAllPixRGB2LAB();
+	// Set value for channels A and B of pixel with certain coords
+	virtual void SetPixChannelsAB(const unsigned int &t_width,
+								  const unsigned int &t_height,
+								  const double &t_chA,
+								  const double &t_chB);
+	// Get affine transform of relative luminance of pixels
+	virtual bool GetRelLumTransform(double &t_scale, double &t_shift) const;
+
 	// Scale relative luminance of all pixels in image with certain scale factor
 	bool ScaleRelLum(const double &t_scaleFactor);
 	// Restore original relative luminance of all pixels in image
@@ -53,6 +75,10 @@ public:
 	void SetPixPreferedColor(const unsigned int &t_width,
 							 const unsigned int &t_height,
 							 const RGB &t_prefColor);
+	// Check if pixel has prefered color
+	bool HasPixPreferedColor(const unsigned int &t_width, const unsigned int &t_height) const;
+	// Get prefered color of pixel
+	RGB GetPixPreferedColor(const unsigned int &t_width, const unsigned int &t_height) const;
 
 	// Set flag that pixel coloured
 	void SetPixColoured(const unsigned int &t_width, const unsigned int &t_height);
@@ -60,13 +86,20 @@ public:
 	void SetPixelsUncoloured();
 	// Check if pixel is coloured
 	bool IsPixColoured(const unsigned int &t_width, const unsigned int &t_height) const;
-	// Form from current pixels values entire QImage
+	// Form from current LAB values of pixels entire QImage
 	QImage FormImage();
 
 	// Test functions
 	void TestFunctionality();
 	// Test Calc SKO
 	void TestSKO();
+private:
+	// Transform colors of all pixels to grey
+	void TransAllPixToGrey();
+	// Set flags that LAB values of all rows were changed
+	void SetAllRowsDirty();
+	// Set that relative luminance of pixels is the same as luminance from LAB
+	void ResetRelLumTransform();
 };
 
 #endif // TRAGETIMGPIXELS_H
@@ -148,6 +148,31 @@ void TargetImage::SetPixPrefColor(const unsigned int &t_width,
 								t_prefColor);
 }
 
+// Check if pixel has prefered color
+// @input:
+// - unsigned int - exist width (x) position of pixel
+// - unsigned int - exist height (y) position of pixel
+// @output:
+// - true - pixel has prefered color
+// - false - pixel doesn't have prefered color
+bool TargetImage::HasPixPrefColor(const unsigned int &t_width, const unsigned int &t_height) const
+{
+	TargetImgPixels *pixels = (TargetImgPixels *)m_imgPixels;
+	return pixels->HasPixPreferedColor(t_width, t_height);
+}
+
+// Get prefered color of pixel
+// @input:
+// - unsigned int - exist width (x) position of pixel
+// - unsigned int - exist height (y) position of pixel
+// @output:
+// - RGB - prefered color of pixel (black if pixel doesn't have prefered color)
+RGB TargetImage::GetPixPrefColor(const unsigned int &t_width, const unsigned int &t_height) const
+{
+	TargetImgPixels *pixels = (TargetImgPixels *)m_imgPixels;
+	return pixels->GetPixPreferedColor(t_width, t_height);
+}
+
 // Set flag that pixel colored
 // @input:
 // - unsigned int - exist width (x) position of pixel
@@ -194,9 +219,7 @@ Image TargetImage::GetResultImage()
 		return empty;
 	}
 
-	// Transform LAB pixels to new RGB pixels (maybe we have changed LAB pixel so we need to update RGB pixel)
-	TransformImgLAB2GRB();
-
+	// Pixels transform to RGB only those rows, which LAB values were changed since last call
 	TargetImgPixels *pixels = (TargetImgPixels *)m_imgPixels;
 	QImage formedImg = pixels->FormImage();
 	if ( true == formedImg.isNull() )
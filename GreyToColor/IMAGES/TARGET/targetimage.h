@@ -55,6 +55,10 @@ public:
 	void SetPixPrefColor(const unsigned int &t_width,
 						 const unsigned int &t_height,
 						 const RGB &t_prefColor);
+	// Check if pixel has prefered color
+	bool HasPixPrefColor(const unsigned int &t_width, const unsigned int &t_height) const;
+	// Get prefered color of pixel
+	RGB GetPixPrefColor(const unsigned int &t_width, const unsigned int &t_height) const;
 
 	// Set flag that pixel colored
 	void SetPixColoured(const unsigned int &t_width, const unsigned int &t_height);
@@ -35,6 +35,69 @@ void Colorizator::Clear()
 {
 	m_target = NULL;
 	m_source = NULL;
+	m_matcher = Matcher::RANDOM;
+	m_sourceIndex = &m_ownSourceIndex;
+	m_sourceSortedIndex = &m_ownSourceSortedIndex;
+	m_matcherWindow = MATCHER_WINDOW_WIDTH;
+	m_matcherMaxChecks = INDEX_SEARCH_MAX_CHECKS;
+	m_ownSourceIndex.Clear();
+	m_ownSourceSortedIndex.Clear();
+}
+
+// Set way to find Source pixel, most similar to Target pixel
+// @input:
+// - Matcher::Type - exist type of matcher
+// - ImgFeaturesIndex - index of features of Source images, which is kept between colorizations (or NULL to use
+// own index of colorizator). It's rebuilt only if it was built for other Source image
+// - ImgLumSortedIndex - the same for index of Source pixels, sorted by luminance
+// @output:
+void Colorizator::SetMatcher(const Matcher::Type &t_type,
+							 ImgFeaturesIndex *t_sourceIndex,
+							 ImgLumSortedIndex *t_sourceSortedIndex)
+{
+	if ( Matcher::DEFAULT_LAST == t_type )
+	{
+		qDebug() << "SetMatcher(): Error - invalid arguments";
+		return;
+	}
+
+	m_matcher = t_type;
+	m_sourceIndex = &m_ownSourceIndex;
+	if ( NULL != t_sourceIndex )
+	{
+		m_sourceIndex = t_sourceIndex;
+	}
+
+	m_sourceSortedIndex = &m_ownSourceSortedIndex;
+	if ( NULL != t_sourceSortedIndex )
+	{
+		m_sourceSortedIndex = t_sourceSortedIndex;
+	}
+}
+
+// Set number of Source pixels checked by matcher with window
+// @input:
+// - unsigned int - positive number of pixels
+// @output:
+void Colorizator::SetMatcherWindow(const unsigned int &t_windowWidth)
+{
+	if ( 0 == t_windowWidth )
+	{
+		qDebug() << "SetMatcherWindow(): Error - invalid arguments";
+		return;
+	}
+
+	m_matcherWindow = t_windowWidth;
+}
+
+// Set max number of Source pixels checked by indexed matcher. Approximate search is faster, but found pixel
+// could be not the most similar one.
+// @input:
+// - unsigned int - number of pixels (0 - exact search)
+// @output:
+void Colorizator::SetMatcherMaxChecks(const unsigned int &t_maxChecks)
+{
+	m_matcherMaxChecks = t_maxChecks;
 }
 
 // Scale Target Image luminance
@@ -51,3 +114,122 @@ bool Colorizator::EquliseTargetImgLum(const LumEqualization::Type &t_type)
 
 	return targImgLumScaled;
 }
+
+// Calc features of pixels of Target and Source images, which are needed by method (if they are not actual)
+// @input:
+// @output:
+// - true - features are ready
+// - false - failed to calc features
+bool Colorizator::PrepareImgFeatures()
+{
+	if ( (NULL == m_target) || (NULL == m_source) )
+	{
+		qDebug() << "PrepareImgFeatures(): Error - invalid arguments";
+		return false;
+	}
+
+	const QList<Feature::Type> features = GetRequiredFeatures();
+	if ( true == features.isEmpty() )
+	{
+		return true;
+	}
+
+	bool targetReady = m_target->UpdatePixelsFeatures(features);
+	bool sourceReady = m_source->UpdatePixelsFeatures(features);
+	if ( (false == targetReady) || (false == sourceReady) )
+	{
+		qDebug() << "PrepareImgFeatures(): Error - can't calc features of images";
+		return false;
+	}
+
+	return true;
+}
+
+// Prepare search of similar pixels in Source image. It should be called after calculation of features.
+// @input:
+// @output:
+// - true - matcher is ready
+// - false - failed to prepare matcher
+bool Colorizator::PrepareMatcher()
+{
+	if ( NULL == m_source )
+	{
+		qDebug() << "PrepareMatcher(): Error - invalid arguments";
+		return false;
+	}
+
+	if ( Matcher::RANDOM == m_matcher )
+	{
+		// Random search doesn't need index
+		return true;
+	}
+
+	// Indexes depend on luminance of Source image and on mask of SKO
+	QByteArray indexKey = m_source->GetRelLumHash();
+	indexKey.append(QByteArray::number(m_source->GetFeatureMaskSide(Feature::SKO)));
+
+	const PlaneValue *sourceRelLumPlane = m_source->GetPixelsPlane(Plane::REL_LUM);
+	const PlaneValue *sourceSKOPlane = m_source->GetPixelsPlane(Plane::SKO);
+	const unsigned int pixelsNum = m_source->GetImageWidth() * m_source->GetImageHeight();
+	bool indexBuilt = true;
+	switch( m_matcher )
+	{
+		case Matcher::INDEXED:
+			if ( (true == m_sourceIndex->IsEmpty()) || (indexKey != m_sourceIndex->GetKey()) )
+			{
+				indexBuilt = m_sourceIndex->Build(sourceRelLumPlane, sourceSKOPlane, pixelsNum, indexKey);
+			}
+			break;
+
+		case Matcher::SORTED_WINDOW:
+			if ( (true == m_sourceSortedIndex->IsEmpty()) || (indexKey != m_sourceSortedIndex->GetKey()) )
+			{
+				indexBuilt = m_sourceSortedIndex->Build(sourceRelLumPlane, sourceSKOPlane, pixelsNum, indexKey);
+			}
+			break;
+
+		// Random search is handled above
+		case Matcher::RANDOM:
+		case Matcher::DEFAULT_LAST:
+		default:
+		{
+			qDebug() << "PrepareMatcher(): Error - invalid type of matcher";
+			return false;
+		}
+	}
+
+	if ( false == indexBuilt )
+	{
+		qDebug() << "PrepareMatcher(): Error - can't build index of Source image";
+		return false;
+	}
+
+	return true;
+}
+
+// Find by index Source pixel, most similar to Target pixel
+// @input:
+// - double - relative luminance of Target pixel
+// - double - SKO of Target pixel
+// - unsigned int - variable for index of Source pixel (y * width + x)
+// @output:
+// - true - pixel found
+// - false - index is empty (or matcher doesn't use index)
+bool Colorizator::FindSimilarSourcePixel(const double &t_targLum,
+										 const double &t_targSKO,
+										 unsigned int &t_sourceIndex) const
+{
+	switch( m_matcher )
+	{
+		case Matcher::INDEXED:
+			return m_sourceIndex->FindSimilar(t_targLum, t_targSKO, m_matcherMaxChecks, t_sourceIndex);
+
+		case Matcher::SORTED_WINDOW:
+			return m_sourceSortedIndex->FindSimilar(t_targLum, t_targSKO, m_matcherWindow, t_sourceIndex);
+
+		case Matcher::RANDOM:
+		case Matcher::DEFAULT_LAST:
+		default:
+			return false;
+	}
+}
@@ -23,6 +23,8 @@
 #include "./IMAGES/SOURCE/sourceimage.h"
 #include "./IMAGES/TARGET/targetimage.h"
 #include "./SERVICE/IMAGES/imglumscaler.h"
+#include "./SERVICE/IMAGES/imgfeaturesindex.h"
+#include "./SERVICE/IMAGES/imglumsortedindex.h"
 #include "./DEFINES/colorization.h"
 #include "./DEFINES/imgservice.h"
 
@@ -32,12 +34,35 @@ class Colorizator
 protected:
 	TargetImage *m_target;
 	SourceImage *m_source;
+	Matcher::Type m_matcher;
+	// Index of features of Source image (for Matcher::INDEXED)
+	ImgFeaturesIndex *m_sourceIndex;
+	// Source pixels sorted by luminance (for Matcher::SORTED_WINDOW)
+	ImgLumSortedIndex *m_sourceSortedIndex;
+	// Number of checked Source pixels (for Matcher::SORTED_WINDOW)
+	unsigned int m_matcherWindow;
+	// Max number of checked Source pixels (for Matcher::INDEXED, 0 - exact search)
+	unsigned int m_matcherMaxChecks;
+
+private:
+	// Indexes of Source image, which are used if external indexes are not set
+	ImgFeaturesIndex m_ownSourceIndex;
+	ImgLumSortedIndex m_ownSourceSortedIndex;
 
 	// == METHODS ==
 public:
 	Colorizator();
 	~Colorizator();
 
+	// Set way to find Source pixel, most similar to Target pixel
+	void SetMatcher(const Matcher::Type &t_type,
+					ImgFeaturesIndex *t_sourceIndex = NULL,
+					ImgLumSortedIndex *t_sourceSortedIndex = NULL);
+	// Set number of Source pixels checked by matcher with window
+	void SetMatcherWindow(const unsigned int &t_windowWidth);
+	// Set max number of Source pixels checked by indexed matcher
+	void SetMatcherMaxChecks(const unsigned int &t_maxChecks);
+
 	// Start Colorization
 	virtual bool Colorize(TargetImage *t_targetImg,
 						  SourceImage *t_sourceImg,
@@ -50,8 +75,16 @@ protected:
 	virtual bool ColorizeImage() = 0;
 	// Restore images params if needed
 	virtual bool PostColorization() = 0;
+	// Get features of pixels, which are needed by colorization method
+	virtual QList<Feature::Type> GetRequiredFeatures() const = 0;
 	// Scale Target Image luminance
 	bool EquliseTargetImgLum(const LumEqualization::Type &t_type);
+	// Calc features of pixels of Target and Source images, which are needed by method (if they are not actual)
+	bool PrepareImgFeatures();
+	// Prepare search of similar pixels in Source image
+	bool PrepareMatcher();
+	// Find by index Source pixel, most similar to Target pixel
+	bool FindSimilarSourcePixel(const double &t_targLum, const double &t_targSKO, unsigned int &t_sourceIndex) const;
 
 private:
 	void Clear();
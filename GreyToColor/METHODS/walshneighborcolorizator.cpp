@@ -75,6 +75,18 @@ bool WalshNeighborColorizator::Colorize(TargetImage *t_targetImg,
 	return true;
 }
 
+// Get features of pixels, which are needed by colorization method
+// @input:
+// @output:
+// - QList<Feature::Type> - needed features
+QList<Feature::Type> WalshNeighborColorizator::GetRequiredFeatures() const
+{
+	QList<Feature::Type> features;
+	features.append(Feature::SKO);
+
+	return features;
+}
+
 // Prepare images to colorization
 // @input:
 // - LumEqualization::Type - exist type of way to equalise luminance of the Target image to Source image
@@ -101,8 +113,19 @@ bool WalshNeighborColorizator::PrepareImages(const LumEqualization::Type &t_type
 		return false;
 	}
 
-	m_target->CalcPixelsSKO();
-	m_source->CalcPixelsSKO();
+	bool featuresReady = PrepareImgFeatures();
+	if ( false == featuresReady )
+	{
+		qDebug() << "PrepareImages(): Error - can't calc features of images";
+		return false;
+	}
+
+	bool matcherReady = PrepareMatcher();
+	if ( false == matcherReady )
+	{
+		qDebug() << "PrepareImages(): Error - can't prepare search of similar pixels";
+		return false;
+	}
 
 	return true;
 }
@@ -149,6 +172,7 @@ bool WalshNeighborColorizator::ColorizeImage()
 	// Source pixel variables
 	unsigned int sourceRandWdt = 0;
 	unsigned int sourceRandHgt = 0;
+	unsigned int sourceIndex = 0;
 	double sourcePixLum = DEFAULT_LUM;
 	double sourcePixSKO = DEFAULT_SKO;
 	double sourceChA = 0;
@@ -158,6 +182,24 @@ bool WalshNeighborColorizator::ColorizeImage()
 	double diffLum = DEFAULT_LUM;
 	double diffSKO = DEFAULT_SKO;
 
+	// Pixels characteristics planes (value of pixel (x, y) has index y * width + x)
+	const PlaneValue *targRelLumPlane = m_target->GetPixelsPlane(Plane::REL_LUM);
+	const PlaneValue *targSKOPlane = m_target->GetPixelsPlane(Plane::SKO);
+	const PlaneValue *sourceRelLumPlane = m_source->GetPixelsPlane(Plane::REL_LUM);
+	const PlaneValue *sourceSKOPlane = m_source->GetPixelsPlane(Plane::SKO);
+	const PlaneValue *sourceChAPlane = m_source->GetPixelsPlane(Plane::CH_A);
+	const PlaneValue *sourceChBPlane = m_source->GetPixelsPlane(Plane::CH_B);
+	if ( (NULL == targRelLumPlane) ||
+		 (NULL == targSKOPlane) ||
+		 (NULL == sourceRelLumPlane) ||
+		 (NULL == sourceSKOPlane) ||
+		 (NULL == sourceChAPlane) ||
+		 (NULL == sourceChBPlane) )
+	{
+		qDebug() << "ColorizeImage(): Error - images have no pixels";
+		return false;
+	}
+
 	qDebug() << "Start colorization!";
 	QElapsedTimer timer;
 	timer.start();
@@ -181,39 +223,56 @@ bool WalshNeighborColorizator::ColorizeImage()
 			bestSourcePixHgt = 0;
 
 			// Get target pixel params
-			targPixLum = m_target->GetPixelsRelLum(width, height);
-			targPixSKO = m_target->GetPixelsSKO(width, height);
+			targPixLum = targRelLumPlane[height * targetWdt + width];
+			targPixSKO = targSKOPlane[height * targetWdt + width];
 			if ( (targPixLum <= NO_INFO) || (targPixSKO <= ERROR) )
 			{
 				qDebug() << "ColorizeImage(): Warning - failed to colorize pixel" << width << height;
 				continue;
 			}
 
-			// Try to fins best similar source image pixel
-			for ( unsigned int pix = 0; pix < numOfAttempts; pix++ )
+			if ( Matcher::RANDOM != m_matcher )
 			{
-				sourceRandWdt = rand() % sourceWdt;
-				sourceRandHgt = rand() % sourceHgt;
-
-				sourcePixLum = m_source->GetPixelsRelLum(sourceRandWdt, sourceRandHgt);
-				sourcePixSKO = m_source->GetPixelsSKO(sourceRandWdt, sourceRandHgt);
-
-				diffLum = fabs( targPixLum - sourcePixLum );
-				diffSKO = fabs( targPixSKO - sourcePixSKO );
+				// Find most similar source image pixel by index
+				if ( false == FindSimilarSourcePixel(targPixLum, targPixSKO, sourceIndex) )
+				{
+					qDebug() << "ColorizeImage(): Warning - failed to colorize pixel" << width << height;
+					continue;
+				}
 
-				if ( ( (diffLum < bestDiffLum) && (diffSKO < (bestDiffSKO + SKO_TRESHOLD)) ) ||
-					 ( (diffLum < (bestDiffLum + LUM_TRESHOLD)) && (diffSKO < bestDiffSKO) ) )
+				bestSourcePixWdt = sourceIndex % sourceWdt;
+				bestSourcePixHgt = sourceIndex / sourceWdt;
+			}
+			else
+			{
+				// Try to fins best similar source image pixel
+				for ( unsigned int pix = 0; pix < numOfAttempts; pix++ )
 				{
-					bestDiffLum = diffLum;
-					bestDiffSKO = diffSKO;
-					bestSourcePixWdt = sourceRandWdt;
-					bestSourcePixHgt = sourceRandHgt;
+					sourceRandWdt = rand() % sourceWdt;
+					sourceRandHgt = rand() % sourceHgt;
+
+					sourceIndex = sourceRandHgt * sourceWdt + sourceRandWdt;
+					sourcePixLum = sourceRelLumPlane[sourceIndex];
+					sourcePixSKO = sourceSKOPlane[sourceIndex];
+
+					diffLum = fabs( targPixLum - sourcePixLum );
+					diffSKO = fabs( targPixSKO - sourcePixSKO );
+
+					if ( ( (diffLum < bestDiffLum) && (diffSKO < (bestDiffSKO + SKO_TRESHOLD)) ) ||
+						 ( (diffLum < (bestDiffLum + LUM_TRESHOLD)) && (diffSKO < bestDiffSKO) ) )
+					{
+						bestDiffLum = diffLum;
+						bestDiffSKO = diffSKO;
+						bestSourcePixWdt = sourceRandWdt;
+						bestSourcePixHgt = sourceRandHgt;
+					}
 				}
 			}
 
 			// Transfer color from Source pixel to Target pixel
-			sourceChA = m_source->PixelChA(bestSourcePixWdt, bestSourcePixHgt);
-			sourceChB = m_source->PixelChB(bestSourcePixWdt, bestSourcePixHgt);
+			sourceIndex = bestSourcePixHgt * sourceWdt + bestSourcePixWdt;
+			sourceChA = sourceChAPlane[sourceIndex];
+			sourceChB = sourceChBPlane[sourceIndex];
 			m_target->SetPixelChAB(width,
 								   height,
 								   sourceChA,
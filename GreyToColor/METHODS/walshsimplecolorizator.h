@@ -43,6 +43,8 @@ public:
 						  const LumEqualization::Type &t_type);
 
 private:
+	// Get features of pixels, which are needed by colorization method
+	virtual QList<Feature::Type> GetRequiredFeatures() const;
 	// Prepare images to colorization
 	virtual bool PrepareImages(const LumEqualization::Type &t_type);
 	// Colorize Target image using color information from Source image
@@ -75,6 +75,18 @@ bool WNNoRandColorizator::Colorize(TargetImage *t_targetImg,
 	return true;
 }
 
+// Get features of pixels, which are needed by colorization method
+// @input:
+// @output:
+// - QList<Feature::Type> - needed features
+QList<Feature::Type> WNNoRandColorizator::GetRequiredFeatures() const
+{
+	QList<Feature::Type> features;
+	features.append(Feature::SKO);
+
+	return features;
+}
+
 // Prepare images to colorization
 // @input:
 // - LumEqualization::Type - exist type of way to equalise luminance of the Target image to Source image
@@ -101,8 +113,12 @@ bool WNNoRandColorizator::PrepareImages(const LumEqualization::Type &t_type)
 		return false;
 	}
 
-	m_target->CalcPixelsSKO();
-	m_source->CalcPixelsSKO();
+	bool featuresReady = PrepareImgFeatures();
+	if ( false == featuresReady )
+	{
+		qDebug() << "PrepareImages(): Error - can't calc features of images";
+		return false;
+	}
 
 	return true;
 }
@@ -125,6 +141,7 @@ bool WNNoRandColorizator::ColorizeImage()
 
 	const unsigned int targetWdt = m_target->GetImageWidth();
 	const unsigned int targetHgt = m_target->GetImageHeight();
+	const unsigned int sourceWdt = m_source->GetImageWidth();
 
 	// Define number of attempts for each target pixel of searching similar pixel in source image
 	const unsigned int pixelsInTargetImg = targetWdt * targetHgt;
@@ -156,6 +173,7 @@ bool WNNoRandColorizator::ColorizeImage()
 	// Source pixel variables
 	unsigned int sourceRandWdt = 0;
 	unsigned int sourceRandHgt = 0;
+	unsigned int sourceIndex = 0;
 	double sourcePixLum = DEFAULT_LUM;
 	double sourcePixSKO = DEFAULT_SKO;
 	double sourceChA = 0;
@@ -165,6 +183,24 @@ bool WNNoRandColorizator::ColorizeImage()
 	double diffLum = DEFAULT_LUM;
 	double diffSKO = DEFAULT_SKO;
 
+	// Pixels characteristics planes (value of pixel (x, y) has index y * width + x)
+	const PlaneValue *targRelLumPlane = m_target->GetPixelsPlane(Plane::REL_LUM);
+	const PlaneValue *targSKOPlane = m_target->GetPixelsPlane(Plane::SKO);
+	const PlaneValue *sourceRelLumPlane = m_source->GetPixelsPlane(Plane::REL_LUM);
+	const PlaneValue *sourceSKOPlane = m_source->GetPixelsPlane(Plane::SKO);
+	const PlaneValue *sourceChAPlane = m_source->GetPixelsPlane(Plane::CH_A);
+	const PlaneValue *sourceChBPlane = m_source->GetPixelsPlane(Plane::CH_B);
+	if ( (NULL == targRelLumPlane) ||
+		 (NULL == targSKOPlane) ||
+		 (NULL == sourceRelLumPlane) ||
+		 (NULL == sourceSKOPlane) ||
+		 (NULL == sourceChAPlane) ||
+		 (NULL == sourceChBPlane) )
+	{
+		qDebug() << "ColorizeImage(): Error - images have no pixels";
+		return false;
+	}
+
 	qDebug() << "Start colorization!";
 	QElapsedTimer timer;
 	timer.start();
@@ -186,8 +222,8 @@ bool WNNoRandColorizator::ColorizeImage()
 			bestSourcePixHgt = 0;
 
 			// Get target pixel params
-			targPixLum = m_target->GetPixelsRelLum(width, height);
-			targPixSKO = m_target->GetPixelsSKO(width, height);
+			targPixLum = targRelLumPlane[height * targetWdt + width];
+			targPixSKO = targSKOPlane[height * targetWdt + width];
 			if ( (targPixLum <= NO_INFO) || (targPixSKO <= ERROR) )
 			{
 				qDebug() << "ColorizeImage(): Warning - failed to colorize pixel" << width << height;
@@ -200,8 +236,9 @@ bool WNNoRandColorizator::ColorizeImage()
 				sourceRandWdt = sourceRefPixs.at(pix).first;
 				sourceRandHgt = sourceRefPixs.at(pix).second;
 
-				sourcePixLum = m_source->GetPixelsRelLum(sourceRandWdt, sourceRandHgt);
-				sourcePixSKO = m_source->GetPixelsSKO(sourceRandWdt, sourceRandHgt);
+				sourceIndex = sourceRandHgt * sourceWdt + sourceRandWdt;
+				sourcePixLum = sourceRelLumPlane[sourceIndex];
+				sourcePixSKO = sourceSKOPlane[sourceIndex];
 
 				diffLum = fabs( targPixLum - sourcePixLum );
 				diffSKO = fabs( targPixSKO - sourcePixSKO );
@@ -217,8 +254,9 @@ bool WNNoRandColorizator::ColorizeImage()
 			}
 
 			// Transfer color from Source pixel to Target pixel
-			sourceChA = m_source->PixelChA(bestSourcePixWdt, bestSourcePixHgt);
-			sourceChB = m_source->PixelChB(bestSourcePixWdt, bestSourcePixHgt);
+			sourceIndex = bestSourcePixHgt * sourceWdt + bestSourcePixWdt;
+			sourceChA = sourceChAPlane[sourceIndex];
+			sourceChB = sourceChBPlane[sourceIndex];
 			m_target->SetPixelChAB(width,
 								   height,
 								   sourceChA,
@@ -18,9 +18,79 @@
 
 #include "wsentropycolorizator.h"
 
+// Planes of pixels characteristics, in order of ENTROPY_PARAMS_NUM params (and weights) of method
+const Plane::Type WSEntropyColorizator::m_paramsPlanes[ENTROPY_PARAMS_NUM] = { Plane::REL_LUM,
+																			  Plane::SKO,
+																			  Plane::ENTROPY,
+																			  Plane::SKEWNESS,
+																			  Plane::KURTOSIS };
+
 WSEntropyColorizator::WSEntropyColorizator()
 {
+	m_matching = EntropyMatching::CORRELATION;
+	m_sourceTree = &m_ownSourceTree;
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		m_weights[param] = ENTROPY_PARAM_WEIGHT;
+	}
+}
 
+// Set way to compare features of pixels
+// @input:
+// - EntropyMatching::Type - exist way of comparison
+// - ImgVPTree - index of features of Source images, which is kept between colorizations (or NULL to use own
+// index of colorizator). It's rebuilt only if it was built for other Source image or other weights
+// @output:
+void WSEntropyColorizator::SetMatching(const EntropyMatching::Type &t_type, ImgVPTree *t_sourceTree)
+{
+	if ( EntropyMatching::DEFAULT_LAST == t_type )
+	{
+		qDebug() << "SetMatching(): Error - invalid arguments";
+		return;
+	}
+
+	m_matching = t_type;
+	m_sourceTree = &m_ownSourceTree;
+	if ( NULL != t_sourceTree )
+	{
+		m_sourceTree = t_sourceTree;
+	}
+}
+
+// Set weights of features in distance between pixels
+// @input:
+// - double - not negative weights of luminance, SKO, entropy, skewness and kurtosis (at least one is positive)
+// @output:
+void WSEntropyColorizator::SetWeights(const double t_weights[ENTROPY_PARAMS_NUM])
+{
+	if ( NULL == t_weights )
+	{
+		qDebug() << "SetWeights(): Error - invalid arguments";
+		return;
+	}
+
+	double weightsSum = 0.0;
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		if ( t_weights[param] < 0 )
+		{
+			qDebug() << "SetWeights(): Error - invalid arguments";
+			return;
+		}
+
+		weightsSum += t_weights[param];
+	}
+
+	if ( weightsSum <= 0 )
+	{
+		qDebug() << "SetWeights(): Error - all weights are zero";
+		return;
+	}
+
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		m_weights[param] = t_weights[param];
+	}
 }
 
 // Start Colorization
@@ -56,7 +126,29 @@ bool WSEntropyColorizator::Colorize(TargetImage *t_targetImg,
 		return false;
 	}
 
-	bool targetColorized = ColorizeImageCorrelation();
+	bool targetColorized = false;
+	switch( m_matching )
+	{
+		case EntropyMatching::SUM:
+			targetColorized = ColorizeImage();
+			break;
+
+		case EntropyMatching::CORRELATION:
+			targetColorized = ColorizeImageCorrelation();
+			break;
+
+		case EntropyMatching::NEAREST:
+			targetColorized = ColorizeImageNearest();
+			break;
+
+		case EntropyMatching::DEFAULT_LAST:
+		default:
+		{
+			qDebug() << "Colorize(): Error - invalid way to compare pixels";
+			return false;
+		}
+	}
+
 	if ( false == targetColorized )
 	{
 		qDebug() << "Colorize(): Error - can't colorize Target image";
@@ -75,6 +167,20 @@ bool WSEntropyColorizator::Colorize(TargetImage *t_targetImg,
 	return true;
 }
 
+// Get features of pixels, which are needed by colorization method
+// @input:
+// @output:
+// - QList<Feature::Type> - needed features
+QList<Feature::Type> WSEntropyColorizator::GetRequiredFeatures() const
+{
+	QList<Feature::Type> features;
+	features.append(Feature::SKO);
+	features.append(Feature::ENTROPY);
+	features.append(Feature::SKEW_AND_KURT);
+
+	return features;
+}
+
 // Prepare images to colorization
 // @input:
 // - LumEqualization::Type - exist type of way to equalise luminance of the Target image to Source image
@@ -101,17 +207,22 @@ bool WSEntropyColorizator::PrepareImages(const LumEqualization::Type &t_type)
 		return false;
 	}
 
-	qDebug() << "SKO";
-	m_target->CalcPixelsSKO();
-	m_source->CalcPixelsSKO();
-
-	qDebug() << "Entropy";
-	m_target->CalcPixelsEntropy();
-	m_source->CalcPixelsEntropy();
+	bool featuresReady = PrepareImgFeatures();
+	if ( false == featuresReady )
+	{
+		qDebug() << "PrepareImages(): Error - can't calc features of images";
+		return false;
+	}
 
-	qDebug() << "Skew and Kurt";
-	m_target->CalcPixelsSkewAndKurt();
-	m_source->CalcPixelsSkewAndKurt();
+	if ( EntropyMatching::NEAREST == m_matching )
+	{
+		bool treeReady = PrepareSourceTree();
+		if ( false == treeReady )
+		{
+			qDebug() << "PrepareImages(): Error - can't prepare index of Source image";
+			return false;
+		}
+	}
 
 	return true;
 }
@@ -156,6 +267,7 @@ bool WSEntropyColorizator::ColorizeImage()
 	// Source pixel variables
 	unsigned int sourceRandWdt = 0;
 	unsigned int sourceRandHgt = 0;
+	unsigned int sourceIndex = 0;
 	double sourceChA = 0;
 	double sourceChB = 0;
 	double sourceSumParams = MIN_SUMM;
@@ -163,6 +275,28 @@ bool WSEntropyColorizator::ColorizeImage()
 	// Decision variables
 	double diffParams = DEFAULT_DIFF;
 
+	// Pixels characteristics planes (value of pixel (x, y) has index y * width + x)
+	const PlaneValue *targParamsPlanes[ENTROPY_PARAMS_NUM];
+	const PlaneValue *sourceParamsPlanes[ENTROPY_PARAMS_NUM];
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		targParamsPlanes[param] = m_target->GetPixelsPlane(m_paramsPlanes[param]);
+		sourceParamsPlanes[param] = m_source->GetPixelsPlane(m_paramsPlanes[param]);
+		if ( (NULL == targParamsPlanes[param]) || (NULL == sourceParamsPlanes[param]) )
+		{
+			qDebug() << "ColorizeImage(): Error - images have no pixels";
+			return false;
+		}
+	}
+
+	const PlaneValue *sourceChAPlane = m_source->GetPixelsPlane(Plane::CH_A);
+	const PlaneValue *sourceChBPlane = m_source->GetPixelsPlane(Plane::CH_B);
+	if ( (NULL == sourceChAPlane) || (NULL == sourceChBPlane) )
+	{
+		qDebug() << "ColorizeImage(): Error - images have no pixels";
+		return false;
+	}
+
 	qDebug() << "Start colorization!";
 	QElapsedTimer timer;
 	timer.start();
@@ -182,11 +316,10 @@ bool WSEntropyColorizator::ColorizeImage()
 
 			// Get target pixel params
 			targSumParams = MIN_SUMM;
-			targSumParams += m_target->GetPixelsRelLum(width, height);
-			targSumParams += m_target->GetPixelsSKO(width, height);
-			targSumParams += m_target->GetPixelsEntropy(width, height);
-			targSumParams += m_target->GetPixelsSkewness(width, height);
-			targSumParams += m_target->GetPixelsKurtosis(width, height);
+			for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+			{
+				targSumParams += targParamsPlanes[param][height * targetWdt + width];
+			}
 
 			// Try to find best similar source image pixel
 			for ( unsigned int pix = 0; pix < numOfAttempts; ++pix )
@@ -194,12 +327,12 @@ bool WSEntropyColorizator::ColorizeImage()
 				sourceRandWdt = rand() % sourceWdt;
 				sourceRandHgt = rand() % sourceHgt;
 
+				sourceIndex = sourceRandHgt * sourceWdt + sourceRandWdt;
 				sourceSumParams = MIN_SUMM;
-				sourceSumParams += m_source->GetPixelsRelLum(sourceRandWdt, sourceRandHgt);
-				sourceSumParams += m_source->GetPixelsSKO(sourceRandWdt, sourceRandHgt);
-				sourceSumParams += m_source->GetPixelsEntropy(sourceRandWdt, sourceRandHgt);
-				sourceSumParams += m_source->GetPixelsSkewness(sourceRandWdt, sourceRandHgt);
-				sourceSumParams += m_source->GetPixelsKurtosis(sourceRandWdt, sourceRandHgt);
+				for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+				{
+					sourceSumParams += sourceParamsPlanes[param][sourceIndex];
+				}
 
 				diffParams = fabs(targSumParams - sourceSumParams);
 				if ( diffParams < bestParamsDiff )
@@ -211,8 +344,9 @@ bool WSEntropyColorizator::ColorizeImage()
 			}
 
 			// Transfer color from Source pixel to Target pixel
-			sourceChA = m_source->PixelChA(bestSourcePixWdt, bestSourcePixHgt);
-			sourceChB = m_source->PixelChB(bestSourcePixWdt, bestSourcePixHgt);
+			sourceIndex = bestSourcePixHgt * sourceWdt + bestSourcePixWdt;
+			sourceChA = sourceChAPlane[sourceIndex];
+			sourceChB = sourceChBPlane[sourceIndex];
 
 			m_target->SetPixelChAB(width,
 								   height,
@@ -238,7 +372,7 @@ bool WSEntropyColorizator::ColorizeImageCorrelation()
 		 (false == m_target->HasImage()) ||
 		 (false == m_source->HasImage()) )
 	{
-		qDebug() << "ColorizeImage(): Error - invalid arguments";
+		qDebug() << "ColorizeImageCorrelation(): Error - invalid arguments";
 		return false;
 	}
 
@@ -260,15 +394,16 @@ bool WSEntropyColorizator::ColorizeImageCorrelation()
 	unsigned int bestSourcePixWdt = 0;
 	unsigned int bestSourcePixHgt = 0;
 
-	// Sum of Targets pixel variables
-	QList<double> targParams;
+	// Targets pixel variables
+	double targParams[ENTROPY_PARAMS_NUM];
 
 	// Source pixel variables
 	unsigned int sourceRandWdt = 0;
 	unsigned int sourceRandHgt = 0;
+	unsigned int sourceIndex = 0;
 	double sourceChA = 0;
 	double sourceChB = 0;
-	QList<double> sourceParams;
+	double sourceParam = 0.0;
 
 	// Decision variables
 	double product = 0.0;
@@ -276,6 +411,28 @@ bool WSEntropyColorizator::ColorizeImageCorrelation()
 	double sourceSumm = 0.0;
 	double corrParams = DEFAULT_DIFF;
 
+	// Pixels characteristics planes (value of pixel (x, y) has index y * width + x)
+	const PlaneValue *targParamsPlanes[ENTROPY_PARAMS_NUM];
+	const PlaneValue *sourceParamsPlanes[ENTROPY_PARAMS_NUM];
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		targParamsPlanes[param] = m_target->GetPixelsPlane(m_paramsPlanes[param]);
+		sourceParamsPlanes[param] = m_source->GetPixelsPlane(m_paramsPlanes[param]);
+		if ( (NULL == targParamsPlanes[param]) || (NULL == sourceParamsPlanes[param]) )
+		{
+			qDebug() << "ColorizeImageCorrelation(): Error - images have no pixels";
+			return false;
+		}
+	}
+
+	const PlaneValue *sourceChAPlane = m_source->GetPixelsPlane(Plane::CH_A);
+	const PlaneValue *sourceChBPlane = m_source->GetPixelsPlane(Plane::CH_B);
+	if ( (NULL == sourceChAPlane) || (NULL == sourceChBPlane) )
+	{
+		qDebug() << "ColorizeImageCorrelation(): Error - images have no pixels";
+		return false;
+	}
+
 	qDebug() << "Start colorization!";
 	QElapsedTimer timer;
 	timer.start();
@@ -294,12 +451,10 @@ bool WSEntropyColorizator::ColorizeImageCorrelation()
 
 
 			// Get target pixel params
-			targParams.clear();
-			targParams << m_target->GetPixelsRelLum(width, height) <<
-						  m_target->GetPixelsSKO(width, height) <<
-						  m_target->GetPixelsEntropy(width, height) <<
-						  m_target->GetPixelsSkewness(width, height) <<
-						  m_target->GetPixelsKurtosis(width, height);
+			for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+			{
+				targParams[param] = targParamsPlanes[param][height * targetWdt + width];
+			}
 
 			// Try to find best similar source image pixel
 			for ( unsigned int pix = 0; pix < numOfAttempts; ++pix )
@@ -307,24 +462,20 @@ bool WSEntropyColorizator::ColorizeImageCorrelation()
 				sourceRandWdt = rand() % sourceWdt;
 				sourceRandHgt = rand() % sourceHgt;
 
-				sourceParams.clear();
-				sourceParams << m_source->GetPixelsRelLum(sourceRandWdt, sourceRandHgt) <<
-								m_source->GetPixelsSKO(sourceRandWdt, sourceRandHgt) <<
-								m_source->GetPixelsEntropy(sourceRandWdt, sourceRandHgt) <<
-								m_source->GetPixelsSkewness(sourceRandWdt, sourceRandHgt) <<
-								m_source->GetPixelsKurtosis(sourceRandWdt, sourceRandHgt);
+				sourceIndex = sourceRandHgt * sourceWdt + sourceRandWdt;
 
 				product = 0.0;
 				targSumm = 0.0;
 				sourceSumm = 0.0;
-				for ( int i = 0; i < targParams.size(); ++i )
+				for ( int i = 0; i < ENTROPY_PARAMS_NUM; ++i )
 				{
-					product += targParams.at(i) * sourceParams.at(i);
-					targSumm += pow( targParams.at(i), 2.0 );
-					sourceSumm += pow( sourceParams.at(i), 2.0 );
+					sourceParam = sourceParamsPlanes[i][sourceIndex];
+					product += targParams[i] * sourceParam;
+					targSumm += FastMath::Power( targParams[i], 2 );
+					sourceSumm += FastMath::Power( sourceParam, 2 );
 				}
 
-				corrParams = product / ( pow(targSumm, 0.5) * pow(sourceSumm, 0.5) );
+				corrParams = product / ( FastMath::SquareRoot(targSumm) * FastMath::SquareRoot(sourceSumm) );
 				if ( bestParamsCorr < corrParams )
 				{
 					bestParamsCorr = corrParams;
@@ -334,8 +485,104 @@ bool WSEntropyColorizator::ColorizeImageCorrelation()
 			}
 
 			// Transfer color from Source pixel to Target pixel
-			sourceChA = m_source->PixelChA(bestSourcePixWdt, bestSourcePixHgt);
-			sourceChB = m_source->PixelChB(bestSourcePixWdt, bestSourcePixHgt);
+			sourceIndex = bestSourcePixHgt * sourceWdt + bestSourcePixWdt;
+			sourceChA = sourceChAPlane[sourceIndex];
+			sourceChB = sourceChBPlane[sourceIndex];
+
+			m_target->SetPixelChAB(width,
+								   height,
+								   sourceChA,
+								   sourceChB);
+		}
+	}
+
+	qDebug() << "Elapsed time in nanosec:" << timer.nsecsElapsed();
+
+	return true;
+}
+
+// Colorize Target image using color information from Source image. Use nearest Source pixel: pixel with
+// minimal weighted euclidean distance between vectors of features, which is found by index.
+// @input:
+// @output:
+// - true - Target image colorized
+// - false - failed to colorize Target image
+bool WSEntropyColorizator::ColorizeImageNearest()
+{
+	if ( (NULL == m_target) ||
+		 (NULL == m_source) ||
+		 (false == m_target->HasImage()) ||
+		 (false == m_source->HasImage()) ||
+		 (true == m_sourceTree->IsEmpty()) )
+	{
+		qDebug() << "ColorizeImageNearest(): Error - invalid arguments";
+		return false;
+	}
+
+	const unsigned int targetWdt = m_target->GetImageWidth();
+	const unsigned int targetHgt = m_target->GetImageHeight();
+
+	// Targets pixel variables
+	double targParams[ENTROPY_PARAMS_NUM];
+
+	// Source pixel variables
+	unsigned int sourceIndex = 0;
+	double sourceChA = 0;
+	double sourceChB = 0;
+
+	// Pixels characteristics planes (value of pixel (x, y) has index y * width + x)
+	const PlaneValue *targParamsPlanes[ENTROPY_PARAMS_NUM];
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		targParamsPlanes[param] = m_target->GetPixelsPlane(m_paramsPlanes[param]);
+		if ( NULL == targParamsPlanes[param] )
+		{
+			qDebug() << "ColorizeImageNearest(): Error - images have no pixels";
+			return false;
+		}
+	}
+
+	const PlaneValue *sourceChAPlane = m_source->GetPixelsPlane(Plane::CH_A);
+	const PlaneValue *sourceChBPlane = m_source->GetPixelsPlane(Plane::CH_B);
+	if ( (NULL == sourceChAPlane) || (NULL == sourceChBPlane) )
+	{
+		qDebug() << "ColorizeImageNearest(): Error - images have no pixels";
+		return false;
+	}
+
+	qDebug() << "Start colorization!";
+	QElapsedTimer timer;
+	timer.start();
+
+	for ( unsigned int width = 0; width < targetWdt; ++width )
+	{
+		for ( unsigned int height = 0; height < targetHgt; ++height )
+		{
+			// Get target pixel params. Pixels with unknown params (negative, as NO_INFO luminance) are not
+			// colorized
+			bool paramsKnown = true;
+			for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+			{
+				targParams[param] = targParamsPlanes[param][height * targetWdt + width];
+				paramsKnown = paramsKnown && ( 0 <= targParams[param] );
+			}
+
+			if ( false == paramsKnown )
+			{
+				qDebug() << "ColorizeImageNearest(): Warning - failed to colorize pixel" << width << height;
+				continue;
+			}
+
+			bool pixelFound = m_sourceTree->FindNearest(targParams, sourceIndex);
+			if ( false == pixelFound )
+			{
+				qDebug() << "ColorizeImageNearest(): Warning - failed to colorize pixel" << width << height;
+				continue;
+			}
+
+			// Transfer color from Source pixel to Target pixel
+			sourceChA = sourceChAPlane[sourceIndex];
+			sourceChB = sourceChBPlane[sourceIndex];
 
 			m_target->SetPixelChAB(width,
 								   height,
@@ -349,6 +596,54 @@ bool WSEntropyColorizator::ColorizeImageCorrelation()
 	return true;
 }
 
+// Prepare index of features of Source image. It should be called after calculation of features.
+// @input:
+// @output:
+// - true - index is ready
+// - false - failed to build index
+bool WSEntropyColorizator::PrepareSourceTree()
+{
+	if ( NULL == m_source )
+	{
+		qDebug() << "PrepareSourceTree(): Error - invalid arguments";
+		return false;
+	}
+
+	// Index depends on luminance of Source image, masks of features and weights
+	QByteArray treeKey = m_source->GetRelLumHash();
+	for ( int feature = 0; feature < Feature::DEFAULT_LAST; feature++ )
+	{
+		treeKey.append(QByteArray::number(m_source->GetFeatureMaskSide((Feature::Type)feature)));
+	}
+
+	treeKey.append((const char *)m_weights, (int)sizeof(m_weights));
+	if ( (false == m_sourceTree->IsEmpty()) && (treeKey == m_sourceTree->GetKey()) )
+	{
+		return true;
+	}
+
+	const PlaneValue *sourceParamsPlanes[ENTROPY_PARAMS_NUM];
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		sourceParamsPlanes[param] = m_source->GetPixelsPlane(m_paramsPlanes[param]);
+		if ( NULL == sourceParamsPlanes[param] )
+		{
+			qDebug() << "PrepareSourceTree(): Error - Source image has no pixels";
+			return false;
+		}
+	}
+
+	const unsigned int pixelsNum = m_source->GetImageWidth() * m_source->GetImageHeight();
+	bool treeBuilt = m_sourceTree->Build(sourceParamsPlanes, pixelsNum, m_weights, treeKey);
+	if ( false == treeBuilt )
+	{
+		qDebug() << "PrepareSourceTree(): Error - can't build index of Source image";
+		return false;
+	}
+
+	return true;
+}
+
 // Restore images params if needed
 // @input:
 // @output:
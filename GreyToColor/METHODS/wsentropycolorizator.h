@@ -27,27 +27,50 @@
 #include "colorizator.h"
 #include "./DEFINES/global.h"
 #include "./DEFINES/colorization.h"
+#include "./SERVICE/fastmath.h"
+#include "./SERVICE/IMAGES/imgvptree.h"
 
 class WSEntropyColorizator : public Colorizator
 {
 	// == DATA ==
+private:
+	// Planes of pixels characteristics (luminance, SKO, entropy, skewness, kurtosis)
+	static const Plane::Type m_paramsPlanes[ENTROPY_PARAMS_NUM];
+	EntropyMatching::Type m_matching;
+	// Weights of features in distance between pixels (for EntropyMatching::NEAREST)
+	double m_weights[ENTROPY_PARAMS_NUM];
+	// Index of features of Source image (for EntropyMatching::NEAREST)
+	ImgVPTree *m_sourceTree;
+	// Index of features of Source image, which is used if external index is not set
+	ImgVPTree m_ownSourceTree;
 
 	// == METHODS ==
 public:
 	WSEntropyColorizator();
 
+	// Set way to compare features of pixels
+	void SetMatching(const EntropyMatching::Type &t_type, ImgVPTree *t_sourceTree = NULL);
+	// Set weights of features in distance between pixels
+	void SetWeights(const double t_weights[ENTROPY_PARAMS_NUM]);
+
 	// Start Colorization
 	virtual bool Colorize(TargetImage *t_targetImg,
 						  SourceImage *t_sourceImg,
 						  const LumEqualization::Type &t_type);
 
 private:
+	// Get features of pixels, which are needed by colorization method
+	virtual QList<Feature::Type> GetRequiredFeatures() const;
 	// Prepare images to colorization
 	virtual bool PrepareImages(const LumEqualization::Type &t_type);
 	// Colorize Target image using color information from Source image
 	virtual bool ColorizeImage();
 	// Colorize Target image using color information from Source image. Use correlation
 	bool ColorizeImageCorrelation();
+	// Colorize Target image using color information from Source image. Use nearest Source pixel
+	bool ColorizeImageNearest();
+	// Prepare index of features of Source image
+	bool PrepareSourceTree();
 	// Restore images params if needed
 	virtual bool PostColorization();
 };
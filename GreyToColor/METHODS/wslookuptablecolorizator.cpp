@@ -20,7 +20,8 @@
 
 WSLookUpTableColorizator::WSLookUpTableColorizator()
 {
-
+	m_sourceRelLumPlane = NULL;
+	m_sourceSKOPlane = NULL;
 }
 
 // Start Colorization
@@ -75,6 +76,18 @@ bool WSLookUpTableColorizator::Colorize(TargetImage *t_targetImg,
 	return true;
 }
 
+// Get features of pixels, which are needed by colorization method
+// @input:
+// @output:
+// - QList<Feature::Type> - needed features
+QList<Feature::Type> WSLookUpTableColorizator::GetRequiredFeatures() const
+{
+	QList<Feature::Type> features;
+	features.append(Feature::SKO);
+
+	return features;
+}
+
 // Prepare images to colorization
 // @input:
 // - LumEqualization::Type - exist type of way to equalise luminance of the Target image to Source image
@@ -101,8 +114,19 @@ bool WSLookUpTableColorizator::PrepareImages(const LumEqualization::Type &t_type
 		return false;
 	}
 
-	m_target->CalcPixelsSKO();
-	m_source->CalcPixelsSKO();
+	bool featuresReady = PrepareImgFeatures();
+	if ( false == featuresReady )
+	{
+		qDebug() << "PrepareImages(): Error - can't calc features of images";
+		return false;
+	}
+
+	bool matcherReady = PrepareMatcher();
+	if ( false == matcherReady )
+	{
+		qDebug() << "PrepareImages(): Error - can't prepare search of similar pixels";
+		return false;
+	}
 
 	bool tableFormed = FormLookUpTable();
 	if ( false == tableFormed )
@@ -114,7 +138,8 @@ bool WSLookUpTableColorizator::PrepareImages(const LumEqualization::Type &t_type
 	return true;
 }
 
-// Form look up table on Source image basis
+// Form look up table on Source image basis. Table of Source image is used, if it's formed (or restored from
+// Source model) for current luminance and SKO of Source pixels.
 // @input:
 // @output:
 // - true - look up table formed
@@ -127,146 +152,19 @@ bool WSLookUpTableColorizator::FormLookUpTable()
 		return false;
 	}
 
-	FormEmptyLookUpTable();
-	bool tabledFilled = FillLookUpTable();
-	if ( false == tabledFilled )
+	const ImgLookUpTable *sourceTable = m_source->GetLookUpTable();
+	if ( NULL == sourceTable )
 	{
 		qDebug() << "FormLookUpTable(): Error - can't fill look up table";
 		return false;
 	}
 
-	ReduceLookUpTable();
-
-	return true;
-}
-
-// Form empty look up table
-// @input:
-// @output:
-void WSLookUpTableColorizator::FormEmptyLookUpTable()
-{
-	QList<unsigned int> lumValues = FormLumValues();
-	QList<unsigned int> skoValues = FormSKOValues();
-
-	const int lumValNum = lumValues.size();
-	const int skoValNum = skoValues.size();
-	for ( int lum = 0; lum < lumValNum; lum++ )
-	{
-		LookUpSKO skoLookUp;
-		for ( int sko = 0; sko < skoValNum; sko++ )
-		{
-			PixCoords empty;
-			skoLookUp.insert(skoValues.at(sko), empty);
-		}
-
-		m_lookUpTable.insert(lumValues.at(lum), skoLookUp);
-	}
-}
-
-// Form list of all posible LAB luminances
-// @input:
-// @output:
-// - QList<unsigned int> - possible values of LAB luminance
-QList<unsigned int> WSLookUpTableColorizator::FormLumValues()
-{
-	QList<unsigned int> lumValues;
-	const unsigned int numOfSteps = LAB_MAX_LUM / LAB_LUM_HIST_DIVIDER;
-	for ( unsigned  int step = 0; step <= numOfSteps; step++ )
-	{
-		lumValues.append(step);
-	}
-
-	return lumValues;
-}
-
-// Form list of all possible SKO values
-// @input:
-// @output:
-// - QList<unsigned int> - possible values of LAB luminance
-QList<unsigned int> WSLookUpTableColorizator::FormSKOValues()
-{
-	const double squareRectSide = pow( SKO_MASK_RECT_SIDE, 2 );
-	const double squareLum = pow( LAB_MAX_LUM, 2 );
-	const double maxSKO = sqrt( (squareRectSide - 1) * squareLum / SKO_MASK_RECT_SIDE );
-	const unsigned int numOfSteps = maxSKO / SKO_DIVIDER;
-
-	QList<unsigned int> skoValues;
-	for ( unsigned  int step = 0; step <= numOfSteps; step++ )
-	{
-		skoValues.append(step);
-	}
-
-	return skoValues;
-}
-
-// Fill look up table
-// @input:
-// @output:
-// - true - images params restored
-// - false - can't restore images parameters
-bool WSLookUpTableColorizator::FillLookUpTable()
-{
-	if ( (NULL == m_source) || (false == m_source->HasImage()) )
-	{
-		qDebug() << "FillLookUpTable(): Error - no source image";
-		return false;
-	}
-
-	const unsigned int sourceWdt = m_source->GetImageWidth();
-	const unsigned int sourceHgt = m_source->GetImageHeight();
-	for ( unsigned int width = 0; width < sourceWdt; width++ )
-	{
-		for ( unsigned int height = 0; height < sourceHgt; height++ )
-		{
-			double pixLum = m_source->GetPixelsRelLum(width, height);
-			unsigned int lumStepNum = (unsigned int)floor( pixLum / LAB_LUM_HIST_DIVIDER );
-
-			double pixSKO = m_source->GetPixelsSKO(width, height);
-			unsigned int skoStepNum = (unsigned int)floor( pixSKO / SKO_DIVIDER );
-
-			Coord currPixCoords(width, height);
-			m_lookUpTable[lumStepNum][skoStepNum].append(currPixCoords);
-		}
-	}
+	// Arrays of table are shared, not copied
+	m_lookUpTable = *sourceTable;
 
 	return true;
 }
 
-// Reduce number of coords per cell in look up table
-// @input:
-// @output:
-void WSLookUpTableColorizator::ReduceLookUpTable()
-{
-	if ( true == m_lookUpTable.isEmpty() )
-	{
-		qDebug() << "ReduceLookUpTable(): Error - look up table is empty";
-		return;
-	}
-
-	const int lumListSize = m_lookUpTable.size();
-	const int skoListSize = m_lookUpTable[0].size();
-	for ( int lum = 0; lum < lumListSize; lum++ )
-	{
-		for ( int sko = 0; sko < skoListSize; sko++ )
-		{
-			const int coordsNum = m_lookUpTable[lum][sko].size();
-			if ( coordsNum <= MAX_COORDS_PER_CELL )
-			{
-				continue;
-			}
-
-			const int step = coordsNum / MAX_COORDS_PER_CELL;
-			PixCoords reducedCoords;
-			for ( int addedCoord = 0, coord = 0; addedCoord < MAX_COORDS_PER_CELL; addedCoord++, coord += step)
-			{
-				reducedCoords.append(m_lookUpTable[lum][sko][coord]);
-			}
-
-			m_lookUpTable[lum].insert(sko, reducedCoords);
-		}
-	}
-}
-
 // Colorize Target image using color information from Source image
 // @input:
 // @output:
@@ -289,31 +187,29 @@ bool WSLookUpTableColorizator::ColorizeImage()
 	// Target image pixel variables
 	double targPixLum = DEFAULT_LUM;
 	double targPixSKO = DEFAULT_SKO;
-	unsigned int lumStepNum = 0;
-	unsigned int skoStepNum = 0;
-
-	// Decision variables
-	double diffLum = DEFAULT_LUM;
-	double diffSKO = DEFAULT_SKO;
-
-	// Values of best found pixels characteristics
-	double bestDiffLum = DEFAULT_LUM;
-	double bestDiffSKO = DEFAULT_SKO;
-	unsigned int bestSourcePixWdt = 0;
-	unsigned int bestSourcePixHgt = 0;
 
 	// Source pixel variables
-	unsigned int sourceWdt = 0;
-	unsigned int sourceHgt = 0;
-	double sourcePixLum = DEFAULT_LUM;
-	double sourcePixSKO = DEFAULT_SKO;
+	unsigned int sourceIndex = 0;
 	double sourceChA = 0;
 	double sourceChB = 0;
 
-	PixCoords sourceImgCoords;
-
-	// Offset for search in look up table
-	const unsigned int offset = 1;
+	// Pixels characteristics planes (value of pixel (x, y) has index y * width + x)
+	const PlaneValue *targRelLumPlane = m_target->GetPixelsPlane(Plane::REL_LUM);
+	const PlaneValue *targSKOPlane = m_target->GetPixelsPlane(Plane::SKO);
+	const PlaneValue *sourceChAPlane = m_source->GetPixelsPlane(Plane::CH_A);
+	const PlaneValue *sourceChBPlane = m_source->GetPixelsPlane(Plane::CH_B);
+	m_sourceRelLumPlane = m_source->GetPixelsPlane(Plane::REL_LUM);
+	m_sourceSKOPlane = m_source->GetPixelsPlane(Plane::SKO);
+	if ( (NULL == targRelLumPlane) ||
+		 (NULL == targSKOPlane) ||
+		 (NULL == m_sourceRelLumPlane) ||
+		 (NULL == m_sourceSKOPlane) ||
+		 (NULL == sourceChAPlane) ||
+		 (NULL == sourceChBPlane) )
+	{
+		qDebug() << "ColorizeImage(): Error - images have no pixels";
+		return false;
+	}
 
 	int found = 0;
 
@@ -327,74 +223,25 @@ bool WSLookUpTableColorizator::ColorizeImage()
 		for ( unsigned int height = 0; height < targetHgt; height++ )
 		{
 			// Get target pixel params
-			targPixLum = m_target->GetPixelsRelLum(width, height);
-			targPixSKO = m_target->GetPixelsSKO(width, height);
+			targPixLum = targRelLumPlane[height * targetWdt + width];
+			targPixSKO = targSKOPlane[height * targetWdt + width];
 			if ( (targPixLum <= NO_INFO) || (targPixSKO <= ERROR) )
 			{
 				qDebug() << "FinishColorization(): Warning - failed to colorize pixel" << width << height;
 				continue;
 			}
 
-			lumStepNum = (unsigned int)floor( targPixLum / LAB_LUM_HIST_DIVIDER );
-			skoStepNum = (unsigned int)floor( targPixSKO / SKO_DIVIDER );
-
-			sourceImgCoords = m_lookUpTable[lumStepNum][skoStepNum];
-
-			if ( true == sourceImgCoords.isEmpty() )
-			{
-				// Try to find similar pixel with quite similar params
-				for ( unsigned int lum = lumStepNum - offset; lum <= lumStepNum + offset; lum++ )
-				{
-					for ( unsigned int sko = skoStepNum - offset; sko <= skoStepNum + offset; sko++ )
-					{
-						sourceImgCoords = m_lookUpTable[lum][sko];
-						if ( false == sourceImgCoords.isEmpty() )
-						{
-							break;
-						}
-					}
-				}
-			}
-
-			if ( true == sourceImgCoords.isEmpty() )
+			bool pixelFound = FindSimilarPixel(targPixLum, targPixSKO, sourceIndex);
+			if ( false == pixelFound )
 			{
 				continue;
 			}
 
 			found++;
 
-			// Reset best params
-			bestDiffLum = DEFAULT_LUM;
-			bestDiffSKO = DEFAULT_SKO;
-			bestSourcePixWdt = 0;
-			bestSourcePixHgt = 0;
-
-			// Let's find most similar pixel of Source image
-			const int coordsListSize = sourceImgCoords.size();
-			for ( int coord = 0; coord < coordsListSize; coord++ )
-			{
-				sourceWdt = sourceImgCoords.at(coord).first;
-				sourceHgt = sourceImgCoords.at(coord).second;
-
-				sourcePixLum = m_source->GetPixelsRelLum(sourceWdt, sourceHgt);
-				sourcePixSKO = m_source->GetPixelsSKO(sourceWdt, sourceHgt);
-
-				diffLum = fabs( targPixLum - sourcePixLum );
-				diffSKO = fabs( targPixSKO - sourcePixSKO );
-
-				if ( ( (diffLum < bestDiffLum) && (diffSKO < (bestDiffSKO + SKO_TRESHOLD)) ) ||
-					 ( (diffLum < (bestDiffLum + LUM_TRESHOLD)) && (diffSKO < bestDiffSKO) ) )
-				{
-					bestDiffLum = diffLum;
-					bestDiffSKO = diffSKO;
-					bestSourcePixWdt = sourceWdt;
-					bestSourcePixHgt = sourceHgt;
-				}
-			}
-
 			// Transfer color from Source pixel to Target pixel
-			sourceChA = m_source->PixelChA(bestSourcePixWdt, bestSourcePixHgt);
-			sourceChB = m_source->PixelChB(bestSourcePixWdt, bestSourcePixHgt);
+			sourceChA = sourceChAPlane[sourceIndex];
+			sourceChB = sourceChBPlane[sourceIndex];
 
 			m_target->SetPixelChAB(width,
 								   height,
@@ -418,6 +265,121 @@ bool WSLookUpTableColorizator::ColorizeImage()
 	return true;
 }
 
+// Find in look up table Source pixel, most similar to Target pixel
+// @input:
+// - double - relative luminance of Target pixel
+// - double - SKO of Target pixel
+// - unsigned int - variable for index of found Source pixel
+// @output:
+// - true - similar pixel found
+// - false - no Source pixels near Target pixel in look up table
+bool WSLookUpTableColorizator::FindSimilarPixel(const double &t_targLum,
+												const double &t_targSKO,
+												unsigned int &t_sourceIndex) const
+{
+	const int lumStepsNum = (int)m_lookUpTable.GetFirstStepsNum();
+	const int skoStepsNum = (int)m_lookUpTable.GetSecondStepsNum();
+	const int lumStep = (int)floor( t_targLum / LAB_LUM_HIST_DIVIDER );
+	const int skoStep = (int)floor( t_targSKO / SKO_DIVIDER );
+
+	double bestDiffLum = DEFAULT_LUM;
+	double bestDiffSKO = DEFAULT_SKO;
+	unsigned int candidatesNum = 0;
+
+	// Check cells ring by ring: ring of radius R consists of cells, which are R cells away from cell of pixel
+	// by luminance or by SKO. Rings of bigger radius are checked only if there are too few candidates in nearer
+	for ( int radius = 0; radius <= LOOKUP_SEARCH_MAX_RADIUS; radius++ )
+	{
+		const int minLum = lumStep - radius;
+		const int maxLum = lumStep + radius;
+		const int minSKO = skoStep - radius;
+		const int maxSKO = skoStep + radius;
+		if ( (minLum < 0) && (lumStepsNum <= maxLum) && (minSKO < 0) && (skoStepsNum <= maxSKO) )
+		{
+			// Ring is out of table
+			break;
+		}
+
+		for ( int lum = qMax(minLum, 0); lum <= qMin(maxLum, lumStepsNum - 1); lum++ )
+		{
+			if ( (minLum == lum) || (maxLum == lum) )
+			{
+				// Whole row of ring
+				for ( int sko = qMax(minSKO, 0); sko <= qMin(maxSKO, skoStepsNum - 1); sko++ )
+				{
+					candidatesNum += CheckCellPixels(lum, sko, t_targLum, t_targSKO,
+													 bestDiffLum, bestDiffSKO, t_sourceIndex);
+				}
+			}
+			else
+			{
+				// Only first and last cells of row of ring
+				candidatesNum += CheckCellPixels(lum, minSKO, t_targLum, t_targSKO,
+												 bestDiffLum, bestDiffSKO, t_sourceIndex);
+
+				candidatesNum += CheckCellPixels(lum, maxSKO, t_targLum, t_targSKO,
+												 bestDiffLum, bestDiffSKO, t_sourceIndex);
+			}
+		}
+
+		if ( LOOKUP_SEARCH_MIN_CANDIDATES <= candidatesNum )
+		{
+			break;
+		}
+	}
+
+	return ( 0 < candidatesNum );
+}
+
+// Check pixels of cell of look up table and remember most similar one
+// @input:
+// - int - step of luminance of cell
+// - int - step of SKO of cell
+// - double - relative luminance of Target pixel
+// - double - SKO of Target pixel
+// - double - difference of luminance of best found pixel
+// - double - difference of SKO of best found pixel
+// - unsigned int - index of best found pixel
+// @output:
+// - unsigned int - number of pixels in cell (0 if cell is empty or out of table)
+unsigned int WSLookUpTableColorizator::CheckCellPixels(const int &t_lumStep,
+													   const int &t_skoStep,
+													   const double &t_targLum,
+													   const double &t_targSKO,
+													   double &t_bestDiffLum,
+													   double &t_bestDiffSKO,
+													   unsigned int &t_bestIndex) const
+{
+	if ( (t_lumStep < 0) || (t_skoStep < 0) )
+	{
+		return 0;
+	}
+
+	unsigned int cellPixelsNum = 0;
+	const unsigned int *cellPixels = m_lookUpTable.GetCellPixels(t_lumStep, t_skoStep, cellPixelsNum);
+	if ( NULL == cellPixels )
+	{
+		return 0;
+	}
+
+	for ( unsigned int pix = 0; pix < cellPixelsNum; pix++ )
+	{
+		const unsigned int sourceIndex = cellPixels[pix];
+		const double diffLum = fabs( t_targLum - m_sourceRelLumPlane[sourceIndex] );
+		const double diffSKO = fabs( t_targSKO - m_sourceSKOPlane[sourceIndex] );
+
+		if ( ( (diffLum < t_bestDiffLum) && (diffSKO < (t_bestDiffSKO + SKO_TRESHOLD)) ) ||
+			 ( (diffLum < (t_bestDiffLum + LUM_TRESHOLD)) && (diffSKO < t_bestDiffSKO) ) )
+		{
+			t_bestDiffLum = diffLum;
+			t_bestDiffSKO = diffSKO;
+			t_bestIndex = sourceIndex;
+		}
+	}
+
+	return cellPixelsNum;
+}
+
 // Finish colorization of Target image using Walsh Simple algorithm
 // @input:
 // @output:
@@ -460,6 +422,7 @@ bool WSLookUpTableColorizator::FinishColorization()
 	// Source pixel variables
 	unsigned int sourceRandWdt = 0;
 	unsigned int sourceRandHgt = 0;
+	unsigned int sourceIndex = 0;
 	double sourcePixLum = DEFAULT_LUM;
 	double sourcePixSKO = DEFAULT_SKO;
 	double sourceChA = 0;
@@ -469,6 +432,24 @@ bool WSLookUpTableColorizator::FinishColorization()
 	double diffLum = DEFAULT_LUM;
 	double diffSKO = DEFAULT_SKO;
 
+	// Pixels characteristics planes (value of pixel (x, y) has index y * width + x)
+	const PlaneValue *targRelLumPlane = m_target->GetPixelsPlane(Plane::REL_LUM);
+	const PlaneValue *targSKOPlane = m_target->GetPixelsPlane(Plane::SKO);
+	const PlaneValue *sourceRelLumPlane = m_source->GetPixelsPlane(Plane::REL_LUM);
+	const PlaneValue *sourceSKOPlane = m_source->GetPixelsPlane(Plane::SKO);
+	const PlaneValue *sourceChAPlane = m_source->GetPixelsPlane(Plane::CH_A);
+	const PlaneValue *sourceChBPlane = m_source->GetPixelsPlane(Plane::CH_B);
+	if ( (NULL == targRelLumPlane) ||
+		 (NULL == targSKOPlane) ||
+		 (NULL == sourceRelLumPlane) ||
+		 (NULL == sourceSKOPlane) ||
+		 (NULL == sourceChAPlane) ||
+		 (NULL == sourceChBPlane) )
+	{
+		qDebug() << "FinishColorization(): Error - images have no pixels";
+		return false;
+	}
+
 	srand(time(NULL));
 
 	for ( unsigned int width = 0; width < targetWdt; width++ )
@@ -487,39 +468,56 @@ bool WSLookUpTableColorizator::FinishColorization()
 			bestSourcePixHgt = 0;
 
 			// Get target pixel params
-			targPixLum = m_target->GetPixelsRelLum(width, height);
-			targPixSKO = m_target->GetPixelsSKO(width, height);
+			targPixLum = targRelLumPlane[height * targetWdt + width];
+			targPixSKO = targSKOPlane[height * targetWdt + width];
 			if ( (targPixLum <= NO_INFO) || (targPixSKO <= ERROR) )
 			{
 				qDebug() << "FinishColorization(): Warning - failed to colorize pixel" << width << height;
 				continue;
 			}
 
-			// Try to fins best similar source image pixel
-			for ( unsigned int pix = 0; pix < numOfAttempts; pix++ )
+			if ( Matcher::RANDOM != m_matcher )
 			{
-				sourceRandWdt = rand() % sourceWdt;
-				sourceRandHgt = rand() % sourceHgt;
+				// Find most similar source image pixel by index
+				if ( false == FindSimilarSourcePixel(targPixLum, targPixSKO, sourceIndex) )
+				{
+					qDebug() << "FinishColorization(): Warning - failed to colorize pixel" << width << height;
+					continue;
+				}
 
-				sourcePixLum = m_source->GetPixelsRelLum(sourceRandWdt, sourceRandHgt);
-				sourcePixSKO = m_source->GetPixelsSKO(sourceRandWdt, sourceRandHgt);
+				bestSourcePixWdt = sourceIndex % sourceWdt;
+				bestSourcePixHgt = sourceIndex / sourceWdt;
+			}
+			else
+			{
+				// Try to fins best similar source image pixel
+				for ( unsigned int pix = 0; pix < numOfAttempts; pix++ )
+				{
+					sourceRandWdt = rand() % sourceWdt;
+					sourceRandHgt = rand() % sourceHgt;
 
-				diffLum = fabs( targPixLum - sourcePixLum );
-				diffSKO = fabs( targPixSKO - sourcePixSKO );
+					sourceIndex = sourceRandHgt * sourceWdt + sourceRandWdt;
+					sourcePixLum = sourceRelLumPlane[sourceIndex];
+					sourcePixSKO = sourceSKOPlane[sourceIndex];
 
-				if ( ( (diffLum < bestDiffLum) && (diffSKO < (bestDiffSKO + SKO_TRESHOLD)) ) ||
-					 ( (diffLum < (bestDiffLum + LUM_TRESHOLD)) && (diffSKO < bestDiffSKO) ) )
-				{
-					bestDiffLum = diffLum;
-					bestDiffSKO = diffSKO;
-					bestSourcePixWdt = sourceRandWdt;
-					bestSourcePixHgt = sourceRandHgt;
+					diffLum = fabs( targPixLum - sourcePixLum );
+					diffSKO = fabs( targPixSKO - sourcePixSKO );
+
+					if ( ( (diffLum < bestDiffLum) && (diffSKO < (bestDiffSKO + SKO_TRESHOLD)) ) ||
+						 ( (diffLum < (bestDiffLum + LUM_TRESHOLD)) && (diffSKO < bestDiffSKO) ) )
+					{
+						bestDiffLum = diffLum;
+						bestDiffSKO = diffSKO;
+						bestSourcePixWdt = sourceRandWdt;
+						bestSourcePixHgt = sourceRandHgt;
+					}
 				}
 			}
 
 			// Transfer color from Source pixel to Target pixel
-			sourceChA = m_source->PixelChA(bestSourcePixWdt, bestSourcePixHgt);
-			sourceChB = m_source->PixelChB(bestSourcePixWdt, bestSourcePixHgt);
+			sourceIndex = bestSourcePixHgt * sourceWdt + bestSourcePixWdt;
+			sourceChA = sourceChAPlane[sourceIndex];
+			sourceChB = sourceChBPlane[sourceIndex];
 
 			m_target->SetPixelChAB(width,
 								   height,
@@ -22,7 +22,6 @@
 #include <math.h>
 #include <time.h>
 
-#include <QPair>
 #include <QDebug>
 #include <QElapsedTimer>
 
@@ -30,12 +29,17 @@
 #include "./DEFINES/global.h"
 #include "./DEFINES/colorization.h"
 #include "./DEFINES/pixels.h"
+#include "./SERVICE/IMAGES/imglookuptable.h"
 
 class WSLookUpTableColorizator : public Colorizator
 {
 	// == DATA ==
 private:
-	QMap<unsigned int, LookUpSKO> m_lookUpTable;
+	// Pixels of Source image by relative luminance and SKO
+	ImgLookUpTable m_lookUpTable;
+	// Planes of features of Source pixels for search in look up table
+	const PlaneValue *m_sourceRelLumPlane;
+	const PlaneValue *m_sourceSKOPlane;
 
 	// == METHODS ==
 public:
@@ -47,22 +51,26 @@ public:
 						  const LumEqualization::Type &t_type);
 
 private:
+	// Get features of pixels, which are needed by colorization method
+	virtual QList<Feature::Type> GetRequiredFeatures() const;
 	// Prepare images to colorization
 	virtual bool PrepareImages(const LumEqualization::Type &t_type);
 	// Form look up table on Source image basis
 	bool FormLookUpTable();
-	// Form empty look up table
-	void FormEmptyLookUpTable();
-	// Form list of all posible LAB luminances
-	QList<unsigned int> FormLumValues();
-	// Form list of all possible SKO values
-	QList<unsigned int> FormSKOValues();
-	// Fill look up table
-	bool FillLookUpTable();
-	// Reduce number of coords per cell in look up table
-	void ReduceLookUpTable();
 	// Colorize Target image using color information from Source image
 	virtual bool ColorizeImage();
+	// Find in look up table Source pixel, most similar to Target pixel
+	bool FindSimilarPixel(const double &t_targLum,
+						  const double &t_targSKO,
+						  unsigned int &t_sourceIndex) const;
+	// Check pixels of cell of look up table and remember most similar one
+	unsigned int CheckCellPixels(const int &t_lumStep,
+								 const int &t_skoStep,
+								 const double &t_targLum,
+								 const double &t_targSKO,
+								 double &t_bestDiffLum,
+								 double &t_bestDiffSKO,
+								 unsigned int &t_bestIndex) const;
 	// Finish colorization of Target image using Walsh Simple algorithm
 	bool FinishColorization();
 	// Restore images params if needed
@@ -0,0 +1,633 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sourcemodelfile.h"
+#include "./IMAGES/SOURCE/sourceimage.h"
+
+SourceModelFile::SourceModelFile()
+{
+	m_data = NULL;
+	m_dataSize = 0;
+	m_header = NULL;
+}
+
+SourceModelFile::~SourceModelFile()
+{
+	Close();
+}
+
+// Write model of Source image to file. Planes of features are written only if they are actual.
+// @input:
+// - QString - unempty path to file of model
+// - SourceImage - unnull Source image with pixels
+// - ImgLookUpTable - look up table of pixels of Source image, formed with actual SKO (NULL - not saved)
+// @output:
+// - true - model saved
+// - false - invalid arguments or can't write file
+bool SourceModelFile::Save(const QString &t_path, SourceImage *t_source, const ImgLookUpTable *t_lookUpTable)
+{
+	if ( (true == t_path.isEmpty()) || (NULL == t_source) || (false == t_source->HasImage()) )
+	{
+		qDebug() << "Save(): Error - invalid arguments";
+		return false;
+	}
+
+	SourceModelHeader header;
+	FormHeader(header);
+	header.width = t_source->GetImageWidth();
+	header.height = t_source->GetImageHeight();
+
+	for ( int feature = 0; feature < Feature::DEFAULT_LAST; feature++ )
+	{
+		const Feature::Type type = (Feature::Type)feature;
+		if ( true == t_source->HasActualFeature(type) )
+		{
+			header.featureMaskSides[feature] = t_source->GetFeatureMaskSide(type);
+		}
+	}
+
+	// Sections are placed after header one by one
+	const quint64 pixelsNum = (quint64)header.width * header.height;
+	const uchar *sectionsData[SOURCE_MODEL_MAX_SECTIONS];
+	quint64 offset = AlignedSize(sizeof(SourceModelHeader));
+	for ( int plane = 0; plane < Plane::DEFAULT_LAST; plane++ )
+	{
+		const Plane::Type type = (Plane::Type)plane;
+		const PlaneValue *values = t_source->GetPixelsPlane(type);
+		bool isSaved = false;
+		switch(type)
+		{
+			case Plane::LUM:
+			case Plane::CH_A:
+			case Plane::CH_B:
+			case Plane::REL_LUM:
+				isSaved = true;
+				break;
+
+			case Plane::SKO:
+				isSaved = ( 0 != header.featureMaskSides[Feature::SKO] );
+				break;
+
+			case Plane::ENTROPY:
+				isSaved = ( 0 != header.featureMaskSides[Feature::ENTROPY] );
+				break;
+
+			case Plane::SKEWNESS:
+			case Plane::KURTOSIS:
+				isSaved = ( 0 != header.featureMaskSides[Feature::SKEW_AND_KURT] );
+				break;
+
+			case Plane::DEFAULT_LAST:
+			default:
+			{
+				qDebug() << "Save(): Error - invalid plane";
+			}
+		}
+
+		if ( (false == isSaved) || (NULL == values) )
+		{
+			continue;
+		}
+
+		SourceModelSection &section = header.sections[header.sectionsNum];
+		section.kind = ModelSection::PLANE;
+		section.plane = (quint32)plane;
+		section.offset = offset;
+		section.size = pixelsNum * sizeof(PlaneValue);
+		section.checksum = CalcChecksum((const uchar *)values, section.size);
+		sectionsData[header.sectionsNum] = (const uchar *)values;
+
+		offset += AlignedSize(section.size);
+		++header.sectionsNum;
+	}
+
+	for ( int plane = 0; plane < BytePlane::DEFAULT_LAST; plane++ )
+	{
+		const unsigned char *values = t_source->GetPixelsBytePlane((BytePlane::Type)plane);
+		if ( NULL == values )
+		{
+			continue;
+		}
+
+		SourceModelSection &section = header.sections[header.sectionsNum];
+		section.kind = ModelSection::BYTE_PLANE;
+		section.plane = (quint32)plane;
+		section.offset = offset;
+		section.size = pixelsNum;
+		section.checksum = CalcChecksum(values, section.size);
+		sectionsData[header.sectionsNum] = values;
+
+		offset += AlignedSize(section.size);
+		++header.sectionsNum;
+	}
+
+	if ( (NULL != t_lookUpTable) &&
+		 (false == t_lookUpTable->IsEmpty()) &&
+		 (0 != header.featureMaskSides[Feature::SKO]) )
+	{
+		header.lookUpMaskSide = header.featureMaskSides[Feature::SKO];
+		header.lookUpStepsNums[0] = t_lookUpTable->GetFirstStepsNum();
+		header.lookUpStepsNums[1] = t_lookUpTable->GetSecondStepsNum();
+		header.lookUpMaxPixelsPerCell = t_lookUpTable->GetMaxPixelsPerCell();
+		header.lookUpSteps[0] = t_lookUpTable->GetFirstStep();
+		header.lookUpSteps[1] = t_lookUpTable->GetSecondStep();
+
+		const QVector<unsigned int> *arrays[] = { &t_lookUpTable->GetCellOffsets(), &t_lookUpTable->GetPixels() };
+		const ModelSection::Type kinds[] = { ModelSection::LOOKUP_OFFSETS, ModelSection::LOOKUP_PIXELS };
+		for ( int array = 0; array < 2; array++ )
+		{
+			SourceModelSection &section = header.sections[header.sectionsNum];
+			section.kind = kinds[array];
+			section.plane = 0;
+			section.offset = offset;
+			section.size = (quint64)arrays[array]->size() * sizeof(quint32);
+			section.checksum = CalcChecksum((const uchar *)arrays[array]->constData(), section.size);
+			sectionsData[header.sectionsNum] = (const uchar *)arrays[array]->constData();
+
+			offset += AlignedSize(section.size);
+			++header.sectionsNum;
+		}
+	}
+
+	header.headerChecksum = CalcHeaderChecksum(header);
+
+	QFile file(t_path);
+	if ( false == file.open(QIODevice::WriteOnly | QIODevice::Truncate) )
+	{
+		qDebug() << "Save(): Error - can't open file" << t_path;
+		return false;
+	}
+
+	const char padding[PLANE_ALIGNMENT] = { 0 };
+	bool written = ( (qint64)sizeof(header) == file.write((const char *)&header, sizeof(header)) );
+	quint64 position = sizeof(header);
+	for ( unsigned int section = 0; (true == written) && (section < header.sectionsNum); section++ )
+	{
+		const SourceModelSection &info = header.sections[section];
+		const qint64 paddingSize = (qint64)(info.offset - position);
+		written = ( paddingSize == file.write(padding, paddingSize) );
+		written = written && ( (qint64)info.size == file.write((const char *)sectionsData[section], info.size) );
+		position = info.offset + info.size;
+	}
+
+	file.close();
+	if ( false == written )
+	{
+		qDebug() << "Save(): Error - can't write file" << t_path;
+		QFile::remove(t_path);
+		return false;
+	}
+
+	return true;
+}
+
+// Open file of model and check it. File is mapped to memory until Close().
+// @input:
+// - QString - unempty path to file of model
+// @output:
+// - true - model is opened, planes could be got
+// - false - can't open file or file is not compatible model
+bool SourceModelFile::Open(const QString &t_path)
+{
+	Close();
+
+	if ( true == t_path.isEmpty() )
+	{
+		qDebug() << "Open(): Error - invalid arguments";
+		return false;
+	}
+
+	m_file.setFileName(t_path);
+	if ( false == m_file.open(QIODevice::ReadOnly) )
+	{
+		qDebug() << "Open(): Error - can't open file" << t_path;
+		return false;
+	}
+
+	m_dataSize = m_file.size();
+	if ( m_dataSize < (qint64)sizeof(SourceModelHeader) )
+	{
+		qDebug() << "Open(): Error - file is not a model" << t_path;
+		Close();
+		return false;
+	}
+
+	m_data = m_file.map(0, m_dataSize);
+	if ( NULL == m_data )
+	{
+		qDebug() << "Open(): Error - can't map file" << t_path;
+		Close();
+		return false;
+	}
+
+	const SourceModelHeader *header = (const SourceModelHeader *)m_data;
+	if ( false == CheckHeader(*header) )
+	{
+		qDebug() << "Open(): Error - model is not compatible" << t_path;
+		Close();
+		return false;
+	}
+
+	for ( unsigned int section = 0; section < header->sectionsNum; section++ )
+	{
+		const SourceModelSection &info = header->sections[section];
+		if ( info.checksum != CalcChecksum(m_data + info.offset, info.size) )
+		{
+			qDebug() << "Open(): Error - model is corrupted" << t_path;
+			Close();
+			return false;
+		}
+	}
+
+	m_header = header;
+
+	return true;
+}
+
+// Close file of model
+// @input:
+// @output:
+void SourceModelFile::Close()
+{
+	if ( NULL != m_data )
+	{
+		m_file.unmap(m_data);
+	}
+
+	if ( true == m_file.isOpen() )
+	{
+		m_file.close();
+	}
+
+	m_data = NULL;
+	m_dataSize = 0;
+	m_header = NULL;
+}
+
+// Check if file of model is opened
+// @input:
+// @output:
+// - true - model is opened and checked
+// - false - no model
+bool SourceModelFile::IsOpened() const
+{
+	return ( NULL != m_header );
+}
+
+// Get width of image of model
+// @input:
+// @output:
+// - unsigned int - width of image (0 if model is not opened)
+unsigned int SourceModelFile::GetWidth() const
+{
+	if ( NULL == m_header )
+	{
+		return 0;
+	}
+
+	return m_header->width;
+}
+
+// Get height of image of model
+// @input:
+// @output:
+// - unsigned int - height of image (0 if model is not opened)
+unsigned int SourceModelFile::GetHeight() const
+{
+	if ( NULL == m_header )
+	{
+		return 0;
+	}
+
+	return m_header->height;
+}
+
+// Get side of mask, with which feature of model was calculated
+// @input:
+// - Feature::Type - exist feature
+// @output:
+// - unsigned int - side of mask (0 if model has no such feature)
+unsigned int SourceModelFile::GetFeatureMaskSide(const Feature::Type &t_feature) const
+{
+	if ( (NULL == m_header) || (t_feature < Feature::SKO) || (Feature::DEFAULT_LAST <= t_feature) )
+	{
+		return 0;
+	}
+
+	return m_header->featureMaskSides[t_feature];
+}
+
+// Get plane of model
+// @input:
+// - Plane::Type - exist type of plane
+// @output:
+// - const PlaneValue * - values of plane in mapped file (width * height values)
+// - NULL - model has no such plane
+const PlaneValue *SourceModelFile::GetPlane(const Plane::Type &t_type) const
+{
+	const SourceModelSection *section = FindSection(ModelSection::PLANE, (unsigned int)t_type);
+	if ( NULL == section )
+	{
+		return NULL;
+	}
+
+	return (const PlaneValue *)(m_data + section->offset);
+}
+
+// Get byte plane of model
+// @input:
+// - BytePlane::Type - exist type of byte plane
+// @output:
+// - const unsigned char * - values of plane in mapped file (width * height values)
+// - NULL - model has no such plane
+const unsigned char *SourceModelFile::GetBytePlane(const BytePlane::Type &t_type) const
+{
+	const SourceModelSection *section = FindSection(ModelSection::BYTE_PLANE, (unsigned int)t_type);
+	if ( NULL == section )
+	{
+		return NULL;
+	}
+
+	return (const unsigned char *)(m_data + section->offset);
+}
+
+// Get side of mask of SKO, with which look up table of model was formed
+// @input:
+// @output:
+// - unsigned int - side of mask (0 if model has no look up table)
+unsigned int SourceModelFile::GetLookUpMaskSide() const
+{
+	if ( NULL == m_header )
+	{
+		return 0;
+	}
+
+	return m_header->lookUpMaskSide;
+}
+
+// Restore look up table of model. Arrays of table are copied, because file is closed after load.
+// @input:
+// - ImgLookUpTable - table to restore
+// - QByteArray - key of data of restored Source image, for which table is formed
+// @output:
+// - true - table restored (or cleared, if model has no table)
+// - false - model is not opened or table of model is invalid
+bool SourceModelFile::RestoreLookUpTable(ImgLookUpTable &t_table, const QByteArray &t_key) const
+{
+	t_table.Clear();
+	if ( NULL == m_header )
+	{
+		qDebug() << "RestoreLookUpTable(): Error - model is not opened";
+		return false;
+	}
+
+	if ( 0 == m_header->lookUpMaskSide )
+	{
+		return true;
+	}
+
+	const SourceModelSection *offsets = FindSection(ModelSection::LOOKUP_OFFSETS, 0);
+	const SourceModelSection *pixels = FindSection(ModelSection::LOOKUP_PIXELS, 0);
+	if ( (NULL == offsets) || (NULL == pixels) )
+	{
+		qDebug() << "RestoreLookUpTable(): Error - model has no arrays of look up table";
+		return false;
+	}
+
+	const unsigned int pixelsNum = (unsigned int)(pixels->size / sizeof(quint32));
+	return t_table.Restore(m_header->lookUpStepsNums[0],
+						   m_header->lookUpStepsNums[1],
+						   m_header->lookUpSteps[0],
+						   m_header->lookUpSteps[1],
+						   m_header->lookUpMaxPixelsPerCell,
+						   (const unsigned int *)(m_data + offsets->offset),
+						   (const unsigned int *)(m_data + pixels->offset),
+						   pixelsNum,
+						   m_header->width * m_header->height,
+						   t_key);
+}
+
+// Fill header with parameters of current program
+// @input:
+// - SourceModelHeader - header to fill
+// @output:
+void SourceModelFile::FormHeader(SourceModelHeader &t_header) const
+{
+	memset(&t_header, 0, sizeof(t_header));
+	memcpy(t_header.magic, SOURCE_MODEL_MAGIC, SOURCE_MODEL_MAGIC_SIZE);
+	t_header.byteOrder = SOURCE_MODEL_BYTE_ORDER;
+	t_header.version = SOURCE_MODEL_VERSION;
+	t_header.headerSize = sizeof(SourceModelHeader);
+	t_header.planeValueSize = sizeof(PlaneValue);
+	t_header.labMaxLum = LAB_MAX_LUM;
+	t_header.relativeDivider = RELATIVE_DIVIDER;
+	t_header.bestSKO = BEST_SKO;
+	t_header.skewOffset = SKEW_OFFSET;
+	t_header.kurtOffset = KURT_OFFSET;
+}
+
+// Check that header was written by compatible program and describes sections inside file
+// @input:
+// - SourceModelHeader - header from mapped file
+// @output:
+// - true - header is valid
+// - false - model could not be used
+bool SourceModelFile::CheckHeader(const SourceModelHeader &t_header) const
+{
+	SourceModelHeader current;
+	FormHeader(current);
+
+	if ( (0 != memcmp(t_header.magic, current.magic, SOURCE_MODEL_MAGIC_SIZE)) ||
+		 (current.byteOrder != t_header.byteOrder) ||
+		 (current.version != t_header.version) ||
+		 (current.headerSize != t_header.headerSize) ||
+		 (current.planeValueSize != t_header.planeValueSize) )
+	{
+		qDebug() << "CheckHeader(): Error - unknown format of model";
+		return false;
+	}
+
+	if ( CalcHeaderChecksum(t_header) != t_header.headerChecksum )
+	{
+		qDebug() << "CheckHeader(): Error - header is corrupted";
+		return false;
+	}
+
+	if ( (current.labMaxLum != t_header.labMaxLum) ||
+		 (current.relativeDivider != t_header.relativeDivider) ||
+		 (current.bestSKO != t_header.bestSKO) ||
+		 (current.skewOffset != t_header.skewOffset) ||
+		 (current.kurtOffset != t_header.kurtOffset) )
+	{
+		qDebug() << "CheckHeader(): Error - model was created with other parameters";
+		return false;
+	}
+
+	if ( (0 == t_header.width) || (0 == t_header.height) || (SOURCE_MODEL_MAX_SECTIONS < t_header.sectionsNum) )
+	{
+		qDebug() << "CheckHeader(): Error - invalid size of model";
+		return false;
+	}
+
+	const quint64 pixelsNum = (quint64)t_header.width * t_header.height;
+	const quint64 lookUpCellsNum = (quint64)t_header.lookUpStepsNums[0] * t_header.lookUpStepsNums[1];
+	if ( (0 != t_header.lookUpMaskSide) &&
+		 ((t_header.featureMaskSides[Feature::SKO] != t_header.lookUpMaskSide) ||
+		  (0 == lookUpCellsNum) ||
+		  ((quint64)INT_MAX <= lookUpCellsNum) ||
+		  (UINT_MAX <= pixelsNum)) )
+	{
+		qDebug() << "CheckHeader(): Error - invalid look up table of model";
+		return false;
+	}
+
+	for ( unsigned int section = 0; section < t_header.sectionsNum; section++ )
+	{
+		const SourceModelSection &info = t_header.sections[section];
+		quint64 expectedSize = 0;
+		switch( info.kind )
+		{
+			case ModelSection::PLANE:
+				if ( info.plane < (quint32)Plane::DEFAULT_LAST )
+				{
+					expectedSize = pixelsNum * sizeof(PlaneValue);
+				}
+				break;
+
+			case ModelSection::BYTE_PLANE:
+				if ( info.plane < (quint32)BytePlane::DEFAULT_LAST )
+				{
+					expectedSize = pixelsNum;
+				}
+				break;
+
+			case ModelSection::LOOKUP_OFFSETS:
+				if ( (0 != t_header.lookUpMaskSide) && (0 == info.plane) )
+				{
+					expectedSize = (lookUpCellsNum + 1) * sizeof(quint32);
+				}
+				break;
+
+			case ModelSection::LOOKUP_PIXELS:
+				// Table keeps not more indexes of pixels than image has
+				if ( (0 != t_header.lookUpMaskSide) &&
+					 (0 == info.plane) &&
+					 (0 == info.size % sizeof(quint32)) &&
+					 (info.size / sizeof(quint32) <= pixelsNum) )
+				{
+					expectedSize = info.size;
+				}
+				break;
+
+			case ModelSection::DEFAULT_LAST:
+			default:
+				break;
+		}
+
+		if ( (0 == expectedSize) ||
+			 (expectedSize != info.size) ||
+			 (0 != info.offset % PLANE_ALIGNMENT) ||
+			 (info.offset < sizeof(SourceModelHeader)) ||
+			 (info.offset > (quint64)m_dataSize) ||
+			 (info.size > (quint64)m_dataSize - info.offset) )
+		{
+			qDebug() << "CheckHeader(): Error - invalid section" << section;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Find section of model
+// @input:
+// - ModelSection::Type - exist kind of section
+// - unsigned int - type of plane
+// @output:
+// - SourceModelSection * - info about section
+// - NULL - model is not opened or has no such section
+const SourceModelSection *SourceModelFile::FindSection(const ModelSection::Type &t_kind,
+													   const unsigned int &t_plane) const
+{
+	if ( NULL == m_header )
+	{
+		return NULL;
+	}
+
+	for ( unsigned int section = 0; section < m_header->sectionsNum; section++ )
+	{
+		const SourceModelSection &info = m_header->sections[section];
+		if ( ((quint32)t_kind == info.kind) && (t_plane == info.plane) )
+		{
+			return &info;
+		}
+	}
+
+	return NULL;
+}
+
+// Calc checksum of data. It's FNV-1a for 64-bit words (and bytes of tail), so it's fast enough to check all
+// planes on load.
+// @input:
+// - uchar * - unnull data
+// - quint64 - size of data in bytes
+// @output:
+// - quint64 - checksum
+quint64 SourceModelFile::CalcChecksum(const uchar *t_data, const quint64 &t_size) const
+{
+	quint64 checksum = SOURCE_MODEL_CHECKSUM_BASIS;
+	const quint64 wordsNum = t_size / sizeof(quint64);
+	for ( quint64 word = 0; word < wordsNum; word++ )
+	{
+		quint64 value = 0;
+		memcpy(&value, t_data + word * sizeof(quint64), sizeof(quint64));
+		checksum ^= value;
+		checksum *= SOURCE_MODEL_CHECKSUM_PRIME;
+	}
+
+	for ( quint64 byte = wordsNum * sizeof(quint64); byte < t_size; byte++ )
+	{
+		checksum ^= t_data[byte];
+		checksum *= SOURCE_MODEL_CHECKSUM_PRIME;
+	}
+
+	return checksum;
+}
+
+// Calc checksum of header
+// @input:
+// - SourceModelHeader - header of model
+// @output:
+// - quint64 - checksum of header without field of checksum
+quint64 SourceModelFile::CalcHeaderChecksum(const SourceModelHeader &t_header) const
+{
+	SourceModelHeader header = t_header;
+	header.headerChecksum = 0;
+
+	return CalcChecksum((const uchar *)&header, sizeof(header));
+}
+
+// Get size of data with padding to PLANE_ALIGNMENT
+// @input:
+// - quint64 - size of data in bytes
+// @output:
+// - quint64 - aligned size
+quint64 SourceModelFile::AlignedSize(const quint64 &t_size) const
+{
+	return (t_size + PLANE_ALIGNMENT - 1) / PLANE_ALIGNMENT * PLANE_ALIGNMENT;
+}
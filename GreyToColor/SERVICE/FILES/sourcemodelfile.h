@@ -0,0 +1,145 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOURCEMODELFILE_H
+#define SOURCEMODELFILE_H
+
+#include <string.h>
+#include <QFile>
+#include <QString>
+#include <QDebug>
+#include <QtGlobal>
+#include "./DEFINES/global.h"
+#include "./DEFINES/images.h"
+#include "./DEFINES/pixels.h"
+#include "./DEFINES/calcsko.h"
+#include "./IMAGES/COMMON/PIXELS/planevalue.h"
+#include "./SERVICE/IMAGES/imglookuptable.h"
+
+class SourceImage;
+
+// Max number of sections in file of Source model: all planes, all byte planes and two arrays of look up table
+#define SOURCE_MODEL_MAX_SECTIONS (Plane::DEFAULT_LAST + BytePlane::DEFAULT_LAST + 2)
+
+// Section of file of Source model: values of one plane of pixels or one array of look up table
+struct SourceModelSection
+{
+	// ModelSection::Type
+	quint32 kind;
+	// Plane::Type or BytePlane::Type (0 for arrays of look up table)
+	quint32 plane;
+	// Position of values in file (aligned to PLANE_ALIGNMENT)
+	quint64 offset;
+	quint64 size;
+	quint64 checksum;
+};
+
+// Header of file of Source model. All fields have natural alignment, so structure has no padding and it's
+// written to file as is.
+struct SourceModelHeader
+{
+	char magic[SOURCE_MODEL_MAGIC_SIZE];
+	quint32 byteOrder;
+	quint32 version;
+	quint32 headerSize;
+	// sizeof(PlaneValue) of program, which wrote file
+	quint32 planeValueSize;
+	quint32 width;
+	quint32 height;
+	// Sides of masks of features (0 - feature is not saved)
+	quint32 featureMaskSides[Feature::DEFAULT_LAST];
+	quint32 sectionsNum;
+	// Look up table of pixels by relative luminance and SKO: side of mask of SKO, with which table is formed
+	// (0 - table is not saved), numbers of steps of features and max number of pixels in cell
+	quint32 lookUpMaskSide;
+	quint32 lookUpStepsNums[2];
+	quint32 lookUpMaxPixelsPerCell;
+	// Constants, with which luminance and features were calculated
+	double labMaxLum;
+	double relativeDivider;
+	double bestSKO;
+	double skewOffset;
+	double kurtOffset;
+	// Steps of values of features in look up table
+	double lookUpSteps[2];
+	SourceModelSection sections[SOURCE_MODEL_MAX_SECTIONS];
+	// Checksum of header (calculated with this field set to 0)
+	quint64 headerChecksum;
+};
+
+// Class SourceModelFile
+// File of Source model keeps prepared Source image: LAB planes, relative luminance, RGB values, actual
+// features of pixels and look up table of pixels. Values of planes and arrays of table are written as they are
+// in memory, each of them starts at aligned position. File is mapped to memory, and load takes two passes
+// over it: check of checksums of sections and copy of planes and table to Source image (planes are changed
+// by colorization, so they are not used in mapped file). Load doesn't decode image and doesn't calc features
+// and table. Model is rejected if it was written by other version of format, by program with other type of
+// values of planes or other constants of luminance and features.
+class SourceModelFile
+{
+	// == DATA ==
+private:
+	QFile m_file;
+	uchar *m_data;
+	qint64 m_dataSize;
+	const SourceModelHeader *m_header;
+
+	// == METHODS ==
+public:
+	SourceModelFile();
+	~SourceModelFile();
+
+	// Write model of Source image to file
+	bool Save(const QString &t_path, SourceImage *t_source, const ImgLookUpTable *t_lookUpTable);
+	// Open file of model and check it
+	bool Open(const QString &t_path);
+	// Close file of model
+	void Close();
+	// Check if file of model is opened
+	bool IsOpened() const;
+	// Get width of image of model
+	unsigned int GetWidth() const;
+	// Get height of image of model
+	unsigned int GetHeight() const;
+	// Get side of mask, with which feature of model was calculated
+	unsigned int GetFeatureMaskSide(const Feature::Type &t_feature) const;
+	// Get plane of model
+	const PlaneValue *GetPlane(const Plane::Type &t_type) const;
+	// Get byte plane of model
+	const unsigned char *GetBytePlane(const BytePlane::Type &t_type) const;
+	// Get side of mask of SKO, with which look up table of model was formed
+	unsigned int GetLookUpMaskSide() const;
+	// Restore look up table of model
+	bool RestoreLookUpTable(ImgLookUpTable &t_table, const QByteArray &t_key) const;
+
+private:
+	// Fill header with parameters of current program
+	void FormHeader(SourceModelHeader &t_header) const;
+	// Check that header was written by compatible program and describes sections inside file
+	bool CheckHeader(const SourceModelHeader &t_header) const;
+	// Find section of model
+	const SourceModelSection *FindSection(const ModelSection::Type &t_kind, const unsigned int &t_plane) const;
+	// Calc checksum of data
+	quint64 CalcChecksum(const uchar *t_data, const quint64 &t_size) const;
+	// Calc checksum of header
+	quint64 CalcHeaderChecksum(const SourceModelHeader &t_header) const;
+	// Get size of data with padding to PLANE_ALIGNMENT
+	quint64 AlignedSize(const quint64 &t_size) const;
+};
+
+#endif // SOURCEMODELFILE_H
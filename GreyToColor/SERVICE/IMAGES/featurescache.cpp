@@ -0,0 +1,193 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "featurescache.h"
+
+FeaturesCache::FeaturesCache()
+{
+	m_maxBytesNum = FEATURES_CACHE_MAX_BYTES;
+	Clear();
+}
+
+FeaturesCache::~FeaturesCache()
+{
+	Clear();
+}
+
+// Remove all values from cache
+// @input:
+// @output:
+void FeaturesCache::Clear()
+{
+	m_values.clear();
+	m_usageOrder.clear();
+	m_bytesNum = 0;
+}
+
+// Set max size of cached values in bytes
+// @input:
+// - qint64 - positive max size of cache (or 0 to switch off cache)
+// @output:
+void FeaturesCache::SetMaxSize(const qint64 &t_maxBytesNum)
+{
+	if ( t_maxBytesNum < 0 )
+	{
+		qDebug() << "SetMaxSize(): Error - invalid arguments";
+		return;
+	}
+
+	m_maxBytesNum = t_maxBytesNum;
+	RemoveOldValues();
+}
+
+// Set to Source image features, which are cached for its luminance
+// @input:
+// - SourceImage - unnull Source image
+// - QByteArray - unempty hash of relative luminance of Source image
+// @output:
+// - int - number of features, which were restored from cache
+int FeaturesCache::RestoreFeatures(SourceImage *t_source, const QByteArray &t_lumHash)
+{
+	if ( (NULL == t_source) || (true == t_lumHash.isEmpty()) )
+	{
+		qDebug() << "RestoreFeatures(): Error - invalid arguments";
+		return 0;
+	}
+
+	int restoredNum = 0;
+	for ( int feature = 0; feature < Feature::DEFAULT_LAST; feature++ )
+	{
+		const Feature::Type type = (Feature::Type)feature;
+		const QByteArray key = FormKey(t_lumHash, type, t_source->GetFeatureMaskSide(type));
+		if ( false == m_values.contains(key) )
+		{
+			continue;
+		}
+
+		Touch(key);
+		if ( true == t_source->HasActualFeature(type) )
+		{
+			continue;
+		}
+
+		bool imported = t_source->ImportFeature(type, m_values.value(key));
+		if ( false == imported )
+		{
+			qDebug() << "RestoreFeatures(): Error - can't set feature" << feature;
+			continue;
+		}
+
+		++restoredNum;
+	}
+
+	return restoredNum;
+}
+
+// Save to cache actual features of Source image
+// @input:
+// - SourceImage - unnull Source image
+// - QByteArray - unempty hash of relative luminance of Source image
+// @output:
+// - int - number of features, which were saved
+int FeaturesCache::SaveFeatures(const SourceImage *t_source, const QByteArray &t_lumHash)
+{
+	if ( (NULL == t_source) || (true == t_lumHash.isEmpty()) )
+	{
+		qDebug() << "SaveFeatures(): Error - invalid arguments";
+		return 0;
+	}
+
+	int savedNum = 0;
+	for ( int feature = 0; feature < Feature::DEFAULT_LAST; feature++ )
+	{
+		const Feature::Type type = (Feature::Type)feature;
+		const QByteArray key = FormKey(t_lumHash, type, t_source->GetFeatureMaskSide(type));
+		if ( (true == m_values.contains(key)) || (false == t_source->HasActualFeature(type)) )
+		{
+			continue;
+		}
+
+		QVector<PlaneValue> values;
+		bool exported = t_source->ExportFeature(type, values);
+		if ( (false == exported) || (m_maxBytesNum < ValuesSize(values)) )
+		{
+			continue;
+		}
+
+		m_values.insert(key, values);
+		m_usageOrder.append(key);
+		m_bytesNum += ValuesSize(values);
+		++savedNum;
+	}
+
+	RemoveOldValues();
+
+	return savedNum;
+}
+
+// Get key of feature for luminance with certain hash
+// @input:
+// - QByteArray - unempty hash of relative luminance
+// - Feature::Type - exist feature
+// - unsigned int - side of mask, with which feature was calculated
+// @output:
+// - QByteArray - key of feature
+QByteArray FeaturesCache::FormKey(const QByteArray &t_lumHash,
+								  const Feature::Type &t_feature,
+								  const unsigned int &t_maskRectSide) const
+{
+	const int keyParams[2] = { (int)t_feature, (int)t_maskRectSide };
+
+	QByteArray key = t_lumHash;
+	key.append((const char *)keyParams, sizeof(keyParams));
+
+	return key;
+}
+
+// Get size of cached values in bytes
+// @input:
+// - QVector<PlaneValue> - values of feature
+// @output:
+// - qint64 - size of values
+qint64 FeaturesCache::ValuesSize(const QVector<PlaneValue> &t_values) const
+{
+	return (qint64)t_values.size() * (qint64)sizeof(PlaneValue);
+}
+
+// Mark value as most recently used
+// @input:
+// - QByteArray - exist key of value
+// @output:
+void FeaturesCache::Touch(const QByteArray &t_key)
+{
+	m_usageOrder.removeOne(t_key);
+	m_usageOrder.append(t_key);
+}
+
+// Remove least recently used values until size of cache is not bigger than limit
+// @input:
+// @output:
+void FeaturesCache::RemoveOldValues()
+{
+	while ( (m_maxBytesNum < m_bytesNum) && (false == m_usageOrder.isEmpty()) )
+	{
+		const QByteArray key = m_usageOrder.takeFirst();
+		m_bytesNum -= ValuesSize(m_values.value(key));
+		m_values.remove(key);
+	}
+}
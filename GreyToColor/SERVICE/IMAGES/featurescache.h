@@ -0,0 +1,76 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FEATURESCACHE_H
+#define FEATURESCACHE_H
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QByteArray>
+#include <QDebug>
+#include "./IMAGES/SOURCE/sourceimage.h"
+#include "./DEFINES/pixels.h"
+#include "./DEFINES/imgservice.h"
+
+// Class FeaturesCache
+// Keeps calculated features of pixels of Source images in memory, so when Source image is loaded again (or
+// colorization is started with another Source image and then with the previous one), features are not
+// calculated again.
+// Features depend only on relative luminance of pixels and on size of masks, so key of cache is hash of
+// luminance (see SourceImage::GetRelLumHash()), type of feature and size of masks. Total size of cached values
+// is limited: when it's exceeded, least recently used values are removed.
+class FeaturesCache
+{
+	// == DATA ==
+private:
+	// Values of features
+	QHash<QByteArray, QVector<PlaneValue> > m_values;
+	// Keys of values from least to most recently used
+	QList<QByteArray> m_usageOrder;
+	qint64 m_bytesNum;
+	qint64 m_maxBytesNum;
+
+	// == METHODS ==
+public:
+	FeaturesCache();
+	~FeaturesCache();
+
+	// Remove all values from cache
+	void Clear();
+	// Set max size of cached values in bytes
+	void SetMaxSize(const qint64 &t_maxBytesNum);
+	// Set to Source image features, which are cached for its luminance
+	int RestoreFeatures(SourceImage *t_source, const QByteArray &t_lumHash);
+	// Save to cache actual features of Source image
+	int SaveFeatures(const SourceImage *t_source, const QByteArray &t_lumHash);
+
+private:
+	// Get key of feature for luminance with certain hash
+	QByteArray FormKey(const QByteArray &t_lumHash,
+					   const Feature::Type &t_feature,
+					   const unsigned int &t_maskRectSide) const;
+	// Get size of cached values in bytes
+	qint64 ValuesSize(const QVector<PlaneValue> &t_values) const;
+	// Mark value as most recently used
+	void Touch(const QByteArray &t_key);
+	// Remove least recently used values until size of cache is not bigger than limit
+	void RemoveOldValues();
+};
+
+#endif // FEATURESCACHE_H
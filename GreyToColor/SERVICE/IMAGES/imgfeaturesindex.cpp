@@ -0,0 +1,527 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "imgfeaturesindex.h"
+
+ImgFeaturesIndex::ImgFeaturesIndex()
+{
+	Clear();
+}
+
+ImgFeaturesIndex::~ImgFeaturesIndex()
+{
+	Clear();
+}
+
+// Clear index
+// @input:
+// @output:
+void ImgFeaturesIndex::Clear()
+{
+	m_points.clear();
+	m_splitFeatures.clear();
+	m_key.clear();
+}
+
+// Check if index is empty
+// @input:
+// @output:
+// - true - index has no points
+// - false - index has points
+bool ImgFeaturesIndex::IsEmpty() const
+{
+	return m_points.isEmpty();
+}
+
+// Get key of data, for which index is built
+// @input:
+// @output:
+// - QByteArray - key of data (empty if index is empty)
+QByteArray ImgFeaturesIndex::GetKey() const
+{
+	return m_key;
+}
+
+// Build index for features of pixels of image
+// @input:
+// - PlaneValue - unnull plane of relative luminance of pixels
+// - PlaneValue - unnull plane of SKO of pixels
+// - unsigned int - positive number of pixels
+// - QByteArray - key of data (to check later, if index is built for the same data)
+// @output:
+// - true - index built
+// - false - can't build index
+bool ImgFeaturesIndex::Build(const PlaneValue *t_lumPlane,
+							 const PlaneValue *t_skoPlane,
+							 const unsigned int &t_pixelsNum,
+							 const QByteArray &t_key)
+{
+	Clear();
+
+	if ( (NULL == t_lumPlane) ||
+		 (NULL == t_skoPlane) ||
+		 (0 == t_pixelsNum) ||
+		 ((unsigned int)INT_MAX <= t_pixelsNum) )
+	{
+		qDebug() << "Build(): Error - invalid arguments";
+		return false;
+	}
+
+	// Pixels with negative (unknown) features are not added to index
+	m_points.reserve(t_pixelsNum);
+	for ( unsigned int pix = 0; pix < t_pixelsNum; pix++ )
+	{
+		if ( (t_lumPlane[pix] < 0) || (t_skoPlane[pix] < 0) )
+		{
+			continue;
+		}
+
+		IndexPoint point;
+		point.lum = t_lumPlane[pix];
+		point.sko = t_skoPlane[pix];
+		point.pixel = pix;
+		m_points.append(point);
+	}
+
+	if ( true == m_points.isEmpty() )
+	{
+		qDebug() << "Build(): Error - image has no pixels with known features";
+		return false;
+	}
+
+	m_splitFeatures.fill(0, m_points.size());
+	BuildNode(0, m_points.size());
+	m_key = t_key;
+
+	return true;
+}
+
+// Build node of tree for range of points
+// @input:
+// - int - first point of range
+// - int - point after last point of range
+// @output:
+void ImgFeaturesIndex::BuildNode(const int &t_first, const int &t_last)
+{
+	if ( t_last - t_first <= INDEX_LEAF_SIZE )
+	{
+		return;
+	}
+
+	// Split node by feature with bigger spread of values
+	const IndexPoint *points = m_points.constData();
+	double minLum = points[t_first].lum;
+	double maxLum = minLum;
+	double minSKO = points[t_first].sko;
+	double maxSKO = minSKO;
+	for ( int point = t_first + 1; point < t_last; point++ )
+	{
+		const double lum = points[point].lum;
+		const double sko = points[point].sko;
+		minLum = qMin(minLum, lum);
+		maxLum = qMax(maxLum, lum);
+		minSKO = qMin(minSKO, sko);
+		maxSKO = qMax(maxSKO, sko);
+	}
+
+	int feature = 0;
+	if ( (maxLum - minLum) < (maxSKO - minSKO) )
+	{
+		feature = 1;
+	}
+
+	const int median = t_first + (t_last - t_first) / 2;
+	SelectMedian(t_first, t_last, median, feature);
+	m_splitFeatures[median] = (unsigned char)feature;
+
+	BuildNode(t_first, median);
+	BuildNode(median + 1, t_last);
+}
+
+// Put to position of median point of range the point, which should be there if range was sorted by feature.
+// Points before it will have not bigger values of feature, points after it - not smaller.
+// @input:
+// - int - first point of range
+// - int - point after last point of range
+// - int - median point of range
+// - int - feature (0 - luminance, 1 - SKO)
+// @output:
+void ImgFeaturesIndex::SelectMedian(int t_first, int t_last, const int &t_median, const int &t_feature)
+{
+	IndexPoint *points = m_points.data();
+	while ( t_first + 1 < t_last )
+	{
+		// Pivot is median of first, middle and last values of range
+		const double firstValue = GetFeature(points[t_first], t_feature);
+		const double middleValue = GetFeature(points[t_first + (t_last - t_first) / 2], t_feature);
+		const double lastValue = GetFeature(points[t_last - 1], t_feature);
+		const double pivot = qMax( qMin(firstValue, middleValue), qMin( qMax(firstValue, middleValue), lastValue ) );
+
+		int left = t_first;
+		int right = t_last - 1;
+		while ( left <= right )
+		{
+			while ( GetFeature(points[left], t_feature) < pivot )
+			{
+				left++;
+			}
+
+			while ( pivot < GetFeature(points[right], t_feature) )
+			{
+				right--;
+			}
+
+			if ( left <= right )
+			{
+				const IndexPoint point = points[left];
+				points[left] = points[right];
+				points[right] = point;
+				left++;
+				right--;
+			}
+		}
+
+		// Now points [t_first, right] are not bigger than pivot, points [left, t_last) are not smaller, and points
+		// between them are equal to pivot
+		if ( t_median <= right )
+		{
+			t_last = right + 1;
+		}
+		else if ( left <= t_median )
+		{
+			t_first = left;
+		}
+		else
+		{
+			return;
+		}
+	}
+}
+
+// Find pixels with nearest features
+// @input:
+// - double - relative luminance
+// - double - SKO
+// - unsigned int - number of pixels to find in range [1, INDEX_MAX_NEIGHBORS]
+// - unsigned int - max number of checked points (0 - exact search)
+// - unsigned int - unnull array for found pixels (for requested number of pixels)
+// @output:
+// - unsigned int - number of found pixels. Pixels are sorted from nearest one
+unsigned int ImgFeaturesIndex::FindNeighbors(const double &t_lum,
+											 const double &t_sko,
+											 const unsigned int &t_neighborsNum,
+											 const unsigned int &t_maxChecks,
+											 unsigned int *t_pixels) const
+{
+	if ( (0 == t_neighborsNum) || (INDEX_MAX_NEIGHBORS < t_neighborsNum) || (NULL == t_pixels) )
+	{
+		qDebug() << "FindNeighbors(): Error - invalid arguments";
+		return 0;
+	}
+
+	if ( true == m_points.isEmpty() )
+	{
+		return 0;
+	}
+
+	IndexSearch search;
+	InitSearch(t_lum, t_sko, t_neighborsNum, t_maxChecks, search);
+	SearchNode(0, m_points.size(), search);
+
+	const IndexPoint *points = m_points.constData();
+	for ( unsigned int neighbor = 0; neighbor < search.neighborsNum; neighbor++ )
+	{
+		t_pixels[neighbor] = points[search.points[neighbor]].pixel;
+	}
+
+	return search.neighborsNum;
+}
+
+// Find pixel with most similar features: it's chosen from INDEX_SIMILAR_NEIGHBORS nearest pixels with the same
+// rule, as in colorization methods: pixel is better, if its difference of luminance is smaller and difference
+// of SKO is not bigger more than by SKO_TRESHOLD, or vice versa with LUM_TRESHOLD.
+// @input:
+// - double - relative luminance
+// - double - SKO
+// - unsigned int - max number of checked points (0 - exact search)
+// - unsigned int - variable for found pixel
+// @output:
+// - true - pixel found
+// - false - index is empty
+bool ImgFeaturesIndex::FindSimilar(const double &t_lum,
+								   const double &t_sko,
+								   const unsigned int &t_maxChecks,
+								   unsigned int &t_pixel) const
+{
+	if ( true == m_points.isEmpty() )
+	{
+		return false;
+	}
+
+	IndexSearch search;
+	InitSearch(t_lum, t_sko, INDEX_SIMILAR_NEIGHBORS, t_maxChecks, search);
+	SearchNode(0, m_points.size(), search);
+
+	double bestDiffLum = DEFAULT_LUM;
+	double bestDiffSKO = DEFAULT_SKO;
+	const IndexPoint *points = m_points.constData();
+	for ( unsigned int neighbor = 0; neighbor < search.neighborsNum; neighbor++ )
+	{
+		const IndexPoint &point = points[search.points[neighbor]];
+		const double diffLum = fabs( t_lum - point.lum );
+		const double diffSKO = fabs( t_sko - point.sko );
+
+		if ( ( (diffLum < bestDiffLum) && (diffSKO < (bestDiffSKO + SKO_TRESHOLD)) ) ||
+			 ( (diffLum < (bestDiffLum + LUM_TRESHOLD)) && (diffSKO < bestDiffSKO) ) )
+		{
+			bestDiffLum = diffLum;
+			bestDiffSKO = diffSKO;
+			t_pixel = point.pixel;
+		}
+	}
+
+	return ( 0 < search.neighborsNum );
+}
+
+// Start search of nearest points
+// @input:
+// - double - relative luminance
+// - double - SKO
+// - unsigned int - number of points to find in range [1, INDEX_MAX_NEIGHBORS]
+// - unsigned int - max number of checked points (0 - exact search)
+// - IndexSearch - search to init
+// @output:
+void ImgFeaturesIndex::InitSearch(const double &t_lum,
+								  const double &t_sko,
+								  const unsigned int &t_neighborsNum,
+								  const unsigned int &t_maxChecks,
+								  IndexSearch &t_search) const
+{
+	t_search.lum = t_lum;
+	t_search.sko = t_sko;
+	t_search.neighborsMaxNum = qMin(t_neighborsNum, (unsigned int)INDEX_MAX_NEIGHBORS);
+	t_search.maxChecks = t_maxChecks;
+	t_search.checksNum = 0;
+	t_search.neighborsNum = 0;
+}
+
+// Search nearest points in node of tree. Firstly it checks median point of node and child node, which contains
+// searched features, then - other child, if it could contain points nearer than found ones.
+// @input:
+// - int - first point of node
+// - int - point after last point of node
+// - IndexSearch - current search
+// @output:
+void ImgFeaturesIndex::SearchNode(const int &t_first, const int &t_last, IndexSearch &t_search) const
+{
+	const IndexPoint *points = m_points.constData();
+	if ( t_last - t_first <= INDEX_LEAF_SIZE )
+	{
+		for ( int point = t_first; point < t_last; point++ )
+		{
+			const double diffLum = t_search.lum - points[point].lum;
+			const double diffSKO = t_search.sko - points[point].sko;
+			AddNeighbor(point, diffLum * diffLum + diffSKO * diffSKO, t_search);
+		}
+
+		t_search.checksNum += t_last - t_first;
+		return;
+	}
+
+	const int median = t_first + (t_last - t_first) / 2;
+	const int feature = m_splitFeatures[median];
+	double searchValue = t_search.lum;
+	if ( 1 == feature )
+	{
+		searchValue = t_search.sko;
+	}
+
+	const double diffLum = t_search.lum - points[median].lum;
+	const double diffSKO = t_search.sko - points[median].sko;
+	AddNeighbor(median, diffLum * diffLum + diffSKO * diffSKO, t_search);
+	t_search.checksNum++;
+
+	const double diff = searchValue - GetFeature(points[median], feature);
+	if ( diff < 0 )
+	{
+		SearchNode(t_first, median, t_search);
+	}
+	else
+	{
+		SearchNode(median + 1, t_last, t_search);
+	}
+
+	const bool allFound = ( t_search.neighborsMaxNum <= t_search.neighborsNum );
+	if ( (true == allFound) && (0 < t_search.maxChecks) && (t_search.maxChecks <= t_search.checksNum) )
+	{
+		// Approximate search: enough points checked
+		return;
+	}
+
+	if ( (true == allFound) && (t_search.distances[t_search.neighborsNum - 1] <= diff * diff) )
+	{
+		// Other child is too far
+		return;
+	}
+
+	if ( diff < 0 )
+	{
+		SearchNode(median + 1, t_last, t_search);
+	}
+	else
+	{
+		SearchNode(t_first, median, t_search);
+	}
+}
+
+// Add point to found nearest points (if it's nearer than found ones)
+// @input:
+// - int - point
+// - double - square of distance from searched features to point
+// - IndexSearch - current search
+// @output:
+void ImgFeaturesIndex::AddNeighbor(const int &t_point, const double &t_distance, IndexSearch &t_search) const
+{
+	unsigned int position = t_search.neighborsNum;
+	if ( t_search.neighborsMaxNum <= position )
+	{
+		if ( t_search.distances[position - 1] <= t_distance )
+		{
+			return;
+		}
+
+		position--;
+	}
+	else
+	{
+		t_search.neighborsNum++;
+	}
+
+	// Insert point keeping neighbors sorted by distance
+	while ( (0 < position) && (t_distance < t_search.distances[position - 1]) )
+	{
+		t_search.distances[position] = t_search.distances[position - 1];
+		t_search.points[position] = t_search.points[position - 1];
+		position--;
+	}
+
+	t_search.distances[position] = t_distance;
+	t_search.points[position] = t_point;
+}
+
+// Get value of feature of point
+// @input:
+// - IndexPoint - point
+// - int - feature (0 - luminance, 1 - SKO)
+// @output:
+// - double - value of feature
+double ImgFeaturesIndex::GetFeature(const IndexPoint &t_point, const int &t_feature) const
+{
+	if ( 1 == t_feature )
+	{
+		return t_point.sko;
+	}
+
+	return t_point.lum;
+}
+
+// Compare nearest pixels found by FindNeighbors() (exact search) with nearest pixels found by linear scan of
+// all pixels. Features of pixels are random values on coarse grid, so many pixels have equal features and
+// there are ties of distances (and of values at medians of nodes). Some pixels have unknown features.
+void ImgFeaturesIndex::TestFindNeighbors()
+{
+	const unsigned int pixelsNum = 5000;
+	QVector<PlaneValue> lumPlane(pixelsNum);
+	QVector<PlaneValue> skoPlane(pixelsNum);
+	srand(1);
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
+	{
+		lumPlane[pix] = (rand() % 20) * 0.05;
+		skoPlane[pix] = (rand() % 10) * 0.1;
+		if ( 0 == rand() % 50 )
+		{
+			lumPlane[pix] = -1;
+		}
+	}
+
+	bool indexBuilt = Build(lumPlane.constData(), skoPlane.constData(), pixelsNum, QByteArray("test"));
+	if ( false == indexBuilt )
+	{
+		qDebug() << "Fail: Can't build index";
+		return;
+	}
+
+	const unsigned int neighborsNums[] = { 1, INDEX_SIMILAR_NEIGHBORS, INDEX_MAX_NEIGHBORS };
+	const unsigned int neighborsNumsNum = sizeof(neighborsNums) / sizeof(neighborsNums[0]);
+	const unsigned int searchesNum = 300;
+	unsigned int wrongSearches = 0;
+	for ( unsigned int search = 0; search < searchesNum; search++ )
+	{
+		// Half of searched features are on grid of features of pixels, others - between its values
+		double lum = (rand() % 21) * 0.05;
+		double sko = (rand() % 11) * 0.1;
+		if ( 1 == search % 2 )
+		{
+			lum += 0.025;
+			sko += 0.05;
+		}
+
+		QVector<double> scanDistances;
+		for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
+		{
+			if ( (lumPlane[pix] < 0) || (skoPlane[pix] < 0) )
+			{
+				continue;
+			}
+
+			const double diffLum = lum - lumPlane[pix];
+			const double diffSKO = sko - skoPlane[pix];
+			scanDistances.append(diffLum * diffLum + diffSKO * diffSKO);
+		}
+
+		qSort(scanDistances.begin(), scanDistances.end());
+
+		for ( unsigned int num = 0; num < neighborsNumsNum; num++ )
+		{
+			// Pixels could differ from pixels of scan in case of ties, but their distances should be the same
+			unsigned int pixels[INDEX_MAX_NEIGHBORS];
+			const unsigned int foundNum = FindNeighbors(lum, sko, neighborsNums[num], 0, pixels);
+			bool isCorrect = ( neighborsNums[num] == foundNum );
+			for ( unsigned int neighbor = 0; (true == isCorrect) && (neighbor < foundNum); neighbor++ )
+			{
+				const unsigned int pix = pixels[neighbor];
+				const double diffLum = lum - lumPlane[pix];
+				const double diffSKO = sko - skoPlane[pix];
+				isCorrect = ( (0 <= lumPlane[pix]) &&
+							  (diffLum * diffLum + diffSKO * diffSKO == scanDistances[neighbor]) );
+
+				for ( unsigned int prevNeighbor = 0; prevNeighbor < neighbor; prevNeighbor++ )
+				{
+					isCorrect = isCorrect && ( pixels[prevNeighbor] != pix );
+				}
+			}
+
+			if ( false == isCorrect )
+			{
+				wrongSearches++;
+			}
+		}
+	}
+
+	qDebug() << "TestFindNeighbors(): wrong searches:" << wrongSearches << "of" << searchesNum * neighborsNumsNum;
+}
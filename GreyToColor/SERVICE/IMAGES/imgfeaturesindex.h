@@ -0,0 +1,122 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMGFEATURESINDEX_H
+#define IMGFEATURESINDEX_H
+
+#include <QVector>
+#include <QByteArray>
+#include <QtAlgorithms>
+#include <QDebug>
+#include <math.h>
+#include <limits.h>
+#include <stdlib.h>
+#include "./DEFINES/imgservice.h"
+#include "./DEFINES/colorization.h"
+#include "./IMAGES/COMMON/PIXELS/planevalue.h"
+
+// Point of ImgFeaturesIndex: features of pixel and its index (y * width + x)
+struct IndexPoint
+{
+	PlaneValue lum;
+	PlaneValue sko;
+	unsigned int pixel;
+};
+
+// State of search of nearest points in ImgFeaturesIndex. Found points are sorted by distance
+struct IndexSearch
+{
+	double lum;
+	double sko;
+	unsigned int neighborsMaxNum;
+	unsigned int maxChecks;
+	unsigned int checksNum;
+	unsigned int neighborsNum;
+	double distances[INDEX_MAX_NEIGHBORS];
+	int points[INDEX_MAX_NEIGHBORS];
+};
+
+// Class ImgFeaturesIndex
+// Index of pixels of image by relative luminance and SKO for search of nearest neighbors (by euclidean distance
+// between features). It's a k-d tree, which is kept in one array of points: node for range of points
+// [first, last) is split by its median point (first + last) / 2 by feature with bigger spread of values - points
+// before median (left child) have not bigger value of this feature, points after median (right child) have not
+// smaller value. Ranges with no more than INDEX_LEAF_SIZE points are leaves.
+// Index is built once for pixels of image (it takes O(N * log(N))), and then search of nearest pixels takes
+// O(log(N)). Search could be exact or approximate: in last case it stops, when certain number of points checked.
+class ImgFeaturesIndex
+{
+	// == DATA ==
+private:
+	QVector<IndexPoint> m_points;
+	// Feature, by which node is split (index is median point of node)
+	QVector<unsigned char> m_splitFeatures;
+	// Key of data, for which index is built
+	QByteArray m_key;
+
+	// == METHODS ==
+public:
+	ImgFeaturesIndex();
+	~ImgFeaturesIndex();
+
+	// Clear index
+	void Clear();
+	// Check if index is empty
+	bool IsEmpty() const;
+	// Get key of data, for which index is built
+	QByteArray GetKey() const;
+	// Build index for features of pixels of image
+	bool Build(const PlaneValue *t_lumPlane,
+			   const PlaneValue *t_skoPlane,
+			   const unsigned int &t_pixelsNum,
+			   const QByteArray &t_key);
+	// Find pixels with nearest features
+	unsigned int FindNeighbors(const double &t_lum,
+							   const double &t_sko,
+							   const unsigned int &t_neighborsNum,
+							   const unsigned int &t_maxChecks,
+							   unsigned int *t_pixels) const;
+	// Find pixel with most similar features
+	bool FindSimilar(const double &t_lum,
+					 const double &t_sko,
+					 const unsigned int &t_maxChecks,
+					 unsigned int &t_pixel) const;
+
+	// Test search of nearest pixels
+	void TestFindNeighbors();
+
+private:
+	// Build node of tree for range of points
+	void BuildNode(const int &t_first, const int &t_last);
+	// Put to position of median point of range the point, which should be there if range was sorted by feature
+	void SelectMedian(int t_first, int t_last, const int &t_median, const int &t_feature);
+	// Start search of nearest points
+	void InitSearch(const double &t_lum,
+					const double &t_sko,
+					const unsigned int &t_neighborsNum,
+					const unsigned int &t_maxChecks,
+					IndexSearch &t_search) const;
+	// Search nearest points in node of tree
+	void SearchNode(const int &t_first, const int &t_last, IndexSearch &t_search) const;
+	// Add point to found nearest points
+	void AddNeighbor(const int &t_point, const double &t_distance, IndexSearch &t_search) const;
+	// Get value of feature of point
+	double GetFeature(const IndexPoint &t_point, const int &t_feature) const;
+};
+
+#endif // IMGFEATURESINDEX_H
@@ -0,0 +1,433 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "imglookuptable.h"
+
+ImgLookUpTable::ImgLookUpTable()
+{
+	Clear();
+}
+
+ImgLookUpTable::~ImgLookUpTable()
+{
+	Clear();
+}
+
+// Clear table
+// @input:
+// @output:
+void ImgLookUpTable::Clear()
+{
+	m_firstStepsNum = 0;
+	m_secondStepsNum = 0;
+	m_firstStep = 0;
+	m_secondStep = 0;
+	m_maxPixelsPerCell = 0;
+	m_key.clear();
+	m_cellOffsets.clear();
+	m_pixels.clear();
+}
+
+// Check if table is empty
+// @input:
+// @output:
+// - true - table has no pixels
+// - false - table has pixels
+bool ImgLookUpTable::IsEmpty() const
+{
+	return m_pixels.isEmpty();
+}
+
+// Form table for features of pixels of image
+// @input:
+// - PlaneValue - unnull plane of values of first feature of pixels
+// - PlaneValue - unnull plane of values of second feature of pixels
+// - unsigned int - positive width of image
+// - unsigned int - positive height of image
+// - double - positive step of values of first feature
+// - double - positive step of values of second feature
+// - unsigned int - max number of pixels in cell (0 - no limit). If cell has more pixels, they are taken evenly
+// - QByteArray - key of data, for which table is formed
+// @output:
+// - true - table formed
+// - false - can't form table
+bool ImgLookUpTable::Form(const PlaneValue *t_firstPlane,
+						  const PlaneValue *t_secondPlane,
+						  const unsigned int &t_width,
+						  const unsigned int &t_height,
+						  const double &t_firstStep,
+						  const double &t_secondStep,
+						  const unsigned int &t_maxPixelsPerCell,
+						  const QByteArray &t_key)
+{
+	Clear();
+
+	if ( (NULL == t_firstPlane) ||
+		 (NULL == t_secondPlane) ||
+		 (0 == t_width) ||
+		 (0 == t_height) ||
+		 (t_firstStep <= 0) ||
+		 (t_secondStep <= 0) )
+	{
+		qDebug() << "Form(): Error - invalid arguments";
+		return false;
+	}
+
+	// Find number of cells. Pixels with negative (unknown) features are not added to table
+	const unsigned int pixelsNum = t_width * t_height;
+	unsigned int firstStepNum = 0;
+	unsigned int secondStepNum = 0;
+	unsigned int maxFirstStepNum = 0;
+	unsigned int maxSecondStepNum = 0;
+	bool hasPixels = false;
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
+	{
+		if ( (false == GetValueStep(t_firstPlane[pix], t_firstStep, firstStepNum)) ||
+			 (false == GetValueStep(t_secondPlane[pix], t_secondStep, secondStepNum)) )
+		{
+			continue;
+		}
+
+		maxFirstStepNum = qMax(maxFirstStepNum, firstStepNum);
+		maxSecondStepNum = qMax(maxSecondStepNum, secondStepNum);
+		hasPixels = true;
+	}
+
+	if ( false == hasPixels )
+	{
+		qDebug() << "Form(): Error - image has no pixels with known features";
+		return false;
+	}
+
+	const double cellsNum = ((double)maxFirstStepNum + 1) * ((double)maxSecondStepNum + 1);
+	if ( (double)INT_MAX <= cellsNum )
+	{
+		qDebug() << "Form(): Error - too many cells in table";
+		return false;
+	}
+
+	m_firstStepsNum = maxFirstStepNum + 1;
+	m_secondStepsNum = maxSecondStepNum + 1;
+
+	// First pass: count pixels of each cell
+	const unsigned int noCell = m_firstStepsNum * m_secondStepsNum;
+	QVector<unsigned int> pixelCells(pixelsNum, noCell);
+	QVector<unsigned int> cellCounts(noCell, 0);
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
+	{
+		if ( (false == GetValueStep(t_firstPlane[pix], t_firstStep, firstStepNum)) ||
+			 (false == GetValueStep(t_secondPlane[pix], t_secondStep, secondStepNum)) )
+		{
+			continue;
+		}
+
+		const unsigned int cell = firstStepNum * m_secondStepsNum + secondStepNum;
+		pixelCells[pix] = cell;
+		cellCounts[cell]++;
+	}
+
+	// Offsets of cells. Cell with more pixels than limit keeps every step-th of them
+	m_cellOffsets.resize(noCell + 1);
+	QVector<unsigned int> cellSteps(noCell, 1);
+	unsigned int offset = 0;
+	for ( unsigned int cell = 0; cell < noCell; cell++ )
+	{
+		m_cellOffsets[cell] = offset;
+
+		unsigned int cellPixelsNum = cellCounts[cell];
+		if ( (0 < t_maxPixelsPerCell) && (t_maxPixelsPerCell < cellPixelsNum) )
+		{
+			cellSteps[cell] = cellPixelsNum / t_maxPixelsPerCell;
+			cellPixelsNum = t_maxPixelsPerCell;
+		}
+
+		offset += cellPixelsNum;
+		cellCounts[cell] = 0;
+	}
+
+	m_cellOffsets[noCell] = offset;
+	m_pixels.resize(offset);
+
+	// Second pass: put pixels to cells. Pixels of cell are ordered by columns of image (from left to right, and
+	// from top to bottom in column)
+	const unsigned int *cellOffsets = m_cellOffsets.constData();
+	unsigned int *pixels = m_pixels.data();
+	for ( unsigned int width = 0; width < t_width; width++ )
+	{
+		for ( unsigned int height = 0; height < t_height; height++ )
+		{
+			const unsigned int pix = height * t_width + width;
+			const unsigned int cell = pixelCells[pix];
+			if ( noCell == cell )
+			{
+				continue;
+			}
+
+			const unsigned int pixNumInCell = cellCounts[cell]++;
+			const unsigned int step = cellSteps[cell];
+			const unsigned int cellPos = pixNumInCell / step;
+			if ( (0 != pixNumInCell % step) || (cellOffsets[cell + 1] - cellOffsets[cell] <= cellPos) )
+			{
+				continue;
+			}
+
+			pixels[cellOffsets[cell] + cellPos] = pix;
+		}
+	}
+
+	m_firstStep = t_firstStep;
+	m_secondStep = t_secondStep;
+	m_maxPixelsPerCell = t_maxPixelsPerCell;
+	m_key = t_key;
+
+	return true;
+}
+
+// Restore table from arrays of formed table. Arrays are copied and checked: offsets of cells should not
+// decrease, and indexes of pixels should be inside image.
+// @input:
+// - unsigned int - positive number of steps of first feature
+// - unsigned int - positive number of steps of second feature
+// - double - positive step of values of first feature
+// - double - positive step of values of second feature
+// - unsigned int - max number of pixels in cell (0 - no limit)
+// - unsigned int - unnull offsets of cells (number of cells + 1 values)
+// - unsigned int - unnull indexes of pixels of all cells
+// - unsigned int - positive number of indexes of pixels
+// - unsigned int - positive number of pixels of image
+// - QByteArray - key of data, for which table is formed
+// @output:
+// - true - table restored
+// - false - invalid arrays of table
+bool ImgLookUpTable::Restore(const unsigned int &t_firstStepsNum,
+							 const unsigned int &t_secondStepsNum,
+							 const double &t_firstStep,
+							 const double &t_secondStep,
+							 const unsigned int &t_maxPixelsPerCell,
+							 const unsigned int *t_cellOffsets,
+							 const unsigned int *t_pixels,
+							 const unsigned int &t_pixelsNum,
+							 const unsigned int &t_imgPixelsNum,
+							 const QByteArray &t_key)
+{
+	Clear();
+
+	if ( (0 == t_firstStepsNum) ||
+		 (0 == t_secondStepsNum) ||
+		 (t_firstStep <= 0) ||
+		 (t_secondStep <= 0) ||
+		 (NULL == t_cellOffsets) ||
+		 (NULL == t_pixels) ||
+		 (0 == t_pixelsNum) ||
+		 (0 == t_imgPixelsNum) )
+	{
+		qDebug() << "Restore(): Error - invalid arguments";
+		return false;
+	}
+
+	const double cellsNum = (double)t_firstStepsNum * (double)t_secondStepsNum;
+	if ( (double)INT_MAX <= cellsNum )
+	{
+		qDebug() << "Restore(): Error - too many cells in table";
+		return false;
+	}
+
+	const unsigned int noCell = t_firstStepsNum * t_secondStepsNum;
+	if ( (0 != t_cellOffsets[0]) || (t_pixelsNum != t_cellOffsets[noCell]) )
+	{
+		qDebug() << "Restore(): Error - invalid offsets of cells";
+		return false;
+	}
+
+	for ( unsigned int cell = 0; cell < noCell; cell++ )
+	{
+		if ( t_cellOffsets[cell + 1] < t_cellOffsets[cell] )
+		{
+			qDebug() << "Restore(): Error - invalid offsets of cells";
+			return false;
+		}
+	}
+
+	for ( unsigned int pix = 0; pix < t_pixelsNum; pix++ )
+	{
+		if ( t_imgPixelsNum <= t_pixels[pix] )
+		{
+			qDebug() << "Restore(): Error - invalid pixels of cells";
+			return false;
+		}
+	}
+
+	m_cellOffsets.resize(noCell + 1);
+	memcpy(m_cellOffsets.data(), t_cellOffsets, (noCell + 1) * sizeof(unsigned int));
+	m_pixels.resize(t_pixelsNum);
+	memcpy(m_pixels.data(), t_pixels, t_pixelsNum * sizeof(unsigned int));
+
+	m_firstStepsNum = t_firstStepsNum;
+	m_secondStepsNum = t_secondStepsNum;
+	m_firstStep = t_firstStep;
+	m_secondStep = t_secondStep;
+	m_maxPixelsPerCell = t_maxPixelsPerCell;
+	m_key = t_key;
+
+	return true;
+}
+
+// Check if table is formed with such parameters for such data
+// @input:
+// - double - step of values of first feature
+// - double - step of values of second feature
+// - unsigned int - max number of pixels in cell
+// - QByteArray - key of data
+// @output:
+// - true - table could be used
+// - false - table is empty or formed for other data
+bool ImgLookUpTable::IsFormedFor(const double &t_firstStep,
+								 const double &t_secondStep,
+								 const unsigned int &t_maxPixelsPerCell,
+								 const QByteArray &t_key) const
+{
+	if ( true == IsEmpty() )
+	{
+		return false;
+	}
+
+	return ( (t_firstStep == m_firstStep) &&
+			 (t_secondStep == m_secondStep) &&
+			 (t_maxPixelsPerCell == m_maxPixelsPerCell) &&
+			 (t_key == m_key) );
+}
+
+// Get key of data, for which table is formed
+// @input:
+// @output:
+// - QByteArray - key of data (empty if table is empty)
+QByteArray ImgLookUpTable::GetKey() const
+{
+	return m_key;
+}
+
+// Get step of values of first feature
+// @input:
+// @output:
+// - double - step of values (0 if table is empty)
+double ImgLookUpTable::GetFirstStep() const
+{
+	return m_firstStep;
+}
+
+// Get step of values of second feature
+// @input:
+// @output:
+// - double - step of values (0 if table is empty)
+double ImgLookUpTable::GetSecondStep() const
+{
+	return m_secondStep;
+}
+
+// Get max number of pixels in cell
+// @input:
+// @output:
+// - unsigned int - max number of pixels (0 - no limit)
+unsigned int ImgLookUpTable::GetMaxPixelsPerCell() const
+{
+	return m_maxPixelsPerCell;
+}
+
+// Get offsets of cells in array of indexes of pixels
+// @input:
+// @output:
+// - QVector<unsigned int> - offsets of cells (number of cells + 1 values, empty if table is empty)
+const QVector<unsigned int> &ImgLookUpTable::GetCellOffsets() const
+{
+	return m_cellOffsets;
+}
+
+// Get indexes of pixels of all cells
+// @input:
+// @output:
+// - QVector<unsigned int> - indexes (y * width + x) of pixels, cell after cell
+const QVector<unsigned int> &ImgLookUpTable::GetPixels() const
+{
+	return m_pixels;
+}
+
+// Get number of steps of first feature
+// @input:
+// @output:
+// - unsigned int - number of steps (0 if table is empty)
+unsigned int ImgLookUpTable::GetFirstStepsNum() const
+{
+	return m_firstStepsNum;
+}
+
+// Get number of steps of second feature
+// @input:
+// @output:
+// - unsigned int - number of steps (0 if table is empty)
+unsigned int ImgLookUpTable::GetSecondStepsNum() const
+{
+	return m_secondStepsNum;
+}
+
+// Get indexes of pixels of cell
+// @input:
+// - unsigned int - step of first feature
+// - unsigned int - step of second feature
+// - unsigned int - variable for number of pixels in cell
+// @output:
+// - NULL - cell is empty or out of table
+// - pointer to first of indexes (y * width + x) of pixels of cell
+const unsigned int * ImgLookUpTable::GetCellPixels(const unsigned int &t_firstStep,
+												   const unsigned int &t_secondStep,
+												   unsigned int &t_pixelsNum) const
+{
+	t_pixelsNum = 0;
+	if ( (m_firstStepsNum <= t_firstStep) || (m_secondStepsNum <= t_secondStep) )
+	{
+		return NULL;
+	}
+
+	const unsigned int cell = t_firstStep * m_secondStepsNum + t_secondStep;
+	const unsigned int *cellOffsets = m_cellOffsets.constData();
+	t_pixelsNum = cellOffsets[cell + 1] - cellOffsets[cell];
+	if ( 0 == t_pixelsNum )
+	{
+		return NULL;
+	}
+
+	return m_pixels.constData() + cellOffsets[cell];
+}
+
+// Get step of value
+// @input:
+// - PlaneValue - value of feature
+// - double - positive step of values of feature
+// - unsigned int - variable for step of value
+// @output:
+// - true - step found
+// - false - value is negative (unknown)
+bool ImgLookUpTable::GetValueStep(const PlaneValue &t_value, const double &t_step, unsigned int &t_stepNum) const
+{
+	if ( t_value < 0 )
+	{
+		return false;
+	}
+
+	t_stepNum = (unsigned int)floor( t_value / t_step );
+	return true;
+}
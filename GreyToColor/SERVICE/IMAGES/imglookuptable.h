@@ -0,0 +1,117 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMGLOOKUPTABLE_H
+#define IMGLOOKUPTABLE_H
+
+#include <QVector>
+#include <QByteArray>
+#include <QDebug>
+#include <math.h>
+#include <limits.h>
+#include <string.h>
+#include "./IMAGES/COMMON/PIXELS/planevalue.h"
+
+// Class ImgLookUpTable
+// Look up table of pixels of image by two features (for example, relative luminance and SKO). Values of each
+// feature are quantised by its step, and each pair of steps is a cell of table, which keeps indexes of pixels
+// (y * width + x) with such features.
+// Table is stored in compressed sparse row layout: one array of indexes of pixels of all cells (cell after cell)
+// and one array of offsets of cells in it. So pixels of cell (first, second) are
+// m_pixels[m_cellOffsets[cell]] .. m_pixels[m_cellOffsets[cell + 1] - 1], where
+// cell = first * m_secondStepsNum + second. Table is formed by counting sort in two passes over image, and
+// number of cells is defined by max values of features in image. Both arrays are plain, so table could be
+// stored as is (for example, in file of Source model) and restored without forming.
+class ImgLookUpTable
+{
+	// == DATA ==
+private:
+	unsigned int m_firstStepsNum;
+	unsigned int m_secondStepsNum;
+	// Parameters, with which table is formed
+	double m_firstStep;
+	double m_secondStep;
+	unsigned int m_maxPixelsPerCell;
+	// Key of data, for which table is formed
+	QByteArray m_key;
+	// Offset of each cell in m_pixels (and size of m_pixels as last element)
+	QVector<unsigned int> m_cellOffsets;
+	// Indexes of pixels of all cells
+	QVector<unsigned int> m_pixels;
+
+	// == METHODS ==
+public:
+	ImgLookUpTable();
+	~ImgLookUpTable();
+
+	// Clear table
+	void Clear();
+	// Check if table is empty
+	bool IsEmpty() const;
+	// Form table for features of pixels of image
+	bool Form(const PlaneValue *t_firstPlane,
+			  const PlaneValue *t_secondPlane,
+			  const unsigned int &t_width,
+			  const unsigned int &t_height,
+			  const double &t_firstStep,
+			  const double &t_secondStep,
+			  const unsigned int &t_maxPixelsPerCell,
+			  const QByteArray &t_key);
+	// Restore table from arrays of formed table
+	bool Restore(const unsigned int &t_firstStepsNum,
+				 const unsigned int &t_secondStepsNum,
+				 const double &t_firstStep,
+				 const double &t_secondStep,
+				 const unsigned int &t_maxPixelsPerCell,
+				 const unsigned int *t_cellOffsets,
+				 const unsigned int *t_pixels,
+				 const unsigned int &t_pixelsNum,
+				 const unsigned int &t_imgPixelsNum,
+				 const QByteArray &t_key);
+	// Check if table is formed with such parameters for such data
+	bool IsFormedFor(const double &t_firstStep,
+					 const double &t_secondStep,
+					 const unsigned int &t_maxPixelsPerCell,
+					 const QByteArray &t_key) const;
+	// Get key of data, for which table is formed
+	QByteArray GetKey() const;
+	// Get step of values of first feature
+	double GetFirstStep() const;
+	// Get step of values of second feature
+	double GetSecondStep() const;
+	// Get max number of pixels in cell
+	unsigned int GetMaxPixelsPerCell() const;
+	// Get offsets of cells in array of indexes of pixels
+	const QVector<unsigned int> &GetCellOffsets() const;
+	// Get indexes of pixels of all cells
+	const QVector<unsigned int> &GetPixels() const;
+	// Get number of steps of first feature
+	unsigned int GetFirstStepsNum() const;
+	// Get number of steps of second feature
+	unsigned int GetSecondStepsNum() const;
+	// Get indexes of pixels of cell
+	const unsigned int * GetCellPixels(const unsigned int &t_firstStep,
+									   const unsigned int &t_secondStep,
+									   unsigned int &t_pixelsNum) const;
+
+private:
+	// Get step of value
+	bool GetValueStep(const PlaneValue &t_value, const double &t_step, unsigned int &t_stepNum) const;
+};
+
+#endif // IMGLOOKUPTABLE_H
@@ -0,0 +1,206 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "imglumsortedindex.h"
+
+ImgLumSortedIndex::ImgLumSortedIndex()
+{
+	Clear();
+}
+
+ImgLumSortedIndex::~ImgLumSortedIndex()
+{
+	Clear();
+}
+
+// Clear index
+// @input:
+// @output:
+void ImgLumSortedIndex::Clear()
+{
+	m_points.clear();
+	m_key.clear();
+}
+
+// Check if index is empty
+// @input:
+// @output:
+// - true - index has no points
+// - false - index has points
+bool ImgLumSortedIndex::IsEmpty() const
+{
+	return m_points.isEmpty();
+}
+
+// Get key of data, for which index is built
+// @input:
+// @output:
+// - QByteArray - key of data (empty if index is empty)
+QByteArray ImgLumSortedIndex::GetKey() const
+{
+	return m_key;
+}
+
+// Build index for features of pixels of image
+// @input:
+// - PlaneValue - unnull plane of relative luminance of pixels
+// - PlaneValue - unnull plane of SKO of pixels
+// - unsigned int - positive number of pixels
+// - QByteArray - key of data (to check later, if index is built for the same data)
+// @output:
+// - true - index built
+// - false - can't build index
+bool ImgLumSortedIndex::Build(const PlaneValue *t_lumPlane,
+							  const PlaneValue *t_skoPlane,
+							  const unsigned int &t_pixelsNum,
+							  const QByteArray &t_key)
+{
+	Clear();
+
+	if ( (NULL == t_lumPlane) ||
+		 (NULL == t_skoPlane) ||
+		 (0 == t_pixelsNum) ||
+		 ((unsigned int)INT_MAX <= t_pixelsNum) )
+	{
+		qDebug() << "Build(): Error - invalid arguments";
+		return false;
+	}
+
+	// Pixels with negative (unknown) features are not added to index
+	m_points.reserve(t_pixelsNum);
+	for ( unsigned int pix = 0; pix < t_pixelsNum; pix++ )
+	{
+		if ( (t_lumPlane[pix] < 0) || (t_skoPlane[pix] < 0) )
+		{
+			continue;
+		}
+
+		IndexPoint point;
+		point.lum = t_lumPlane[pix];
+		point.sko = t_skoPlane[pix];
+		point.pixel = pix;
+		m_points.append(point);
+	}
+
+	if ( true == m_points.isEmpty() )
+	{
+		qDebug() << "Build(): Error - image has no pixels with known features";
+		return false;
+	}
+
+	qSort(m_points.begin(), m_points.end(), IsPointLess);
+	m_key = t_key;
+
+	return true;
+}
+
+// Find pixel with most similar features in window of pixels with nearest luminance. Pixel is chosen with the same
+// rule, as in colorization methods: pixel is better, if its difference of luminance is smaller and difference
+// of SKO is not bigger more than by SKO_TRESHOLD, or vice versa with LUM_TRESHOLD.
+// @input:
+// - double - relative luminance
+// - double - SKO
+// - unsigned int - positive number of checked pixels
+// - unsigned int - variable for found pixel
+// @output:
+// - true - pixel found
+// - false - index is empty
+bool ImgLumSortedIndex::FindSimilar(const double &t_lum,
+									const double &t_sko,
+									const unsigned int &t_windowWidth,
+									unsigned int &t_pixel) const
+{
+	if ( (true == m_points.isEmpty()) || (0 == t_windowWidth) )
+	{
+		return false;
+	}
+
+	// Window is centered at position of luminance and shifted inside of index near its borders
+	const int pointsNum = m_points.size();
+	const int windowWidth = (int)qMin(t_windowWidth, (unsigned int)pointsNum);
+	int first = FindLumPosition(t_lum) - windowWidth / 2;
+	first = qMax( 0, qMin(first, pointsNum - windowWidth) );
+	const int last = first + windowWidth;
+
+	double bestDiffLum = DEFAULT_LUM;
+	double bestDiffSKO = DEFAULT_SKO;
+	const IndexPoint *points = m_points.constData();
+	for ( int point = first; point < last; point++ )
+	{
+		const double diffLum = fabs( t_lum - points[point].lum );
+		const double diffSKO = fabs( t_sko - points[point].sko );
+
+		if ( ( (diffLum < bestDiffLum) && (diffSKO < (bestDiffSKO + SKO_TRESHOLD)) ) ||
+			 ( (diffLum < (bestDiffLum + LUM_TRESHOLD)) && (diffSKO < bestDiffSKO) ) )
+		{
+			bestDiffLum = diffLum;
+			bestDiffSKO = diffSKO;
+			t_pixel = points[point].pixel;
+		}
+	}
+
+	return true;
+}
+
+// Find first point with luminance not smaller than value
+// @input:
+// - double - relative luminance
+// @output:
+// - int - position of point (number of points, if all points have smaller luminance)
+int ImgLumSortedIndex::FindLumPosition(const double &t_lum) const
+{
+	const IndexPoint *points = m_points.constData();
+	int first = 0;
+	int last = m_points.size();
+	while ( first < last )
+	{
+		const int middle = first + (last - first) / 2;
+		if ( points[middle].lum < t_lum )
+		{
+			first = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+
+	return first;
+}
+
+// Compare points for sorting
+// @input:
+// - IndexPoint - first point
+// - IndexPoint - second point
+// @output:
+// - true - first point should be before second one
+// - false - first point should be after second one
+bool ImgLumSortedIndex::IsPointLess(const IndexPoint &t_first, const IndexPoint &t_second)
+{
+	if ( t_first.lum != t_second.lum )
+	{
+		return ( t_first.lum < t_second.lum );
+	}
+
+	if ( t_first.sko != t_second.sko )
+	{
+		return ( t_first.sko < t_second.sko );
+	}
+
+	return ( t_first.pixel < t_second.pixel );
+}
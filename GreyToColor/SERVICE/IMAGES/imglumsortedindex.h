@@ -0,0 +1,74 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMGLUMSORTEDINDEX_H
+#define IMGLUMSORTEDINDEX_H
+
+#include <QVector>
+#include <QByteArray>
+#include <QtAlgorithms>
+#include <QDebug>
+#include <math.h>
+#include "./DEFINES/colorization.h"
+#include "./IMAGES/COMMON/PIXELS/planevalue.h"
+#include "./SERVICE/IMAGES/imgfeaturesindex.h"
+
+// Class ImgLumSortedIndex
+// Index of pixels of image, sorted by relative luminance (pixels with the same luminance are sorted by SKO and
+// by position in image, so result of search doesn't depend on sorting). Luminance of pixel is the main
+// criterion of similarity, so search of similar pixel finds position of searched luminance by binary search and
+// checks window of pixels around it. Pixels of window lie in memory one by one, and result of search is always
+// the same for the same features.
+class ImgLumSortedIndex
+{
+	// == DATA ==
+private:
+	QVector<IndexPoint> m_points;
+	// Key of data, for which index is built
+	QByteArray m_key;
+
+	// == METHODS ==
+public:
+	ImgLumSortedIndex();
+	~ImgLumSortedIndex();
+
+	// Clear index
+	void Clear();
+	// Check if index is empty
+	bool IsEmpty() const;
+	// Get key of data, for which index is built
+	QByteArray GetKey() const;
+	// Build index for features of pixels of image
+	bool Build(const PlaneValue *t_lumPlane,
+			   const PlaneValue *t_skoPlane,
+			   const unsigned int &t_pixelsNum,
+			   const QByteArray &t_key);
+	// Find pixel with most similar features in window of pixels with nearest luminance
+	bool FindSimilar(const double &t_lum,
+					 const double &t_sko,
+					 const unsigned int &t_windowWidth,
+					 unsigned int &t_pixel) const;
+
+private:
+	// Find first point with luminance not smaller than value
+	int FindLumPosition(const double &t_lum) const;
+	// Compare points for sorting
+	static bool IsPointLess(const IndexPoint &t_first, const IndexPoint &t_second);
+};
+
+#endif // IMGLUMSORTEDINDEX_H
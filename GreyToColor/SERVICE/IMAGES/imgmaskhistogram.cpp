@@ -0,0 +1,294 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "imgmaskhistogram.h"
+
+ImgMaskHistogram::ImgMaskHistogram()
+{
+	m_width = 0;
+	m_height = 0;
+	m_maskSide = 0;
+	m_maskOffset = 0;
+	m_col = ERROR;
+	m_row = ERROR;
+	m_rowStart = 0;
+	m_rowEnd = 0;
+	m_colStart = 0;
+	m_colEnd = 0;
+	m_pixelsNum = 0;
+	m_filledBinsNum = 0;
+	m_countLogsSum = 0.0;
+
+	for ( int power = 0; power < MASK_SUMS_MAX_POWER; power++ )
+	{
+		m_binPowerSums[power] = 0;
+	}
+}
+
+// Set plane of relative luminance and mask size
+// @input:
+// - PlaneValue * - unnull plane with relative luminance of pixels (row by row)
+// - unsigned int - positive width of plane
+// - unsigned int - positive height of plane
+// - unsigned int - positive odd length of side of mask
+// @output:
+// - true - histogram could be used
+// - false - invalid arguments
+bool ImgMaskHistogram::Init(const PlaneValue *t_relLumPlane,
+							const unsigned int &t_width,
+							const unsigned int &t_height,
+							const unsigned int &t_maskRectSide)
+{
+	if ( (NULL == t_relLumPlane) ||
+		 (0 == t_width) ||
+		 (0 == t_height) ||
+		 (0 == t_maskRectSide % 2) )
+	{
+		qDebug() << "Init(): Error - invalid arguments";
+		return false;
+	}
+
+	m_width = t_width;
+	m_height = t_height;
+	m_maskSide = t_maskRectSide;
+	m_maskOffset = t_maskRectSide / 2;
+	m_col = ERROR;
+	m_row = ERROR;
+
+	// The same bins as in ImgHistogram::MaskRelLumHistogram()
+	const int binsNum = (int)( RELATIVE_MAX / RELATIVE_DIVIDER );
+	const unsigned int pixelsNum = m_width * m_height;
+	m_pixelBins.resize((int)pixelsNum);
+	for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
+	{
+		int bin = (int)floor( t_relLumPlane[pix] / RELATIVE_DIVIDER );
+		if ( bin < 0 )
+		{
+			bin = 0;
+		}
+		else if ( binsNum <= bin )
+		{
+			bin = binsNum - 1;
+		}
+
+		m_pixelBins[pix] = (unsigned short)bin;
+	}
+
+	m_hist.fill(0, binsNum);
+
+	const int maxCount = (int)(t_maskRectSide * t_maskRectSide);
+	m_countLogs.resize(maxCount + 1);
+	m_countLogs[0] = 0.0;
+	for ( int count = 1; count <= maxCount; count++ )
+	{
+		m_countLogs[count] = count * log2((double)count);
+	}
+
+	return true;
+}
+
+// Move mask center to certain pixel. Moving to the next pixel in the same row is fast.
+// @input:
+// - unsigned int - exist width (x) position of pixel
+// - unsigned int - exist height (y) position of pixel
+// @output:
+// - true - mask moved
+// - false - invalid arguments or object was not initialised
+bool ImgMaskHistogram::MoveToPixel(const unsigned int &t_width, const unsigned int &t_height)
+{
+	if ( (m_width <= t_width) || (m_height <= t_height) || (true == m_pixelBins.isEmpty()) )
+	{
+		qDebug() << "MoveToPixel(): Error - invalid arguments";
+		return false;
+	}
+
+	if ( ((int)t_height == m_row) && ((int)t_width == m_col) )
+	{
+		// Mask is already here
+		return true;
+	}
+
+	if ( ((int)t_height != m_row) || ((int)t_width != m_col + 1) )
+	{
+		FillMask(t_width, t_height);
+		return true;
+	}
+
+	// Mask moved one pixel right: remove left column (if it's not clipped) and add new right column
+	const unsigned int newColStart = (m_maskOffset < t_width) ? (t_width - m_maskOffset) : 0;
+	const unsigned int newColEnd = qMin(m_width, t_width + m_maskOffset + 1);
+	if ( (m_colStart < newColStart) && (m_colEnd < newColEnd) && (m_rowEnd - m_rowStart == m_maskSide) )
+	{
+		const unsigned int firstRowIndex = m_rowStart * m_width;
+		ShiftColumns(firstRowIndex + m_colStart, firstRowIndex + m_colEnd);
+	}
+	else
+	{
+		for ( unsigned int row = m_rowStart; row < m_rowEnd; row++ )
+		{
+			const unsigned int rowIndex = row * m_width;
+			if ( m_colStart < newColStart )
+			{
+				RemovePixel(rowIndex + m_colStart);
+			}
+
+			if ( m_colEnd < newColEnd )
+			{
+				AddPixel(rowIndex + m_colEnd);
+			}
+		}
+	}
+
+	m_colStart = newColStart;
+	m_colEnd = newColEnd;
+	m_col = (int)t_width;
+
+	return true;
+}
+
+// Fill histogram with pixels of mask with center in certain pixel
+// @input:
+// - unsigned int - exist width (x) position of pixel
+// - unsigned int - exist height (y) position of pixel
+// @output:
+void ImgMaskHistogram::FillMask(const unsigned int &t_width, const unsigned int &t_height)
+{
+	m_hist.fill(0);
+	m_pixelsNum = 0;
+	m_filledBinsNum = 0;
+	m_countLogsSum = 0.0;
+
+	for ( int power = 0; power < MASK_SUMS_MAX_POWER; power++ )
+	{
+		m_binPowerSums[power] = 0;
+	}
+
+	m_colStart = (m_maskOffset < t_width) ? (t_width - m_maskOffset) : 0;
+	m_colEnd = qMin(m_width, t_width + m_maskOffset + 1);
+	m_rowStart = (m_maskOffset < t_height) ? (t_height - m_maskOffset) : 0;
+	m_rowEnd = qMin(m_height, t_height + m_maskOffset + 1);
+
+	for ( unsigned int row = m_rowStart; row < m_rowEnd; row++ )
+	{
+		for ( unsigned int col = m_colStart; col < m_colEnd; col++ )
+		{
+			AddPixel(row * m_width + col);
+		}
+	}
+
+	m_col = (int)t_width;
+	m_row = (int)t_height;
+}
+
+// Remove column of unclipped mask and add next column
+// @input:
+// - unsigned int - index of pixel in the first row of column to remove
+// - unsigned int - index of pixel in the first row of column to add
+// @output:
+void ImgMaskHistogram::ShiftColumns(const unsigned int &t_removeIndex, const unsigned int &t_addIndex)
+{
+	for ( unsigned int row = 0; row < m_maskSide; row++ )
+	{
+		const unsigned int rowOffset = row * m_width;
+		RemovePixel(t_removeIndex + rowOffset);
+		AddPixel(t_addIndex + rowOffset);
+	}
+}
+
+// Get entropy of luminance in mask
+// @input:
+// @output:
+// - double - entropy of mask histogram (in bits)
+double ImgMaskHistogram::GetEntropy() const
+{
+	// All pixels in one bin: entropy is exactly zero, don't let rounding error make it negative
+	if ( m_filledBinsNum <= 1 )
+	{
+		return RELATIVE_MIN;
+	}
+
+	return log2((double)m_pixelsNum) - m_countLogsSum / m_pixelsNum;
+}
+
+// Get number of bins with pixels in mask
+// @input:
+// @output:
+// - unsigned int - number of unempty bins
+unsigned int ImgMaskHistogram::GetFilledBinsNum() const
+{
+	return m_filledBinsNum;
+}
+
+// Get number of pixels in mask
+// @input:
+// @output:
+// - unsigned int - number of pixels in mask (including center)
+unsigned int ImgMaskHistogram::GetPixelsNum() const
+{
+	return m_pixelsNum;
+}
+
+// Get Skewness and Kurtosis of luminance in mask
+// Central moments of bins are got from power sums S1..S4 of n pixels:
+// n^2 * M2 = n * S2 - S1^2
+// n^3 * M3 = n^2 * S3 - 3 * n * S1 * S2 + 2 * S1^3
+// n^4 * M4 = n^3 * S4 - 4 * n^2 * S1 * S3 + 6 * n * S1^2 * S2 - 3 * S1^4
+// Expressions are calculated in 64-bit unsigned integers. Intermediate values may overflow, but arithmetic is
+// modulo 2^64 and results fit into 64 bits while n <= MASK_MOMENTS_MAX_PIXELS, so results are exact.
+// Skewness = M3 / M2^(3/2), Kurtosis = M4 / M2^2. They don't depend on width of bin.
+// @input:
+// - double - skewness of mask
+// - double - kurtosis of mask
+// @output:
+// - true - skewness and kurtosis calculated
+// - false - all pixels of mask are in one bin (skewness and kurtosis are set to NAN) or mask is too big
+bool ImgMaskHistogram::GetSkewAndKurt(double &t_skewness, double &t_kurtosis) const
+{
+	t_skewness = NAN;
+	t_kurtosis = NAN;
+
+	if ( MASK_MOMENTS_MAX_PIXELS < m_pixelsNum )
+	{
+		qDebug() << "GetSkewAndKurt(): Error - mask is too big";
+		return false;
+	}
+
+	if ( m_filledBinsNum <= 1 )
+	{
+		return false;
+	}
+
+	const quint64 num = m_pixelsNum;
+	const quint64 sum1 = m_binPowerSums[0];
+	const quint64 sum2 = m_binPowerSums[1];
+	const quint64 sum3 = m_binPowerSums[2];
+	const quint64 sum4 = m_binPowerSums[3];
+
+	const quint64 moment2 = num * sum2 - sum1 * sum1;
+	const qint64 moment3 = (qint64)( num * num * sum3 - 3 * num * sum1 * sum2 + 2 * sum1 * sum1 * sum1 );
+	const quint64 moment4 = num * num * num * sum4 -
+							4 * num * num * sum1 * sum3 +
+							6 * num * sum1 * sum1 * sum2 -
+							3 * sum1 * sum1 * sum1 * sum1;
+
+	const double variance = (double)moment2;
+	t_skewness = (double)moment3 / ( variance * FastMath::SquareRoot(variance) );
+	t_kurtosis = (double)moment4 / ( variance * variance );
+
+	return true;
+}
@@ -0,0 +1,148 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMGMASKHISTOGRAM_H
+#define IMGMASKHISTOGRAM_H
+
+#include <QVector>
+#include <QtGlobal>
+#include <QDebug>
+#include <math.h>
+#include "./DEFINES/global.h"
+#include "./DEFINES/pixels.h"
+#include "./IMAGES/COMMON/PIXELS/planevalue.h"
+#include "./SERVICE/fastmath.h"
+
+// Class ImgMaskHistogram
+// Histogram of relative luminance (the same bins as ImgHistogram::MaskRelLumHistogram()) in square mask, which
+// slides along rows of image. When mask moves one pixel right, one column of pixels is removed from histogram
+// and one is added, so each step costs O(mask side) instead of O(mask side ^ 2 + number of bins).
+// Functions, which add and remove pixels, are inline, so shift of mask has no calls.
+// Together with histogram it keeps sum of h * log2(h) for all bins and number of unempty bins, so entropy of
+// mask is known at any moment without scanning bins:
+// entropy = -sum( (h / n) * log2(h / n) ) = log2(n) - sum( h * log2(h) ) / n
+// Also it keeps sums of 1..4 powers of bin numbers of mask pixels. They are integer, so central moments of mask
+// (with the same quantisation as histogram) are calculated from them exactly.
+class ImgMaskHistogram
+{
+	// == DATA ==
+private:
+	unsigned int m_width;
+	unsigned int m_height;
+	unsigned int m_maskSide;
+	unsigned int m_maskOffset;
+	// Bin of each pixel of image
+	QVector<unsigned short> m_pixelBins;
+	// Number of pixels in each bin of mask histogram
+	QVector<unsigned short> m_hist;
+	// Values of h * log2(h) for all possible numbers of pixels in bin
+	QVector<double> m_countLogs;
+	// Position of mask center
+	int m_col;
+	int m_row;
+	unsigned int m_rowStart;
+	unsigned int m_rowEnd;
+	unsigned int m_colStart;
+	unsigned int m_colEnd;
+	unsigned int m_pixelsNum;
+	unsigned int m_filledBinsNum;
+	double m_countLogsSum;
+	// Sums of 1..4 powers of bin numbers of pixels in mask
+	quint64 m_binPowerSums[MASK_SUMS_MAX_POWER];
+
+	// == METHODS ==
+public:
+	ImgMaskHistogram();
+
+	// Set plane of relative luminance and mask size
+	bool Init(const PlaneValue *t_relLumPlane,
+			  const unsigned int &t_width,
+			  const unsigned int &t_height,
+			  const unsigned int &t_maskRectSide);
+
+	// Move mask center to certain pixel
+	bool MoveToPixel(const unsigned int &t_width, const unsigned int &t_height);
+	// Get entropy of luminance in mask
+	double GetEntropy() const;
+	// Get number of bins with pixels in mask
+	unsigned int GetFilledBinsNum() const;
+	// Get number of pixels in mask
+	unsigned int GetPixelsNum() const;
+	// Get Skewness and Kurtosis of luminance in mask
+	bool GetSkewAndKurt(double &t_skewness, double &t_kurtosis) const;
+
+private:
+	// Fill histogram with pixels of mask with center in certain pixel
+	void FillMask(const unsigned int &t_width, const unsigned int &t_height);
+	// Remove column of unclipped mask and add next column
+	void ShiftColumns(const unsigned int &t_removeIndex, const unsigned int &t_addIndex);
+	// Add pixel to histogram
+	void AddPixel(const unsigned int &t_index);
+	// Remove pixel from histogram
+	void RemovePixel(const unsigned int &t_index);
+};
+
+// Add pixel to histogram
+// @input:
+// - unsigned int - exist index of pixel
+// @output:
+inline void ImgMaskHistogram::AddPixel(const unsigned int &t_index)
+{
+	const unsigned short bin = m_pixelBins[t_index];
+	unsigned short &count = m_hist[bin];
+	if ( 0 == count )
+	{
+		++m_filledBinsNum;
+	}
+
+	m_countLogsSum += m_countLogs[count + 1] - m_countLogs[count];
+	++count;
+	++m_pixelsNum;
+
+	const quint64 squareBin = (quint64)bin * bin;
+	m_binPowerSums[0] += bin;
+	m_binPowerSums[1] += squareBin;
+	m_binPowerSums[2] += squareBin * bin;
+	m_binPowerSums[3] += squareBin * squareBin;
+}
+
+// Remove pixel from histogram
+// @input:
+// - unsigned int - exist index of pixel in mask
+// @output:
+inline void ImgMaskHistogram::RemovePixel(const unsigned int &t_index)
+{
+	const unsigned short bin = m_pixelBins[t_index];
+	unsigned short &count = m_hist[bin];
+	m_countLogsSum += m_countLogs[count - 1] - m_countLogs[count];
+	--count;
+	--m_pixelsNum;
+
+	const quint64 squareBin = (quint64)bin * bin;
+	m_binPowerSums[0] -= bin;
+	m_binPowerSums[1] -= squareBin;
+	m_binPowerSums[2] -= squareBin * bin;
+	m_binPowerSums[3] -= squareBin * squareBin;
+
+	if ( 0 == count )
+	{
+		--m_filledBinsNum;
+	}
+}
+
+#endif // IMGMASKHISTOGRAM_H
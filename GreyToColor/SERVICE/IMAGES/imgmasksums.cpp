@@ -0,0 +1,210 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "imgmasksums.h"
+
+ImgMaskSums::ImgMaskSums()
+{
+	m_plane = NULL;
+	m_width = 0;
+	m_height = 0;
+	m_maskOffset = 0;
+	m_maxPower = 0;
+	m_currentRow = ERROR;
+	m_rowStart = 0;
+	m_rowEnd = 0;
+}
+
+// Set plane and mask size
+// @input:
+// - PlaneValue * - unnull plane with values of pixels (row by row)
+// - unsigned int - positive width of plane
+// - unsigned int - positive height of plane
+// - unsigned int - positive odd length of side of mask
+// - int - max power of values, which sums are needed (in range [1, MASK_SUMS_MAX_POWER])
+// @output:
+// - true - sums could be calculated
+// - false - invalid arguments
+bool ImgMaskSums::Init(const PlaneValue *t_plane,
+					   const unsigned int &t_width,
+					   const unsigned int &t_height,
+					   const unsigned int &t_maskRectSide,
+					   const int &t_maxPower)
+{
+	if ( (NULL == t_plane) ||
+		 (0 == t_width) ||
+		 (0 == t_height) ||
+		 (0 == t_maskRectSide % 2) ||
+		 (t_maxPower < 1) ||
+		 (MASK_SUMS_MAX_POWER < t_maxPower) )
+	{
+		qDebug() << "Init(): Error - invalid arguments";
+		return false;
+	}
+
+	m_plane = t_plane;
+	m_width = t_width;
+	m_height = t_height;
+	m_maskOffset = t_maskRectSide / 2;
+	m_maxPower = t_maxPower;
+	m_currentRow = ERROR;
+
+	for ( int power = 0; power < m_maxPower; power++ )
+	{
+		m_columnSums[power].fill(0.0, (int)m_width);
+		m_rowPrefixSums[power].fill(0.0, (int)m_width + 1);
+	}
+
+	return true;
+}
+
+// Calc sums of masks for all pixels of certain row. It's fast to go through rows one by one: then only two
+// rows of plane are read for each row of sums.
+// @input:
+// - unsigned int - exist row of plane
+// @output:
+// - true - sums calculated
+// - false - invalid arguments or object was not initialised
+bool ImgMaskSums::CalcRowSums(const unsigned int &t_row)
+{
+	if ( (NULL == m_plane) || (m_height <= t_row) )
+	{
+		qDebug() << "CalcRowSums(): Error - invalid arguments";
+		return false;
+	}
+
+	const unsigned int newStart = (m_maskOffset < t_row) ? (t_row - m_maskOffset) : 0;
+	const unsigned int newEnd = qMin(m_height, t_row + m_maskOffset + 1);
+
+	if ( (ERROR != m_currentRow) && ((unsigned int)m_currentRow + 1 == t_row) )
+	{
+		// Mask moved one row down
+		if ( m_rowStart < newStart )
+		{
+			AddRowToColumns(m_rowStart, -1.0);
+		}
+
+		if ( m_rowEnd < newEnd )
+		{
+			AddRowToColumns(m_rowEnd, 1.0);
+		}
+	}
+	else
+	{
+		for ( int power = 0; power < m_maxPower; power++ )
+		{
+			m_columnSums[power].fill(0.0);
+		}
+
+		for ( unsigned int row = newStart; row < newEnd; row++ )
+		{
+			AddRowToColumns(row, 1.0);
+		}
+	}
+
+	m_currentRow = (int)t_row;
+	m_rowStart = newStart;
+	m_rowEnd = newEnd;
+
+	for ( int power = 0; power < m_maxPower; power++ )
+	{
+		const double *columns = m_columnSums[power].constData();
+		double *prefix = m_rowPrefixSums[power].data();
+		prefix[0] = 0.0;
+		for ( unsigned int col = 0; col < m_width; col++ )
+		{
+			prefix[col + 1] = prefix[col] + columns[col];
+		}
+	}
+
+	return true;
+}
+
+// Add (or subtract) values of certain row to column sums
+// @input:
+// - unsigned int - exist row of plane
+// - double - 1.0 to add row, -1.0 to subtract row
+// @output:
+void ImgMaskSums::AddRowToColumns(const unsigned int &t_row, const double &t_sign)
+{
+	const PlaneValue *rowValues = m_plane + t_row * m_width;
+	for ( unsigned int col = 0; col < m_width; col++ )
+	{
+		const double value = rowValues[col];
+		double valueInPower = t_sign;
+		for ( int power = 0; power < m_maxPower; power++ )
+		{
+			valueInPower *= value;
+			m_columnSums[power][col] += valueInPower;
+		}
+	}
+}
+
+// Get first column of mask of pixel
+// @input:
+// - unsigned int - exist column of pixel
+// @output:
+// - unsigned int - first column of mask
+unsigned int ImgMaskSums::MaskStart(const unsigned int &t_width) const
+{
+	return (m_maskOffset < t_width) ? (t_width - m_maskOffset) : 0;
+}
+
+// Get column after last column of mask of pixel
+// @input:
+// - unsigned int - exist column of pixel
+// @output:
+// - unsigned int - column after last column of mask
+unsigned int ImgMaskSums::MaskEnd(const unsigned int &t_width) const
+{
+	return qMin(m_width, t_width + m_maskOffset + 1);
+}
+
+// Get sum of values in certain power in mask of pixel of current row
+// @input:
+// - unsigned int - exist column of pixel
+// - int - power of values in range [1, max power from Init()]
+// @output:
+// - double - sum of values in mask (ERROR for invalid arguments)
+double ImgMaskSums::GetMaskSum(const unsigned int &t_width, const int &t_power) const
+{
+	if ( (ERROR == m_currentRow) || (m_width <= t_width) || (t_power < 1) || (m_maxPower < t_power) )
+	{
+		qDebug() << "GetMaskSum(): Error - invalid arguments";
+		return ERROR;
+	}
+
+	const double *prefix = m_rowPrefixSums[t_power - 1].constData();
+	return prefix[ MaskEnd(t_width) ] - prefix[ MaskStart(t_width) ];
+}
+
+// Get number of pixels in mask of pixel of current row
+// @input:
+// - unsigned int - exist column of pixel
+// @output:
+// - unsigned int - number of pixels in mask (including pixel itself)
+unsigned int ImgMaskSums::GetMaskPixelsNum(const unsigned int &t_width) const
+{
+	if ( (ERROR == m_currentRow) || (m_width <= t_width) )
+	{
+		qDebug() << "GetMaskPixelsNum(): Error - invalid arguments";
+		return 0;
+	}
+
+	return (MaskEnd(t_width) - MaskStart(t_width)) * (m_rowEnd - m_rowStart);
+}
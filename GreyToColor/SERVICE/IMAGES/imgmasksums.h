@@ -0,0 +1,80 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMGMASKSUMS_H
+#define IMGMASKSUMS_H
+
+#include <QVector>
+#include <QDebug>
+#include "./DEFINES/global.h"
+#include "./DEFINES/pixels.h"
+#include "./IMAGES/COMMON/PIXELS/planevalue.h"
+
+// Class ImgMaskSums
+// Calculates sums of values of plane (and of their powers) in square masks around pixels. Masks are clipped
+// by borders of image (as masks of GetPixNeighborsRelLum()).
+// Sums of columns of mask are updated when mask moves to the next row (one row is added and one is removed),
+// and sums of masks in row are found from prefix sums of columns. So each pixel costs O(1) operations
+// independently of mask size. Sums in columns and in rows are not bigger than image side, so rounding errors
+// stay much smaller than in summed-area table of the whole image.
+class ImgMaskSums
+{
+	// == DATA ==
+private:
+	const PlaneValue *m_plane;
+	unsigned int m_width;
+	unsigned int m_height;
+	unsigned int m_maskOffset;
+	int m_maxPower;
+	// Row, for which sums were calculated (ERROR if there is no such row)
+	int m_currentRow;
+	unsigned int m_rowStart;
+	unsigned int m_rowEnd;
+	// Sums of values in powers for each column of mask of current row
+	QVector<double> m_columnSums[MASK_SUMS_MAX_POWER];
+	// Prefix sums of column sums of current row (for each power)
+	QVector<double> m_rowPrefixSums[MASK_SUMS_MAX_POWER];
+
+	// == METHODS ==
+public:
+	ImgMaskSums();
+
+	// Set plane and mask size
+	bool Init(const PlaneValue *t_plane,
+			  const unsigned int &t_width,
+			  const unsigned int &t_height,
+			  const unsigned int &t_maskRectSide,
+			  const int &t_maxPower);
+
+	// Calc sums of masks for all pixels of certain row
+	bool CalcRowSums(const unsigned int &t_row);
+	// Get sum of values in certain power in mask of pixel of current row
+	double GetMaskSum(const unsigned int &t_width, const int &t_power) const;
+	// Get number of pixels in mask of pixel of current row
+	unsigned int GetMaskPixelsNum(const unsigned int &t_width) const;
+
+private:
+	// Add (or subtract) values of certain row to column sums
+	void AddRowToColumns(const unsigned int &t_row, const double &t_sign);
+	// Get first column of mask of pixel
+	unsigned int MaskStart(const unsigned int &t_width) const;
+	// Get column after last column of mask of pixel
+	unsigned int MaskEnd(const unsigned int &t_width) const;
+};
+
+#endif // IMGMASKSUMS_H
@@ -0,0 +1,441 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "imgvptree.h"
+
+ImgVPTree::ImgVPTree()
+{
+	Clear();
+}
+
+ImgVPTree::~ImgVPTree()
+{
+	Clear();
+}
+
+// Clear index
+// @input:
+// @output:
+void ImgVPTree::Clear()
+{
+	m_points.clear();
+	m_radiuses.clear();
+	m_key.clear();
+
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		m_weights[param] = 1.0;
+	}
+}
+
+// Check if index is empty
+// @input:
+// @output:
+// - true - index has no points
+// - false - index has points
+bool ImgVPTree::IsEmpty() const
+{
+	return m_points.isEmpty();
+}
+
+// Get key of data, for which index is built
+// @input:
+// @output:
+// - QByteArray - key of data (empty if index is empty)
+QByteArray ImgVPTree::GetKey() const
+{
+	return m_key;
+}
+
+// Build index for features of pixels of image
+// @input:
+// - PlaneValue - unnull planes of features of pixels (luminance, SKO, entropy, skewness, kurtosis)
+// - unsigned int - positive number of pixels
+// - double - not negative weights of features in distance (at least one is positive)
+// - QByteArray - key of data (to check later, if index is built for the same data)
+// @output:
+// - true - index built
+// - false - can't build index
+bool ImgVPTree::Build(const PlaneValue * const t_planes[ENTROPY_PARAMS_NUM],
+					  const unsigned int &t_pixelsNum,
+					  const double t_weights[ENTROPY_PARAMS_NUM],
+					  const QByteArray &t_key)
+{
+	Clear();
+
+	if ( (NULL == t_planes) ||
+		 (NULL == t_weights) ||
+		 (0 == t_pixelsNum) ||
+		 ((unsigned int)INT_MAX <= t_pixelsNum) )
+	{
+		qDebug() << "Build(): Error - invalid arguments";
+		return false;
+	}
+
+	double weightsSum = 0.0;
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		if ( (NULL == t_planes[param]) || (t_weights[param] < 0) )
+		{
+			qDebug() << "Build(): Error - invalid arguments";
+			return false;
+		}
+
+		m_weights[param] = t_weights[param];
+		weightsSum += t_weights[param];
+	}
+
+	if ( weightsSum <= 0 )
+	{
+		qDebug() << "Build(): Error - all weights are zero";
+		return false;
+	}
+
+	// Pixels with negative (unknown) features are not added to index
+	m_points.reserve(t_pixelsNum);
+	for ( unsigned int pix = 0; pix < t_pixelsNum; pix++ )
+	{
+		VPTreePoint point;
+		bool isKnown = true;
+		for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+		{
+			point.values[param] = t_planes[param][pix];
+			isKnown = isKnown && ( 0 <= t_planes[param][pix] );
+		}
+
+		if ( false == isKnown )
+		{
+			continue;
+		}
+
+		point.pixel = pix;
+		m_points.append(point);
+	}
+
+	if ( true == m_points.isEmpty() )
+	{
+		qDebug() << "Build(): Error - image has no pixels with known features";
+		return false;
+	}
+
+	const int pointsNum = m_points.size();
+	m_radiuses.fill(0, pointsNum);
+
+	// Distances from vantage point of current node (only for building)
+	QVector<double> distances(pointsNum, 0.0);
+	BuildNode(0, pointsNum, distances);
+
+	m_key = t_key;
+	return true;
+}
+
+// Build node of tree for range of points
+// @input:
+// - int - first point of range
+// - int - point after last point of range
+// - QVector<double> - buffer for distances of points
+// @output:
+void ImgVPTree::BuildNode(const int &t_first, const int &t_last, QVector<double> &t_distances)
+{
+	if ( t_last - t_first <= INDEX_LEAF_SIZE )
+	{
+		return;
+	}
+
+	// Middle point of range is used as vantage point
+	VPTreePoint *points = m_points.data();
+	const VPTreePoint vantagePoint = points[t_first + (t_last - t_first) / 2];
+	points[t_first + (t_last - t_first) / 2] = points[t_first];
+	points[t_first] = vantagePoint;
+
+	double vantageValues[ENTROPY_PARAMS_NUM];
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		vantageValues[param] = vantagePoint.values[param];
+	}
+
+	double *distances = t_distances.data();
+	for ( int point = t_first + 1; point < t_last; point++ )
+	{
+		distances[point] = GetDistance(vantageValues, points[point]);
+	}
+
+	// Inner child [t_first + 1, median), outer child [median, t_last)
+	const int median = t_first + 1 + (t_last - t_first - 1) / 2;
+	SelectMedian(t_first + 1, t_last, median, t_distances);
+	m_radiuses[t_first] = distances[median];
+
+	BuildNode(t_first + 1, median, t_distances);
+	BuildNode(median, t_last, t_distances);
+}
+
+// Put to position of median point of range the point, which should be there if range was sorted by distance.
+// Points before it will have not bigger distances, points after it - not smaller.
+// @input:
+// - int - first point of range
+// - int - point after last point of range
+// - int - median point of range
+// - QVector<double> - distances of points
+// @output:
+void ImgVPTree::SelectMedian(int t_first, int t_last, const int &t_median, QVector<double> &t_distances)
+{
+	VPTreePoint *points = m_points.data();
+	double *distances = t_distances.data();
+	while ( t_first + 1 < t_last )
+	{
+		// Pivot is median of first, middle and last distances of range
+		const double firstValue = distances[t_first];
+		const double middleValue = distances[t_first + (t_last - t_first) / 2];
+		const double lastValue = distances[t_last - 1];
+		const double pivot = qMax( qMin(firstValue, middleValue), qMin( qMax(firstValue, middleValue), lastValue ) );
+
+		int left = t_first;
+		int right = t_last - 1;
+		while ( left <= right )
+		{
+			while ( distances[left] < pivot )
+			{
+				left++;
+			}
+
+			while ( pivot < distances[right] )
+			{
+				right--;
+			}
+
+			if ( left <= right )
+			{
+				const VPTreePoint point = points[left];
+				points[left] = points[right];
+				points[right] = point;
+
+				const double distance = distances[left];
+				distances[left] = distances[right];
+				distances[right] = distance;
+
+				left++;
+				right--;
+			}
+		}
+
+		// Now points [t_first, right] are not farther than pivot, points [left, t_last) are not nearer, and points
+		// between them have distance of pivot
+		if ( t_median <= right )
+		{
+			t_last = right + 1;
+		}
+		else if ( left <= t_median )
+		{
+			t_first = left;
+		}
+		else
+		{
+			return;
+		}
+	}
+}
+
+// Find pixel with nearest features
+// @input:
+// - double - features (luminance, SKO, entropy, skewness, kurtosis)
+// - unsigned int - variable for found pixel
+// @output:
+// - true - pixel found
+// - false - index is empty
+bool ImgVPTree::FindNearest(const double t_values[ENTROPY_PARAMS_NUM], unsigned int &t_pixel) const
+{
+	if ( (true == m_points.isEmpty()) || (NULL == t_values) )
+	{
+		return false;
+	}
+
+	int bestPoint = -1;
+	double bestDistance = DEFAULT_DIFF;
+	SearchNode(0, m_points.size(), t_values, bestPoint, bestDistance);
+	if ( bestPoint < 0 )
+	{
+		return false;
+	}
+
+	t_pixel = m_points.at(bestPoint).pixel;
+	return true;
+}
+
+// Search nearest point in node of tree. Firstly it checks vantage point and child, which contains searched
+// features, then - other child, if it could contain point nearer than found one.
+// @input:
+// - int - first point of node
+// - int - point after last point of node
+// - double - searched features
+// - int - best found point
+// - double - distance to best found point
+// @output:
+void ImgVPTree::SearchNode(const int &t_first,
+						   const int &t_last,
+						   const double t_values[ENTROPY_PARAMS_NUM],
+						   int &t_bestPoint,
+						   double &t_bestDistance) const
+{
+	const VPTreePoint *points = m_points.constData();
+	if ( t_last - t_first <= INDEX_LEAF_SIZE )
+	{
+		for ( int point = t_first; point < t_last; point++ )
+		{
+			const double distance = GetDistance(t_values, points[point]);
+			if ( distance < t_bestDistance )
+			{
+				t_bestDistance = distance;
+				t_bestPoint = point;
+			}
+		}
+
+		return;
+	}
+
+	const double distance = GetDistance(t_values, points[t_first]);
+	if ( distance < t_bestDistance )
+	{
+		t_bestDistance = distance;
+		t_bestPoint = t_first;
+	}
+
+	const double radius = m_radiuses[t_first];
+	const int median = t_first + 1 + (t_last - t_first - 1) / 2;
+	if ( distance < radius )
+	{
+		SearchNode(t_first + 1, median, t_values, t_bestPoint, t_bestDistance);
+		if ( radius <= distance + t_bestDistance )
+		{
+			SearchNode(median, t_last, t_values, t_bestPoint, t_bestDistance);
+		}
+	}
+	else
+	{
+		SearchNode(median, t_last, t_values, t_bestPoint, t_bestDistance);
+		if ( distance - t_bestDistance <= radius )
+		{
+			SearchNode(t_first + 1, median, t_values, t_bestPoint, t_bestDistance);
+		}
+	}
+}
+
+// Get distance between features and point
+// @input:
+// - double - features
+// - VPTreePoint - point
+// @output:
+// - double - weighted euclidean distance
+double ImgVPTree::GetDistance(const double t_values[ENTROPY_PARAMS_NUM], const VPTreePoint &t_point) const
+{
+	double sum = 0.0;
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		const double diff = t_values[param] - t_point.values[param];
+		sum += m_weights[param] * diff * diff;
+	}
+
+	return sqrt(sum);
+}
+
+// Compare nearest pixels found by FindNearest() with nearest pixels found by linear scan of all pixels. Features
+// of pixels are random values on coarse grid (so there are ties of distances), weights of features differ, and
+// some pixels have unknown features.
+void ImgVPTree::TestFindNearest()
+{
+	const unsigned int pixelsNum = 5000;
+	QVector<PlaneValue> planes[ENTROPY_PARAMS_NUM];
+	const PlaneValue *planesData[ENTROPY_PARAMS_NUM];
+	const double weights[ENTROPY_PARAMS_NUM] = { 1.0, 2.0, 0.5, 1.0, 0.0 };
+	srand(1);
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		planes[param].resize(pixelsNum);
+		for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
+		{
+			planes[param][pix] = (rand() % 10) * 0.1;
+			if ( 0 == rand() % 200 )
+			{
+				planes[param][pix] = -1;
+			}
+		}
+
+		planesData[param] = planes[param].constData();
+	}
+
+	bool indexBuilt = Build(planesData, pixelsNum, weights, QByteArray("test"));
+	if ( false == indexBuilt )
+	{
+		qDebug() << "Fail: Can't build index";
+		return;
+	}
+
+	const unsigned int searchesNum = 1000;
+	unsigned int wrongSearches = 0;
+	for ( unsigned int search = 0; search < searchesNum; search++ )
+	{
+		// Half of searched features are on grid of features of pixels, others - between its values
+		double values[ENTROPY_PARAMS_NUM];
+		for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+		{
+			values[param] = (rand() % 11) * 0.1;
+			if ( 1 == search % 2 )
+			{
+				values[param] += 0.05;
+			}
+		}
+
+		double scanDistance = DEFAULT_DIFF;
+		for ( unsigned int pix = 0; pix < pixelsNum; pix++ )
+		{
+			VPTreePoint point;
+			bool isKnown = true;
+			for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+			{
+				point.values[param] = planes[param][pix];
+				isKnown = isKnown && ( 0 <= planes[param][pix] );
+			}
+
+			if ( true == isKnown )
+			{
+				scanDistance = qMin(scanDistance, GetDistance(values, point));
+			}
+		}
+
+		// Pixel could differ from pixel of scan in case of ties, but its distance should be the same
+		unsigned int pixel = 0;
+		bool isCorrect = FindNearest(values, pixel);
+		if ( true == isCorrect )
+		{
+			VPTreePoint point;
+			for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+			{
+				point.values[param] = planes[param][pixel];
+				isCorrect = isCorrect && ( 0 <= planes[param][pixel] );
+			}
+
+			isCorrect = isCorrect && ( GetDistance(values, point) == scanDistance );
+		}
+
+		if ( false == isCorrect )
+		{
+			wrongSearches++;
+		}
+	}
+
+	qDebug() << "TestFindNearest(): wrong searches:" << wrongSearches << "of" << searchesNum;
+}
@@ -0,0 +1,96 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMGVPTREE_H
+#define IMGVPTREE_H
+
+#include <QVector>
+#include <QByteArray>
+#include <QDebug>
+#include <math.h>
+#include <limits.h>
+#include <stdlib.h>
+#include "./DEFINES/imgservice.h"
+#include "./DEFINES/colorization.h"
+#include "./IMAGES/COMMON/PIXELS/planevalue.h"
+
+// Point of ImgVPTree: features of pixel (luminance, SKO, entropy, skewness, kurtosis) and its index
+// (y * width + x)
+struct VPTreePoint
+{
+	PlaneValue values[ENTROPY_PARAMS_NUM];
+	unsigned int pixel;
+};
+
+// Class ImgVPTree
+// Index of pixels of image by vector of ENTROPY_PARAMS_NUM features for search of nearest pixel by weighted
+// euclidean distance: sqrt( sum( weight * (value1 - value2)^2 ) ). It's a vantage point tree, which is kept in one
+// array of points: node for range of points [first, last) has vantage point first, then points nearer to it
+// than median distance (inner child), then other points (outer child). Ranges with no more than
+// INDEX_LEAF_SIZE points are leaves. Pixels with negative (unknown) features are not added to index.
+// It uses only distance between points, so it works for any number of features (unlike k-d tree, which becomes
+// slow for more than 2-3 features). Search of nearest pixel is exact and takes O(log(N)) for usual images.
+class ImgVPTree
+{
+	// == DATA ==
+private:
+	QVector<VPTreePoint> m_points;
+	// Median distance for each node (index is vantage point of node)
+	QVector<double> m_radiuses;
+	double m_weights[ENTROPY_PARAMS_NUM];
+	// Key of data, for which index is built
+	QByteArray m_key;
+
+	// == METHODS ==
+public:
+	ImgVPTree();
+	~ImgVPTree();
+
+	// Clear index
+	void Clear();
+	// Check if index is empty
+	bool IsEmpty() const;
+	// Get key of data, for which index is built
+	QByteArray GetKey() const;
+	// Build index for features of pixels of image
+	bool Build(const PlaneValue * const t_planes[ENTROPY_PARAMS_NUM],
+			   const unsigned int &t_pixelsNum,
+			   const double t_weights[ENTROPY_PARAMS_NUM],
+			   const QByteArray &t_key);
+	// Find pixel with nearest features
+	bool FindNearest(const double t_values[ENTROPY_PARAMS_NUM], unsigned int &t_pixel) const;
+
+	// Test search of nearest pixel
+	void TestFindNearest();
+
+private:
+	// Build node of tree for range of points
+	void BuildNode(const int &t_first, const int &t_last, QVector<double> &t_distances);
+	// Put to position of median point of range the point, which should be there if range was sorted by distance
+	void SelectMedian(int t_first, int t_last, const int &t_median, QVector<double> &t_distances);
+	// Search nearest point in node of tree
+	void SearchNode(const int &t_first,
+					const int &t_last,
+					const double t_values[ENTROPY_PARAMS_NUM],
+					int &t_bestPoint,
+					double &t_bestDistance) const;
+	// Get distance between features and point
+	double GetDistance(const double t_values[ENTROPY_PARAMS_NUM], const VPTreePoint &t_point) const;
+};
+
+#endif // IMGVPTREE_H
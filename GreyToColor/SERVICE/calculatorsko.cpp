@@ -44,13 +44,13 @@ double CalculatorSKO::PixelMaskSKO(const double t_centralPixLum, const QList<dou
 	for ( int pix = 0; pix < pixNum; pix++ )
 	{
 		double diff = t_centralPixLum - t_luminances.at(pix);
-		SKO += pow(diff, 2);
+		SKO += FastMath::Power(diff, 2);
 	}
 
 	// Pixels in mask: all pixels in mask - central pixel
 	int pixInMask = pixNum;
 	SKO /= pixInMask;
-	SKO = pow(SKO, 0.5);
+	SKO = FastMath::SquareRoot(SKO);
 
 	return SKO;
 }
@@ -76,12 +76,12 @@ double CalculatorSKO::PassportsSKO(const QList<double> &t_first, const QList<dou
 	const int numOfValues = t_first.size();
 	for (int value = 0; value < numOfValues; value++)
 	{
-		double diff = pow( (t_first.at(value) - t_second.at(value)), 2 );
+		double diff = FastMath::Power( (t_first.at(value) - t_second.at(value)), 2 );
 		resultSKO += diff;
 	}
 
 	resultSKO /= (double)numOfValues;
-	resultSKO = pow(resultSKO, 0.5);
+	resultSKO = FastMath::SquareRoot(resultSKO);
 
 	return resultSKO;
 }
@@ -122,22 +122,22 @@ double CalculatorSKO::ImagesSKO(const QImage &t_firstImg, const QImage &t_second
 
 			double redFirst = (double)qRed(firstImgPix);
 			double redSecond = (double)qRed(secondImgPix);
-			double diffRed = pow( (redFirst - redSecond), 2 );
+			double diffRed = FastMath::Power( (redFirst - redSecond), 2 );
 
 			double greenFirst = (double)qGreen(firstImgPix);
 			double greenSecond = (double)qGreen(secondImgPix);
-			double diffGreen = pow( (greenFirst - greenSecond), 2 );
+			double diffGreen = FastMath::Power( (greenFirst - greenSecond), 2 );
 
 			double blueFirst = (double)qBlue(firstImgPix);
 			double blueSecond = (double)qBlue(secondImgPix);
-			double diffBlue = pow( (blueFirst - blueSecond), 2 );
+			double diffBlue = FastMath::Power( (blueFirst - blueSecond), 2 );
 
 			SKO += diffRed + diffGreen + diffBlue;
 		}
 	}
 
 	SKO = SKO / (firstWdt * firstHgt);
-	SKO = pow(SKO, 0.5);
+	SKO = FastMath::SquareRoot(SKO);
 
 	return SKO;
 }
@@ -25,6 +25,7 @@
 #include <math.h>
 #include "./DEFINES/global.h"
 #include "./DEFINES/calcsko.h"
+#include "fastmath.h"
 
 class CalculatorSKO : public QObject
 {
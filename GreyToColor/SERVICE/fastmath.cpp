@@ -0,0 +1,308 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fastmath.h"
+#include "./IMAGES/COMMON/PIXELS/COLOR_SPACE/rgblab.h"
+
+bool FastMath::s_enabled = false;
+
+// Switch on or off fast mode
+// @input:
+// - bool - true to use fast approximations, false to use standard functions
+// @output:
+void FastMath::SetEnabled(const bool &t_enabled)
+{
+	s_enabled = t_enabled;
+}
+
+// Check if fast mode is switched on
+// @input:
+// @output:
+// - true - functions use fast approximations
+// - false - functions use standard functions
+bool FastMath::IsEnabled()
+{
+	return s_enabled;
+}
+
+// Calc integer power of value
+// @input:
+// - double - value (unnull, if power is negative)
+// - int - power
+// @output:
+// - double - value in power
+double FastMath::Power(const double &t_value, const int &t_power)
+{
+	if ( true == s_enabled )
+	{
+		return FastPower(t_value, t_power);
+	}
+
+	return pow(t_value, (double)t_power);
+}
+
+// Calc square root of value
+// @input:
+// - double - positive value
+// @output:
+// - double - square root of value
+double FastMath::SquareRoot(const double &t_value)
+{
+	if ( true == s_enabled )
+	{
+		return sqrt(t_value);
+	}
+
+	return pow(t_value, 0.5);
+}
+
+// Calc log10() of value
+// @input:
+// - double - positive value
+// @output:
+// - double - log10() of value
+double FastMath::Log10(const double &t_value)
+{
+	if ( true == s_enabled )
+	{
+		return FastLog10(t_value);
+	}
+
+	return log10(t_value);
+}
+
+// Calc 10^x
+// @input:
+// - double - value in range [-300, 300]
+// @output:
+// - double - 10 in power of value
+double FastMath::Pow10(const double &t_value)
+{
+	if ( true == s_enabled )
+	{
+		return FastPow10(t_value);
+	}
+
+	return pow(10, t_value);
+}
+
+// Fast version of Power(): multiplications only
+// @input:
+// - double - value (unnull, if power is negative)
+// - int - power
+// @output:
+// - double - value in power
+double FastMath::FastPower(const double &t_value, const int &t_power)
+{
+	int power = t_power;
+	if ( power < 0 )
+	{
+		power = -power;
+	}
+
+	double result = 1.0;
+	for ( int step = 0; step < power; step++ )
+	{
+		result *= t_value;
+	}
+
+	if ( t_power < 0 )
+	{
+		result = 1.0 / result;
+	}
+
+	return result;
+}
+
+// Fast version of Log10(): value is split to mantissa and exponent, ln(mantissa) calculated with short series.
+// There are no branches and calls, so compiler could vectorize loops with this function.
+// @input:
+// - double - positive normal value
+// @output:
+// - double - log10() of value
+double FastMath::FastLog10(const double &t_value)
+{
+	quint64 bits = 0;
+	memcpy(&bits, &t_value, sizeof(bits));
+
+	// t_value = mantissa * 2^exponent, mantissa in range [sqrt(2)/2, sqrt(2))
+	int exponent = (int)((bits >> 52) & 0x7FF) - 1023;
+	bits = (bits & Q_UINT64_C(0x000FFFFFFFFFFFFF)) | Q_UINT64_C(0x3FF0000000000000);
+	double mantissa = 0.0;
+	memcpy(&mantissa, &bits, sizeof(mantissa));
+
+	const int bigMantissa = (1.41421356237309504880 < mantissa);
+	mantissa *= 1.0 - 0.5 * bigMantissa;
+	exponent += bigMantissa;
+
+	// ln(m) = 2 * (s + s^3/3 + s^5/5 + ...), s = (m - 1) / (m + 1), |s| < 0.172
+	const double s = (mantissa - 1.0) / (mantissa + 1.0);
+	const double z = s * s;
+	const double series = 1.0 + z * (1.0 / 3.0 + z * (1.0 / 5.0 + z * (1.0 / 7.0 + z * (1.0 / 9.0))));
+	const double lnValue = exponent * 0.69314718055994530942 + 2.0 * s * series;
+
+	return lnValue * 0.43429448190325182765;
+}
+
+// Fast version of Pow10(): 10^x = 2^n * e^t, where n is integer and |t| < 0.35 (e^t calculated with short series)
+// @input:
+// - double - value in range [-300, 300]
+// @output:
+// - double - 10 in power of value
+double FastMath::FastPow10(const double &t_value)
+{
+	const double power = t_value * 3.32192809488736234787;
+	const double intPower = floor(power + 0.5);
+	const double t = (power - intPower) * 0.69314718055994530942;
+
+	const double series = 1.0 + t * (1.0 + t * (1.0 / 2.0 + t * (1.0 / 6.0 + t * (1.0 / 24.0 +
+						  t * (1.0 / 120.0 + t * (1.0 / 720.0 + t * (1.0 / 5040.0 + t * (1.0 / 40320.0))))))));
+
+	return ldexp(series, (int)intPower);
+}
+
+// Test functions
+
+// Find max errors of fast mode against standard functions and exact color transforms. Results are printed to
+// debug output (run application with option "--test-fast-math")
+// @input:
+// @output:
+void FastMath::TestAccuracy()
+{
+	const bool wasEnabled = s_enabled;
+	const int steps = 1000000;
+
+	double maxPowerError = 0.0;
+	double maxRootError = 0.0;
+	double maxLogError = 0.0;
+	double maxExpError = 0.0;
+	for ( int step = 1; step <= steps; step++ )
+	{
+		// Relative values (as features of pixels)
+		const double relValue = (double)step / steps;
+		const int powers[] = { 2, 3, 4, -3, -4 };
+		for ( int power = 0; power < 5; power++ )
+		{
+			s_enabled = false;
+			const double exact = Power(relValue, powers[power]);
+			s_enabled = true;
+			const double fast = Power(relValue, powers[power]);
+			maxPowerError = qMax( maxPowerError, fabs(fast - exact) / exact );
+		}
+
+		s_enabled = false;
+		const double exactRoot = SquareRoot(relValue);
+		s_enabled = true;
+		maxRootError = qMax( maxRootError, fabs(SquareRoot(relValue) - exactRoot) / exactRoot );
+
+		// Values of LMS colors in RGB -> LAB transform: [0.01, 255]
+		const double lmsValue = 0.01 * pow(25500.0, relValue);
+		s_enabled = false;
+		const double exactLog = Log10(lmsValue);
+		s_enabled = true;
+		maxLogError = qMax( maxLogError, fabs(Log10(lmsValue) - exactLog) );
+
+		// Logarithms of LMS colors in LAB -> RGB transform
+		const double logValue = -3.0 + 6.0 * relValue;
+		s_enabled = false;
+		const double exactExp = Pow10(logValue);
+		s_enabled = true;
+		maxExpError = qMax( maxExpError, fabs(Pow10(logValue) - exactExp) / exactExp );
+	}
+
+	qDebug() << "TestAccuracy(): max relative error of Power() =" << maxPowerError;
+	qDebug() << "TestAccuracy(): max relative error of SquareRoot() =" << maxRootError;
+	qDebug() << "TestAccuracy(): max absolute error of Log10() =" << maxLogError;
+	qDebug() << "TestAccuracy(): max relative error of Pow10() =" << maxExpError;
+
+	// Color transforms: all RGB colors and back. Each type of conversion in fast mode is compared with
+	// exact formula
+	const ColorConversion::Type conversionType = RGBLAB::GetConversionType();
+	const ColorConversion::Type types[] = { ColorConversion::FORMULA,
+											ColorConversion::LOOKUP_TABLE,
+											ColorConversion::VECTORIZED };
+
+	const int typesNum = sizeof(types) / sizeof(types[0]);
+	for ( int type = 0; type < typesNum; type++ )
+	{
+		RGBLAB transformer;
+
+		double maxLABError = 0.0;
+		int wrongRGBColors = 0;
+		unsigned char red[RGB_CHANNEL_LEVELS];
+		unsigned char green[RGB_CHANNEL_LEVELS];
+		unsigned char blue[RGB_CHANNEL_LEVELS];
+		unsigned char fastRed[RGB_CHANNEL_LEVELS];
+		unsigned char fastGreen[RGB_CHANNEL_LEVELS];
+		unsigned char fastBlue[RGB_CHANNEL_LEVELS];
+		double chL[RGB_CHANNEL_LEVELS];
+		double chA[RGB_CHANNEL_LEVELS];
+		double chB[RGB_CHANNEL_LEVELS];
+		double fastChL[RGB_CHANNEL_LEVELS];
+		double fastChA[RGB_CHANNEL_LEVELS];
+		double fastChB[RGB_CHANNEL_LEVELS];
+		for ( int r = 0; r < RGB_CHANNEL_LEVELS; r++ )
+		{
+			for ( int g = 0; g < RGB_CHANNEL_LEVELS; g++ )
+			{
+				for ( int b = 0; b < RGB_CHANNEL_LEVELS; b++ )
+				{
+					red[b] = (unsigned char)r;
+					green[b] = (unsigned char)g;
+					blue[b] = (unsigned char)b;
+				}
+
+				s_enabled = false;
+				RGBLAB::SetConversionType(ColorConversion::FORMULA);
+				transformer.RGB2LABRow(red, green, blue, chL, chA, chB, RGB_CHANNEL_LEVELS);
+				s_enabled = true;
+				RGBLAB::SetConversionType(types[type]);
+				transformer.RGB2LABRow(red, green, blue, fastChL, fastChA, fastChB, RGB_CHANNEL_LEVELS);
+
+				for ( int b = 0; b < RGB_CHANNEL_LEVELS; b++ )
+				{
+					maxLABError = qMax( maxLABError, fabs(fastChL[b] - chL[b]) );
+					maxLABError = qMax( maxLABError, fabs(fastChA[b] - chA[b]) );
+					maxLABError = qMax( maxLABError, fabs(fastChB[b] - chB[b]) );
+				}
+
+				s_enabled = false;
+				RGBLAB::SetConversionType(ColorConversion::FORMULA);
+				transformer.LAB2RGBRow(chL, chA, chB, red, green, blue, RGB_CHANNEL_LEVELS);
+				s_enabled = true;
+				RGBLAB::SetConversionType(types[type]);
+				transformer.LAB2RGBRow(chL, chA, chB, fastRed, fastGreen, fastBlue, RGB_CHANNEL_LEVELS);
+
+				for ( int b = 0; b < RGB_CHANNEL_LEVELS; b++ )
+				{
+					if ( (red[b] != fastRed[b]) || (green[b] != fastGreen[b]) || (blue[b] != fastBlue[b]) )
+					{
+						wrongRGBColors++;
+					}
+				}
+			}
+		}
+
+		qDebug() << "TestAccuracy(): conversion type" << types[type] <<
+					"- max error of LAB channels =" << maxLABError <<
+					", RGB colors with other values =" << wrongRGBColors;
+	}
+
+	RGBLAB::SetConversionType(conversionType);
+	s_enabled = wasEnabled;
+}
@@ -0,0 +1,69 @@
+/* === This file is part of GreyToColor ===
+ *
+ *	Copyright 2012-2013, Antony Cherepanov <antony.cherepanov@gmail.com>
+ *
+ *	GreyToColor is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	GreyToColor is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with GreyToColor. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+#include <QtGlobal>
+#include <QDebug>
+#include <math.h>
+#include <string.h>
+
+// Class FastMath
+// Functions for powers, roots and logarithms used in color transform and calculation of pixels statistics.
+// By default functions return the same results as standard functions (pow(), log10()). In fast mode (could be
+// switched on for the whole run) they use multiplications and short series, which are much cheaper:
+// - powers and square root are exact up to last bits of double;
+// - Log10() and Pow10() have relative error less than 1e-9.
+// Call TestAccuracy() (option "--test-fast-math") to get maximum errors of fast mode.
+class FastMath
+{
+	// == DATA ==
+private:
+	// Fast mode is the same for the whole application
+	static bool s_enabled;
+
+	// == METHODS ==
+public:
+	// Switch on or off fast mode
+	static void SetEnabled(const bool &t_enabled);
+	// Check if fast mode is switched on
+	static bool IsEnabled();
+
+	// Calc integer power of value
+	static double Power(const double &t_value, const int &t_power);
+	// Calc square root of value
+	static double SquareRoot(const double &t_value);
+	// Calc log10() of value
+	static double Log10(const double &t_value);
+	// Calc 10^x
+	static double Pow10(const double &t_value);
+
+	// Test functions
+	static void TestAccuracy();
+
+private:
+	// Fast version of Power()
+	static double FastPower(const double &t_value, const int &t_power);
+	// Fast version of Log10()
+	static double FastLog10(const double &t_value);
+	// Fast version of Pow10()
+	static double FastPow10(const double &t_value);
+};
+
+#endif // FASTMATH_H
@@ -32,20 +32,258 @@ Application::~Application()
 // Construct all main objects of application
 // @input:
 // @output:
-void Application::Construct()
+// - true - application started
+// - false - application has nothing to do (command line asked only for tests) and should exit
+bool Application::Construct()
 {
 	CreateUI();
 	CreateImgHandler();
 	CreateIDBHandler();
 	CreateColorMethHandler();
 
+	const bool startApp = ParseArguments();
+
 	ConnectUIandImgHand();
 	ConnectUIandIDBHand();
 	ConnectUIandColMethHand();
 	ConnectImgHandAndIDBHand();
 	ConnectImgHandAndColMethHand();
 
+	if ( false == startApp )
+	{
+		return false;
+	}
+
 	StartApp();
+
+	return true;
+}
+
+// Apply options from command line
+// @input:
+// @output:
+// - true - application should be started
+// - false - tests were run, application should exit
+bool Application::ParseArguments()
+{
+	const QStringList arguments = QCoreApplication::arguments();
+	bool testsDone = false;
+	if ( true == arguments.contains(ARG_TEST_FAST_MATH) )
+	{
+		qDebug() << "ParseArguments(): test accuracy of fast math";
+		FastMath::TestAccuracy();
+		testsDone = true;
+	}
+
+	if ( true == arguments.contains(ARG_TEST_FEATURES) )
+	{
+		qDebug() << "ParseArguments(): test calculation of features of pixels";
+		SourceImgPixels testPixels;
+		testPixels.TestCalcPixelsSKO();
+		testPixels.TestCalcPixelsEntropy();
+		testPixels.TestCalcPixelsSkewAndKurt();
+		testsDone = true;
+	}
+
+	if ( true == arguments.contains(ARG_TEST_INDEXES) )
+	{
+		qDebug() << "ParseArguments(): test search in indexes of pixels";
+		ImgFeaturesIndex testIndex;
+		testIndex.TestFindNeighbors();
+		ImgVPTree testTree;
+		testTree.TestFindNearest();
+		testsDone = true;
+	}
+
+	if ( true == testsDone )
+	{
+		return false;
+	}
+
+	if ( true == arguments.contains(ARG_FAST_MATH) )
+	{
+		qDebug() << "ParseArguments(): fast math mode is on";
+		FastMath::SetEnabled(true);
+	}
+
+	const int conversionArg = arguments.indexOf(ARG_COLOR_CONVERSION);
+	if ( (0 <= conversionArg) && (conversionArg + 1 < arguments.size()) )
+	{
+		const QString conversion = arguments.at(conversionArg + 1);
+		if ( ARG_COLOR_CONVERSION_FORMULA == conversion )
+		{
+			RGBLAB::SetConversionType(ColorConversion::FORMULA);
+		}
+		else if ( ARG_COLOR_CONVERSION_TABLE == conversion )
+		{
+			RGBLAB::SetConversionType(ColorConversion::LOOKUP_TABLE);
+		}
+		else if ( ARG_COLOR_CONVERSION_VECTORIZED == conversion )
+		{
+			RGBLAB::SetConversionType(ColorConversion::VECTORIZED);
+		}
+		else
+		{
+			qDebug() << "ParseArguments(): Error - invalid color conversion" << conversion;
+		}
+	}
+
+	const int threadsArg = arguments.indexOf(ARG_THREADS);
+	if ( (0 <= threadsArg) && (threadsArg + 1 < arguments.size()) )
+	{
+		bool isNumber = false;
+		const int threadsNum = arguments.at(threadsArg + 1).toInt(&isNumber);
+		if ( (true == isNumber) && (0 < threadsNum) )
+		{
+			qDebug() << "ParseArguments(): number of threads =" << threadsNum;
+			SourceImgPixels::SetThreadsNum(threadsNum);
+		}
+		else
+		{
+			qDebug() << "ParseArguments(): Error - invalid number of threads";
+		}
+	}
+
+	ParseMaskArgument(arguments, ARG_SKO_MASK, Feature::SKO);
+	ParseMaskArgument(arguments, ARG_ENTROPY_MASK, Feature::ENTROPY);
+	ParseMaskArgument(arguments, ARG_MOMENTS_MASK, Feature::SKEW_AND_KURT);
+
+	const int matcherArg = arguments.indexOf(ARG_MATCHER);
+	if ( (0 <= matcherArg) && (matcherArg + 1 < arguments.size()) )
+	{
+		const QString matcher = arguments.at(matcherArg + 1);
+		if ( ARG_MATCHER_RANDOM == matcher )
+		{
+			m_colorMethHandler->SlotSetMatcherType(Matcher::RANDOM);
+		}
+		else if ( ARG_MATCHER_INDEXED == matcher )
+		{
+			m_colorMethHandler->SlotSetMatcherType(Matcher::INDEXED);
+		}
+		else if ( ARG_MATCHER_WINDOW == matcher )
+		{
+			m_colorMethHandler->SlotSetMatcherType(Matcher::SORTED_WINDOW);
+		}
+		else
+		{
+			qDebug() << "ParseArguments(): Error - invalid matcher" << matcher;
+		}
+	}
+
+	const int windowArg = arguments.indexOf(ARG_MATCHER_WINDOW_WIDTH);
+	if ( (0 <= windowArg) && (windowArg + 1 < arguments.size()) )
+	{
+		bool isNumber = false;
+		const int windowWidth = arguments.at(windowArg + 1).toInt(&isNumber);
+		if ( (true == isNumber) && (0 < windowWidth) )
+		{
+			qDebug() << "ParseArguments(): width of window of matcher =" << windowWidth;
+			m_colorMethHandler->SlotSetMatcherWindow((unsigned int)windowWidth);
+		}
+		else
+		{
+			qDebug() << "ParseArguments(): Error - invalid width of window of matcher";
+		}
+	}
+
+	const int maxChecksArg = arguments.indexOf(ARG_MATCHER_MAX_CHECKS);
+	if ( (0 <= maxChecksArg) && (maxChecksArg + 1 < arguments.size()) )
+	{
+		bool isNumber = false;
+		const int maxChecks = arguments.at(maxChecksArg + 1).toInt(&isNumber);
+		if ( (true == isNumber) && (0 <= maxChecks) )
+		{
+			qDebug() << "ParseArguments(): max number of checks of matcher =" << maxChecks;
+			m_colorMethHandler->SlotSetMatcherMaxChecks((unsigned int)maxChecks);
+		}
+		else
+		{
+			qDebug() << "ParseArguments(): Error - invalid max number of checks of matcher";
+		}
+	}
+
+	const int entropyMatchingArg = arguments.indexOf(ARG_ENTROPY_MATCHING);
+	if ( (0 <= entropyMatchingArg) && (entropyMatchingArg + 1 < arguments.size()) )
+	{
+		const QString matching = arguments.at(entropyMatchingArg + 1);
+		if ( ARG_ENTROPY_MATCHING_SUM == matching )
+		{
+			m_colorMethHandler->SlotSetEntropyMatching(EntropyMatching::SUM);
+		}
+		else if ( ARG_ENTROPY_MATCHING_CORRELATION == matching )
+		{
+			m_colorMethHandler->SlotSetEntropyMatching(EntropyMatching::CORRELATION);
+		}
+		else if ( ARG_ENTROPY_MATCHING_NEAREST == matching )
+		{
+			m_colorMethHandler->SlotSetEntropyMatching(EntropyMatching::NEAREST);
+		}
+		else
+		{
+			qDebug() << "ParseArguments(): Error - invalid entropy matching" << matching;
+		}
+	}
+
+	const int weightsArg = arguments.indexOf(ARG_ENTROPY_WEIGHTS);
+	if ( (0 <= weightsArg) && (weightsArg + 1 < arguments.size()) )
+	{
+		const QStringList weightsList = arguments.at(weightsArg + 1).split(',');
+		QVector<double> weights;
+		for ( int param = 0; param < weightsList.size(); ++param )
+		{
+			bool isNumber = false;
+			const double weight = weightsList.at(param).toDouble(&isNumber);
+			if ( false == isNumber )
+			{
+				weights.clear();
+				break;
+			}
+
+			weights.append(weight);
+		}
+
+		if ( ENTROPY_PARAMS_NUM == weights.size() )
+		{
+			m_colorMethHandler->SlotSetEntropyWeights(weights);
+		}
+		else
+		{
+			qDebug() << "ParseArguments(): Error - invalid weights of features for entropy matching";
+		}
+	}
+
+	return true;
+}
+
+// Apply option with side of mask of feature of pixels
+// @input:
+// - QStringList - arguments of command line
+// - QString - name of option
+// - Feature::Type - exist feature, which mask is set by option
+// @output:
+void Application::ParseMaskArgument(const QStringList &t_arguments,
+									const QString &t_option,
+									const Feature::Type &t_feature)
+{
+	const int maskArg = t_arguments.indexOf(t_option);
+	if ( (maskArg < 0) || (t_arguments.size() <= maskArg + 1) )
+	{
+		return;
+	}
+
+	bool isNumber = false;
+	const int maskSide = t_arguments.at(maskArg + 1).toInt(&isNumber);
+	if ( (false == isNumber) ||
+		 (0 == maskSide % 2) ||
+		 (maskSide < FEATURE_MASK_MIN_SIDE) ||
+		 (FEATURE_MASK_MAX_SIDE < maskSide) )
+	{
+		qDebug() << "ParseMaskArgument(): Error - invalid side of mask" << t_option;
+		return;
+	}
+
+	qDebug() << "ParseMaskArgument(): side of mask" << t_option << "=" << maskSide;
+	m_colorMethHandler->SlotSetFeatureMaskSide(t_feature, (unsigned int)maskSide);
 }
 
 // Construct all objectf for UI
@@ -118,6 +356,11 @@ void Application::ConnectUIandImgHand()
 					 m_mainUI,
 					 SLOT(SlotGetSourceImg(QString)));
 
+	QObject::connect(m_imgHandler,
+					 SIGNAL(SignalGetSourceImg(QImage)),
+					 m_mainUI,
+					 SLOT(SlotGetSourceModelImg(QImage)));
+
 	QObject::connect(m_imgHandler,
 					 SIGNAL(SignalGetResultImg(QImage)),
 					 m_mainUI,
@@ -128,6 +371,11 @@ void Application::ConnectUIandImgHand()
 					 m_imgHandler,
 					 SLOT(SlotSaveResultImg(const QString &)));
 
+	QObject::connect(m_mainUI,
+					 SIGNAL(SignalSaveSourceModel(const QString &)),
+					 m_imgHandler,
+					 SLOT(SlotSaveSourceModel(const QString &)));
+
 	QObject::connect(m_mainUI,
 					 SIGNAL(SignalFindSimilarImgInIDB()),
 					 m_imgHandler,
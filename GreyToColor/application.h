@@ -21,13 +21,19 @@
 
 #include <QObject>
 #include <QThread>
+#include <QCoreApplication>
+#include <QStringList>
 #include "mainwindow.h"
 #include "imghandler.h"
 #include "idbhandler.h"
 #include "colormethodshandler.h"
+#include "DEFINES/global.h"
 #include "DEFINES/programstatus.h"
 #include "IMAGES/COMMON/image.h"
 #include "DEFINES/colorization.h"
+#include "SERVICE/fastmath.h"
+#include "IMAGES/COMMON/PIXELS/COLOR_SPACE/rgblab.h"
+#include "IMAGES/SOURCE/PIXELS/sourceimgpixels.h"
 
 class Application : public QObject
 {
@@ -52,9 +58,13 @@ public:
 	~Application();
 
 	// Construct all main objects of application
-	void Construct();
+	bool Construct();
 
 private:
+	// Apply options from command line
+	bool ParseArguments();
+	// Apply option with side of mask of feature of pixels
+	void ParseMaskArgument(const QStringList &t_arguments, const QString &t_option, const Feature::Type &t_feature);
 	// Construct all objectf for UI
 	void CreateUI();
 	// Construct all objects for Image Handler
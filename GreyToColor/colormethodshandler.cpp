@@ -38,6 +38,22 @@ void ColorMethodsHandler::Clear()
 	m_sourceImg = NULL;
 	m_methodToUse = Methods::WALSH_SIMPLE;
 	m_lumEqualType = LumEqualization::NO_SCALE;
+	m_matcherType = Matcher::RANDOM;
+	m_matcherWindow = MATCHER_WINDOW_WIDTH;
+	m_matcherMaxChecks = INDEX_SEARCH_MAX_CHECKS;
+	m_featuresCache.Clear();
+	m_sourceIndex.Clear();
+	m_sourceSortedIndex.Clear();
+	m_entropyMatching = EntropyMatching::CORRELATION;
+	m_sourceEntropyTree.Clear();
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		m_entropyWeights[param] = ENTROPY_PARAM_WEIGHT;
+	}
+
+	m_featureMaskSides[Feature::SKO] = SKO_MASK_RECT_SIDE;
+	m_featureMaskSides[Feature::ENTROPY] = ENTROPY_MASK_RECT_SIDE;
+	m_featureMaskSides[Feature::SKEW_AND_KURT] = ENTROPY_MASK_RECT_SIDE;
 }
 
 // Set type of colorization method to use
@@ -70,6 +86,107 @@ void ColorMethodsHandler::SlotSetLumEqualType(const LumEqualization::Type &t_typ
 	m_lumEqualType = t_type;
 }
 
+// Set side of mask of feature of pixels
+// @input:
+// - Feature::Type - exist feature
+// - unsigned int - odd side of mask in range [FEATURE_MASK_MIN_SIDE, FEATURE_MASK_MAX_SIDE]
+// @output:
+void ColorMethodsHandler::SlotSetFeatureMaskSide(const Feature::Type &t_feature, const unsigned int &t_maskRectSide)
+{
+	if ( (t_feature < Feature::SKO) ||
+		 (Feature::DEFAULT_LAST <= t_feature) ||
+		 (0 == t_maskRectSide % 2) ||
+		 (t_maskRectSide < FEATURE_MASK_MIN_SIDE) ||
+		 (FEATURE_MASK_MAX_SIDE < t_maskRectSide) )
+	{
+		qDebug() << "SlotSetFeatureMaskSide(): Error - invalid arguments";
+		return;
+	}
+
+	m_featureMaskSides[t_feature] = t_maskRectSide;
+}
+
+// Set way to find Source pixels similar to Target pixels (used by Walsh Simple and Walsh Neighbor methods)
+// @input:
+// - Matcher::Type - exist type of matcher
+// @output:
+void ColorMethodsHandler::SlotSetMatcherType(const Matcher::Type &t_type)
+{
+	if ( Matcher::DEFAULT_LAST == t_type )
+	{
+		qDebug() << "SlotSetMatcherType(): Error - invalid arguments";
+		return;
+	}
+
+	m_matcherType = t_type;
+}
+
+// Set number of Source pixels checked by matcher with window
+// @input:
+// - unsigned int - positive number of pixels
+// @output:
+void ColorMethodsHandler::SlotSetMatcherWindow(const unsigned int &t_windowWidth)
+{
+	if ( 0 == t_windowWidth )
+	{
+		qDebug() << "SlotSetMatcherWindow(): Error - invalid arguments";
+		return;
+	}
+
+	m_matcherWindow = t_windowWidth;
+}
+
+// Set max number of Source pixels checked by indexed matcher
+// @input:
+// - unsigned int - number of pixels (0 - exact search)
+// @output:
+void ColorMethodsHandler::SlotSetMatcherMaxChecks(const unsigned int &t_maxChecks)
+{
+	m_matcherMaxChecks = t_maxChecks;
+}
+
+// Set way to compare features of pixels in Walsh Simple Entropy method
+// @input:
+// - EntropyMatching::Type - exist way of comparison
+// @output:
+void ColorMethodsHandler::SlotSetEntropyMatching(const EntropyMatching::Type &t_type)
+{
+	if ( EntropyMatching::DEFAULT_LAST == t_type )
+	{
+		qDebug() << "SlotSetEntropyMatching(): Error - invalid arguments";
+		return;
+	}
+
+	m_entropyMatching = t_type;
+}
+
+// Set weights of features of pixels in Walsh Simple Entropy method
+// @input:
+// - QVector<double> - not negative weights of luminance, SKO, entropy, skewness and kurtosis
+// @output:
+void ColorMethodsHandler::SlotSetEntropyWeights(const QVector<double> &t_weights)
+{
+	if ( ENTROPY_PARAMS_NUM != t_weights.size() )
+	{
+		qDebug() << "SlotSetEntropyWeights(): Error - invalid arguments";
+		return;
+	}
+
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		if ( t_weights.at(param) < 0 )
+		{
+			qDebug() << "SlotSetEntropyWeights(): Error - weights should be not negative";
+			return;
+		}
+	}
+
+	for ( int param = 0; param < ENTROPY_PARAMS_NUM; ++param )
+	{
+		m_entropyWeights[param] = t_weights.at(param);
+	}
+}
+
 // Start Colorization
 // @input:
 // @output:
@@ -85,6 +202,21 @@ void ColorMethodsHandler::SlotStartColorization()
 		return;
 	}
 
+	if ( false == SetImgFeatureMasks() )
+	{
+		qDebug() << "SlotStartColorization(): Error - can't set masks of features";
+		emit SignalProcError(tr("Colorization failed"));
+		return;
+	}
+
+	// Source image could be used before with other Target images
+	const QByteArray sourceLumHash = m_sourceImg->GetRelLumHash();
+	int restoredNum = m_featuresCache.RestoreFeatures(m_sourceImg, sourceLumHash);
+	if ( 0 < restoredNum )
+	{
+		qDebug() << "SlotStartColorization(): features of Source image restored from cache:" << restoredNum;
+	}
+
 	switch( m_methodToUse )
 	{
 		case Methods::WALSH_SIMPLE:
@@ -118,6 +250,8 @@ void ColorMethodsHandler::SlotStartColorization()
 			return;
 		}
 	}
+
+	m_featuresCache.SaveFeatures(m_sourceImg, sourceLumHash);
 }
 
 // Get pointer to current target image
@@ -150,6 +284,28 @@ void ColorMethodsHandler::SlotGetSourceImg(SourceImage *t_source)
 	m_sourceImg = t_source;
 }
 
+// Set sides of masks of features to Target and Source images
+// @input:
+// @output:
+// - true - sides of masks are set
+// - false - can't set sides of masks
+bool ColorMethodsHandler::SetImgFeatureMasks()
+{
+	for ( int feature = 0; feature < Feature::DEFAULT_LAST; feature++ )
+	{
+		const Feature::Type type = (Feature::Type)feature;
+		bool targetSet = m_targetImg->SetFeatureMaskSide(type, m_featureMaskSides[feature]);
+		bool sourceSet = m_sourceImg->SetFeatureMaskSide(type, m_featureMaskSides[feature]);
+		if ( (false == targetSet) || (false == sourceSet) )
+		{
+			qDebug() << "SetImgFeatureMasks(): Error - can't set mask of feature" << feature;
+			return false;
+		}
+	}
+
+	return true;
+}
+
 // Start colorization method Walsh Simple
 // @input:
 // @output:
@@ -158,6 +314,9 @@ void ColorMethodsHandler::ColorizeByWalshSimple()
 	emit SignalCurrentProc(Program::COLORIZATION);
 
 	WalshSimpleColorizator colorizator;
+	colorizator.SetMatcher(m_matcherType, &m_sourceIndex, &m_sourceSortedIndex);
+	colorizator.SetMatcherWindow(m_matcherWindow);
+	colorizator.SetMatcherMaxChecks(m_matcherMaxChecks);
 	bool targetColorized = colorizator.Colorize(m_targetImg,
 												m_sourceImg,
 												m_lumEqualType);
@@ -181,6 +340,9 @@ void ColorMethodsHandler::ColorizeByWSLookUp()
 	emit SignalCurrentProc(Program::COLORIZATION);
 
 	WSLookUpTableColorizator colorizator;
+	colorizator.SetMatcher(m_matcherType, &m_sourceIndex, &m_sourceSortedIndex);
+	colorizator.SetMatcherWindow(m_matcherWindow);
+	colorizator.SetMatcherMaxChecks(m_matcherMaxChecks);
 	bool targetColorized = colorizator.Colorize(m_targetImg,
 												m_sourceImg,
 												m_lumEqualType);
@@ -204,6 +366,8 @@ void ColorMethodsHandler::ColorizeByWSEntropy()
 	emit SignalCurrentProc(Program::COLORIZATION);
 
 	WSEntropyColorizator colorizator;
+	colorizator.SetMatching(m_entropyMatching, &m_sourceEntropyTree);
+	colorizator.SetWeights(m_entropyWeights);
 	bool targetColorized = colorizator.Colorize(m_targetImg,
 												m_sourceImg,
 												m_lumEqualType);
@@ -227,6 +391,9 @@ void ColorMethodsHandler::ColorizeByWalshNeighbor()
 	emit SignalCurrentProc(Program::COLORIZATION);
 
 	WalshNeighborColorizator colorizator;
+	colorizator.SetMatcher(m_matcherType, &m_sourceIndex, &m_sourceSortedIndex);
+	colorizator.SetMatcherWindow(m_matcherWindow);
+	colorizator.SetMatcherMaxChecks(m_matcherMaxChecks);
 	bool targetColorized = colorizator.Colorize(m_targetImg,
 												m_sourceImg,
 												m_lumEqualType);
@@ -29,6 +29,10 @@
 #include "METHODS/walshneighborcolorizator.h"
 #include "METHODS/wnnorandcolorizator.h"
 #include "METHODS/wnonerandcolorizator.h"
+#include "./SERVICE/IMAGES/featurescache.h"
+#include "./SERVICE/IMAGES/imgfeaturesindex.h"
+#include "./SERVICE/IMAGES/imglumsortedindex.h"
+#include "./SERVICE/IMAGES/imgvptree.h"
 #include "DEFINES/programstatus.h"
 #include "DEFINES/colorization.h"
 
@@ -42,6 +46,22 @@ private:
 	LumEqualization::Type m_lumEqualType;
 	TargetImage *m_targetImg;
 	SourceImage *m_sourceImg;
+	// Features of Source images calculated at previous colorizations
+	FeaturesCache m_featuresCache;
+	// Sides of masks of features of pixels for colorization
+	unsigned int m_featureMaskSides[Feature::DEFAULT_LAST];
+	// Way to find Source pixels similar to Target pixels
+	Matcher::Type m_matcherType;
+	// Indexes of last Source image (for Matcher::INDEXED and Matcher::SORTED_WINDOW)
+	ImgFeaturesIndex m_sourceIndex;
+	ImgLumSortedIndex m_sourceSortedIndex;
+	unsigned int m_matcherWindow;
+	unsigned int m_matcherMaxChecks;
+	// Way to compare features of pixels in Walsh Simple Entropy method and weights of features
+	EntropyMatching::Type m_entropyMatching;
+	double m_entropyWeights[ENTROPY_PARAMS_NUM];
+	// Index of features of last Source image (for EntropyMatching::NEAREST)
+	ImgVPTree m_sourceEntropyTree;
 
 	// == METHODS ==
 public:
@@ -52,6 +72,8 @@ public:
 	void Clear();
 
 private:
+	// Set sides of masks of features to Target and Source images
+	bool SetImgFeatureMasks();
 	// Start colorization method Walsh Simple
 	void ColorizeByWalshSimple();
 	// Start colorization method Walsh Simple Look Up Table
@@ -77,6 +99,18 @@ public slots:
 	void SlotSetMethodType(const Methods::Type &t_type);
 	// Set type of luminance equalisation to use
 	void SlotSetLumEqualType(const LumEqualization::Type &t_type);
+	// Set side of mask of feature of pixels
+	void SlotSetFeatureMaskSide(const Feature::Type &t_feature, const unsigned int &t_maskRectSide);
+	// Set way to find Source pixels similar to Target pixels
+	void SlotSetMatcherType(const Matcher::Type &t_type);
+	// Set number of Source pixels checked by matcher with window
+	void SlotSetMatcherWindow(const unsigned int &t_windowWidth);
+	// Set max number of Source pixels checked by indexed matcher
+	void SlotSetMatcherMaxChecks(const unsigned int &t_maxChecks);
+	// Set way to compare features of pixels in Walsh Simple Entropy method
+	void SlotSetEntropyMatching(const EntropyMatching::Type &t_type);
+	// Set weights of features of pixels in Walsh Simple Entropy method
+	void SlotSetEntropyWeights(const QVector<double> &t_weights);
 	// Start Colorization
 	void SlotStartColorization();
 	// Get pointer to current target image
@@ -78,6 +78,38 @@ void ImgHandler::SlotSaveResultImg(const QString &t_imgPath)
 	emit SignalProcDone();
 }
 
+// Save Source image as Source model
+// @input:
+// - QString - unempty path to file of model
+// @output:
+void ImgHandler::SlotSaveSourceModel(const QString &t_modelPath)
+{
+	if ( true == t_modelPath.isEmpty() )
+	{
+		qDebug() << "SlotSaveSourceModel(): Error - invalid arguments";
+		return;
+	}
+
+	emit SignalCurrentProc(Program::SAVING);
+
+	if ( false == m_source.HasImage() )
+	{
+		qDebug() << "SlotSaveSourceModel(): Error - no Source Image";
+		emit SignalProcError(tr("Can't save Source model because there is no Source Image"));
+		return;
+	}
+
+	bool modelSaved = m_source.SaveModel(t_modelPath);
+	if ( false == modelSaved )
+	{
+		qDebug() << "SlotSaveSourceModel(): Error - fail to save Source model";
+		emit SignalProcError(tr("Can't save Source model"));
+		return;
+	}
+
+	emit SignalProcDone();
+}
+
 // This slot get path to new original image
 // @input:
 // - QString - unempty path to new original target image
@@ -209,7 +241,18 @@ void ImgHandler::SlotGetNewSourceImg(const QString &t_imgPath)
 
 	emit SignalCurrentProc(Program::LOAD_SOURCE);
 
-	bool sourceLoaded = m_source.LoadImg(t_imgPath);
+	// Source model is a prepared Source image
+	const bool isModel = ( SOURCE_MODEL_SUFFIX == QFileInfo(t_imgPath).suffix() );
+	bool sourceLoaded = false;
+	if ( true == isModel )
+	{
+		sourceLoaded = m_source.LoadModel(t_imgPath);
+	}
+	else
+	{
+		sourceLoaded = m_source.LoadImg(t_imgPath);
+	}
+
 	if ( false == sourceLoaded )
 	{
 		qDebug() << "SlotGetNewSourceImg(): Error - can't load Source Image";
@@ -217,7 +260,15 @@ void ImgHandler::SlotGetNewSourceImg(const QString &t_imgPath)
 		return;
 	}
 
-	emit SignalCurrentSourceImg(t_imgPath);
+	if ( true == isModel )
+	{
+		emit SignalGetSourceImg(m_source.GetImage().GetImg());
+	}
+	else
+	{
+		emit SignalCurrentSourceImg(t_imgPath);
+	}
+
 	emit SignalSourceSet(&m_source);
 
 	emit SignalProcDone();
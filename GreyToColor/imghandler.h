@@ -21,6 +21,7 @@
 
 #include <QObject>
 #include <QDebug>
+#include <QFileInfo>
 #include "./IMAGES/COMMON/image.h"
 #include "./IMAGES/CANDIDATE/candidateimage.h"
 #include "./IMAGES/SOURCE/sourceimage.h"
@@ -59,6 +60,7 @@ private:
 signals:
 	void SignalGetTargetImg(const QString &t_path);
 	void SignalGetResultImg(QImage t_resultImg);
+	void SignalGetSourceImg(QImage t_sourceImg);
 	void SignalFindSimilarInIDB(const Image &t_img);
 	void SignalCurrentSourceImg(const QString &t_name);
 	void SignalGetPassFromIDB();
@@ -81,6 +83,8 @@ public slots:
 	void SlotGetNewTargetImg(const QString &t_imgPath);
 	// This slot get path to new source image
 	void SlotGetNewSourceImg(const QString &t_imgPath);
+	// Save Source image as Source model
+	void SlotSaveSourceModel(const QString &t_modelPath);
 	// Start process of searching image in IDB
 	void SlotFindSimilarForTarget();
 	// Colorization performed. Show result
@@ -24,7 +24,11 @@ int main(int argc, char *argv[])
 	QApplication a(argc, argv);
 
 	Application app;
-	app.Construct();
+	bool appStarted = app.Construct();
+	if ( false == appStarted )
+	{
+		return 0;
+	}
 
 	return a.exec();
 }
@@ -187,7 +187,8 @@ void MainWindow::on_openSourceImgPB_clicked()
 	QString fName = QFileDialog::getOpenFileName(this,
 												 "Open source image...",
 												 QDir::currentPath(),
-												 "IMG files (*.png *.jpg *.jpeg *.bmp *.tiff)");
+												 "IMG files (*.png *.jpg *.jpeg *.bmp *.tiff);;"
+												 "Source models (*." SOURCE_MODEL_SUFFIX ")");
 
 	if(true == fName.isEmpty())
 	{
@@ -229,6 +230,35 @@ void MainWindow::on_actionSaveResult_triggered()
 	emit SignalSaveResultImg(imgName);
 }
 
+// Slot for action actionSaveSourceModel to save prepared Source image
+// @input:
+// @output:
+void MainWindow::on_actionSaveSourceModel_triggered()
+{
+	if ( false == CanOperate() )
+	{
+		return;
+	}
+
+	QString modelName = QFileDialog::getSaveFileName(this,
+													 "Choose name...",
+													 QDir::currentPath(),
+													 "Source models (*." SOURCE_MODEL_SUFFIX ")");
+
+	if ( true == modelName.isEmpty() )
+	{
+		// User change his mind
+		return;
+	}
+
+	if ( SOURCE_MODEL_SUFFIX != QFileInfo(modelName).suffix() )
+	{
+		modelName.append("." SOURCE_MODEL_SUFFIX);
+	}
+
+	emit SignalSaveSourceModel(modelName);
+}
+
 // Slot for getting new Target image
 // @input:
 // - QString - unempty path to new Target image
@@ -269,6 +299,21 @@ void MainWindow::on_findSourceImgPB_clicked()
 	emit SignalFindSimilarImgInIDB();
 }
 
+// Slot for getting image of Source model
+// @input:
+// - QImage - unnull image of loaded Source model
+// @output:
+void MainWindow::SlotGetSourceModelImg(QImage t_sourceImg)
+{
+	if ( true == t_sourceImg.isNull() )
+	{
+		qDebug() << "SlotGetSourceModelImg(): Error - invalid arguments";
+		return;
+	}
+
+	ui->sourceImgLbl->SetImage(t_sourceImg);
+}
+
 // Slot for getting new Result image
 // @input:
 // - QImage - unnull new result image
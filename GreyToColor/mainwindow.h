@@ -22,6 +22,7 @@
 #include <QMainWindow>
 #include <QActionGroup>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QInputDialog>
 #include <QMessageBox>
 #include <QDir>
@@ -93,6 +94,7 @@ signals:
 	void SignalNewTargetImg(const QString &t_str);
 	void SignalNewSourceImg(const QString &t_str);
 	void SignalSaveResultImg(const QString &t_imgPath);
+	void SignalSaveSourceModel(const QString &t_modelPath);
 	void SignalUseImgPassport(const Passport::Type &t_type);
 	void SignalUseColorMethod(const Methods::Type &t_type);
 	void SignalUseLumEqual(const LumEqualization::Type &t_type);
@@ -111,6 +113,8 @@ public slots:
 	void SlotGetTargetImg(const QString &t_targetImgPath);
 	// Slot for getting new Source image
 	void SlotGetSourceImg(const QString &t_sourceImgPath);
+	// Slot for getting image of Source model
+	void SlotGetSourceModelImg(QImage t_sourceImg);
 	// Slot for getting new Result image
 	void SlotGetResultImg(QImage t_resultImg);
 	// Slot to set SKO value
@@ -138,6 +142,7 @@ private slots:
 	void on_openSourceImgPB_clicked();
 	void on_actionOpenSourceImage_triggered();
 	void on_actionSaveResult_triggered();
+	void on_actionSaveSourceModel_triggered();
 	void on_findSourceImgPB_clicked();
 	void on_startColorizationPB_clicked();
 	void on_resetPB_clicked();
@@ -36,6 +36,7 @@ public:
     QAction *actionClose;
     QAction *actionOpenSourceImage;
     QAction *actionSaveResult;
+    QAction *actionSaveSourceModel;
     QAction *actionCreateDatabase;
     QAction *actionAddImages;
     QAction *actionOpenDatabase;
@@ -107,6 +108,8 @@ public:
         actionOpenSourceImage->setObjectName(QString::fromUtf8("actionOpenSourceImage"));
         actionSaveResult = new QAction(MainWindow);
         actionSaveResult->setObjectName(QString::fromUtf8("actionSaveResult"));
+        actionSaveSourceModel = new QAction(MainWindow);
+        actionSaveSourceModel->setObjectName(QString::fromUtf8("actionSaveSourceModel"));
         actionCreateDatabase = new QAction(MainWindow);
         actionCreateDatabase->setObjectName(QString::fromUtf8("actionCreateDatabase"));
         actionAddImages = new QAction(MainWindow);
@@ -364,6 +367,7 @@ public:
         menuFile->addAction(actionOpenSourceImage);
         menuFile->addSeparator();
         menuFile->addAction(actionSaveResult);
+        menuFile->addAction(actionSaveSourceModel);
         menuFile->addSeparator();
         menuFile->addAction(actionPreferences);
         menuFile->addSeparator();
@@ -386,6 +390,7 @@ public:
         actionClose->setText(QApplication::translate("MainWindow", "Close", 0, QApplication::UnicodeUTF8));
         actionOpenSourceImage->setText(QApplication::translate("MainWindow", "Open source image...", 0, QApplication::UnicodeUTF8));
         actionSaveResult->setText(QApplication::translate("MainWindow", "Save result...", 0, QApplication::UnicodeUTF8));
+        actionSaveSourceModel->setText(QApplication::translate("MainWindow", "Save Source model...", 0, QApplication::UnicodeUTF8));
         actionCreateDatabase->setText(QApplication::translate("MainWindow", "Create database...", 0, QApplication::UnicodeUTF8));
         actionAddImages->setText(QApplication::translate("MainWindow", "Add images...", 0, QApplication::UnicodeUTF8));
         actionOpenDatabase->setText(QApplication::translate("MainWindow", "Open database...", 0, QApplication::UnicodeUTF8));